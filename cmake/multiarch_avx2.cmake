@@ -0,0 +1,82 @@
+# We use GCC/Clang's function multi-versioning for AVX2
+# support. This code will automatically dispatch to the
+# AVX2 Harley-Seal popcount algorithm if the CPU supports
+# it and use the default (portable) algorithm otherwise.
+
+include(CheckCXXSourceCompiles)
+include(CMakePushCheckState)
+
+cmake_push_check_state()
+set(CMAKE_REQUIRED_INCLUDES "${PROJECT_SOURCE_DIR}")
+
+check_cxx_source_compiles("
+    // GCC/Clang function multiversioning for AVX2 is not needed
+    // if the user compiles with -mavx2. GCC/Clang function
+    // multiversioning generally causes a minor overhead,
+    // hence we disable it if it is not needed.
+    #if defined(__AVX2__)
+      Error: AVX2 multiarch not needed!
+    #endif
+
+    #include <src/arch/x86/cpuid.cpp>
+    #include <immintrin.h>
+    #include <stdint.h>
+
+    __attribute__ ((target (\"avx2\")))
+    uint64_t popcount_x86_avx2(const uint64_t* array, uint64_t size)
+    {
+        const __m256i lookup = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_mask = _mm256_set1_epi8(0x0f);
+        __m256i total = _mm256_setzero_si256();
+        uint64_t i = 0;
+
+        for (; i + 4 <= size; i += 4)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i*) &array[i]);
+            __m256i lo = _mm256_and_si256(v, low_mask);
+            __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+            __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                          _mm256_shuffle_epi8(lookup, hi));
+            total = _mm256_add_epi64(total, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+        }
+
+        uint64_t cnt = (uint64_t) _mm256_extract_epi64(total, 0);
+        cnt += (uint64_t) _mm256_extract_epi64(total, 1);
+        cnt += (uint64_t) _mm256_extract_epi64(total, 2);
+        cnt += (uint64_t) _mm256_extract_epi64(total, 3);
+
+        for (; i < size; i++)
+            cnt += __builtin_popcountll(array[i]);
+
+        return cnt;
+    }
+
+    uint64_t popcount_default(const uint64_t* array, uint64_t size)
+    {
+        uint64_t cnt = 0;
+        for (uint64_t i = 0; i < size; i++)
+            cnt += __builtin_popcountll(array[i]);
+        return cnt;
+    }
+
+    int main()
+    {
+        uint64_t array[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        uint64_t cnt;
+
+        if (primesieve::has_avx2())
+            cnt = popcount_x86_avx2(&array[0], 10);
+        else
+            cnt = popcount_default(&array[0], 10);
+
+        return (cnt == 15) ? 0 : 1;
+    }
+" multiarch_avx2)
+
+if(multiarch_avx2)
+    list(APPEND PRIMESIEVE_COMPILE_DEFINITIONS "ENABLE_MULTIARCH_AVX2")
+endif()
+
+cmake_pop_check_state()
@@ -0,0 +1,74 @@
+# We use GCC/Clang's function multi-versioning for AVX512
+# VPOPCNTDQ support. This code will automatically dispatch to
+# the AVX512 VPOPCNTDQ popcount algorithm if the CPU supports
+# it and use the default (portable) algorithm otherwise.
+
+include(CheckCXXSourceCompiles)
+include(CMakePushCheckState)
+
+cmake_push_check_state()
+set(CMAKE_REQUIRED_INCLUDES "${PROJECT_SOURCE_DIR}")
+
+check_cxx_source_compiles("
+    // GCC/Clang function multiversioning for AVX512 is not needed if
+    // the user compiles with -mavx512f -mavx512vpopcntdq.
+    // GCC/Clang function multiversioning generally causes a minor
+    // overhead, hence we disable it if it is not needed.
+    #if defined(__AVX512F__) && \
+        defined(__AVX512VPOPCNTDQ__)
+      Error: AVX512 VPOPCNTDQ multiarch not needed!
+    #endif
+
+    #include <src/arch/x86/cpuid.cpp>
+    #include <immintrin.h>
+    #include <stdint.h>
+
+    __attribute__ ((target (\"avx512f,avx512vpopcntdq\")))
+    uint64_t popcount_x86_avx512(const uint64_t* array, uint64_t size)
+    {
+        __m512i cnt = _mm512_setzero_si512();
+        uint64_t i = 0;
+
+        for (; i + 8 <= size; i += 8)
+        {
+            __m512i vec = _mm512_loadu_si512((const __m512i*) &array[i]);
+            cnt = _mm512_add_epi64(cnt, _mm512_popcnt_epi64(vec));
+        }
+
+        if (i < size)
+        {
+            __mmask8 mask = (__mmask8) (0xff >> (i + 8 - size));
+            __m512i vec = _mm512_maskz_loadu_epi64(mask, &array[i]);
+            cnt = _mm512_add_epi64(cnt, _mm512_popcnt_epi64(vec));
+        }
+
+        return (uint64_t) _mm512_reduce_add_epi64(cnt);
+    }
+
+    uint64_t popcount_default(const uint64_t* array, uint64_t size)
+    {
+        uint64_t cnt = 0;
+        for (uint64_t i = 0; i < size; i++)
+            cnt += __builtin_popcountll(array[i]);
+        return cnt;
+    }
+
+    int main()
+    {
+        uint64_t array[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        uint64_t cnt;
+
+        if (primesieve::has_avx512_vpopcnt())
+            cnt = popcount_x86_avx512(&array[0], 10);
+        else
+            cnt = popcount_default(&array[0], 10);
+
+        return (cnt == 15) ? 0 : 1;
+    }
+" multiarch_avx512_vpopcnt)
+
+if(multiarch_avx512_vpopcnt)
+    list(APPEND PRIMESIEVE_COMPILE_DEFINITIONS "ENABLE_MULTIARCH_AVX512_VPOPCNT")
+endif()
+
+cmake_pop_check_state()
@@ -65,8 +65,44 @@ enum {
   UINT64_PRIMES
 };
 
+enum {
+  /** Print primes as decimal text, one prime per line */
+  PRIMESIEVE_TEXT_FORMAT,
+  /** Print primes as 4 byte little-endian integers (stop < 2^32) */
+  PRIMESIEVE_UINT32_FORMAT,
+  /** Print primes as 8 byte little-endian integers */
+  PRIMESIEVE_UINT64_FORMAT,
+  /** Print LEB128 varints of (prime - previous prime) / 2 */
+  PRIMESIEVE_GAPS_FORMAT
+};
+
+enum {
+  /** The callback is called concurrently by multiple threads */
+  PRIMESIEVE_UNORDERED,
+  /** The callback is called by one thread, primes in ascending order */
+  PRIMESIEVE_ORDERED
+};
+
+/** Prime gap statistics, see primesieve_count_gaps() */
+typedef struct
+{
+  /** counts[g] is the number of gaps of size g */
+  uint64_t* counts;
+  /** first[g] is the smaller prime of the first gap of size g, or 0 */
+  uint64_t* first;
+  /** Size of the counts and first arrays (max gap + 1) */
+  size_t size;
+  /** record_primes[i] is the smaller prime of the ith maximal gap */
+  uint64_t* record_primes;
+  /** record_gaps[i] is the ith maximal gap */
+  uint64_t* record_gaps;
+  /** Number of maximal gaps */
+  size_t records;
+} primesieve_gaps;
+
 /**
  * Get an array with the primes inside the interval [start, stop].
+ * Large intervals are processed using all CPU cores.
  * @param size  The size of the returned primes array.
  * @param type  The type of the primes to generate, e.g. INT_PRIMES.
  * 
@@ -82,6 +118,7 @@ void* primesieve_generate_primes(uint64_t start, uint64_t stop, size_t* size, in
 
 /**
  * Get an array with the first n primes >= start.
+ * Large n are processed using all CPU cores.
  * @param type  The type of the primes to generate, e.g. INT_PRIMES.
  * 
  * In case an error occurs the error message is printed to the
@@ -169,42 +206,239 @@ uint64_t primesieve_count_quintuplets(uint64_t start, uint64_t stop);
  */
 uint64_t primesieve_count_sextuplets(uint64_t start, uint64_t stop);
 
+/**
+ * Count the primes inside each of the n intervals
+ * [starts[i], stops[i]] and store the counts in counts[i].
+ * The intervals are sorted and merged and their covering
+ * range is sieved only once using all CPU cores.
+ *
+ * In case an error occurs all counts are set to PRIMESIEVE_ERROR,
+ * the error message is printed to the standard error stream and
+ * the C errno variable is set to EDOM.
+ */
+void primesieve_count_primes_batch(const uint64_t* starts, const uint64_t* stops, size_t n, uint64_t* counts);
+
+/**
+ * Count the primes inside [start, stop] per bucket of width
+ * numbers using a single sieving pass. Returns an array with
+ * the counts of the size buckets, counts[i] is the number of
+ * primes inside [start + i * width, start + (i + 1) * width - 1].
+ * The last bucket ends at stop. The memory must be freed using
+ * primesieve_free() once it is no longer needed. The width must
+ * be > 0 and there must be at most 2^22 buckets.
+ *
+ * In case an error occurs NULL is returned, the error message
+ * is printed to the standard error stream and the C errno
+ * variable is set to EDOM.
+ */
+uint64_t* primesieve_count_primes_histogram(uint64_t start, uint64_t stop, uint64_t width, size_t* size);
+
+/**
+ * Count the twin primes inside [start, stop] per bucket of
+ * width numbers, see primesieve_count_primes_histogram().
+ * A twin prime is only counted if both its primes are
+ * inside the same bucket.
+ */
+uint64_t* primesieve_count_twins_histogram(uint64_t start, uint64_t stop, uint64_t width, size_t* size);
+
+/**
+ * Count the gaps between consecutive primes inside [start, stop]
+ * by gap size and find the first occurrence of each gap size and
+ * the maximal gaps using a single sieving pass. A gap is maximal
+ * if all gaps that precede it inside [start, stop] are smaller.
+ * The arrays of gaps must be freed using primesieve_free_gaps()
+ * once they are no longer needed.
+ *
+ * In case an error occurs all arrays are set to NULL, the error
+ * message is printed to the standard error stream and the C
+ * errno variable is set to EDOM.
+ */
+void primesieve_count_gaps(uint64_t start, uint64_t stop, primesieve_gaps* gaps);
+
+/** Free the arrays of primesieve_count_gaps() */
+void primesieve_free_gaps(primesieve_gaps* gaps);
+
+/**
+ * Count the primes inside [start, stop] in each residue class
+ * modulo q using a single sieving pass. Returns an array of q
+ * counts, counts[r] is the number of primes p inside
+ * [start, stop] with p % q = r. The memory must be freed using
+ * primesieve_free() once it is no longer needed. Each thread
+ * uses q * 8 bytes of memory for its counts, for q > 2^21
+ * fewer threads are used to limit the memory usage to 1 GiB.
+ *
+ * In case an error occurs (e.g. q = 0 or q > 2^24) NULL is
+ * returned, the error message is printed to the standard error
+ * stream and the C errno variable is set to EDOM.
+ */
+uint64_t* primesieve_count_primes_mod(uint64_t start, uint64_t stop, uint64_t q, size_t* size);
+
 /**
  * Print the primes within the interval [start, stop]
- * to the standard output.
+ * to the standard output (in ascending order).
+ * By default all CPU cores are used, use
+ * primesieve_set_num_threads(int threads) to change the
+ * number of threads.
  */
 void primesieve_print_primes(uint64_t start, uint64_t stop);
 
+/**
+ * Print the primes within the interval [start, stop] to the
+ * standard output (in ascending order) using the given format.
+ * The binary formats are much faster than the text format and
+ * use less space, use primesieve_decode_primes() to read them back.
+ * @param format  e.g. PRIMESIEVE_GAPS_FORMAT.
+ */
+void primesieve_print_primes_format(uint64_t start, uint64_t stop, int format);
+
+/**
+ * Get an array with the primes of the data printed by
+ * primesieve_print_primes_format(start, stop, format).
+ * The primes array must be deallocated using primesieve_free().
+ * @param size  The size of the returned primes array.
+ *
+ * In case an error occurs (e.g. the data is not valid for the
+ * given format) the error message is printed to the standard
+ * error stream, the size is set to 0, a NULL pointer is returned
+ * and the C errno variable is set to EDOM.
+ */
+uint64_t* primesieve_decode_primes(const void* data, size_t bytes, int format, size_t* size);
+
+/**
+ * Call callback(prime, ctx) for each prime within the interval
+ * [start, stop]. By default all CPU cores are used and the
+ * callback is called concurrently by multiple threads
+ * (PRIMESIEVE_UNORDERED), hence it must be thread-safe. Use
+ * PRIMESIEVE_ORDERED to process the primes in ascending order.
+ * @param order  PRIMESIEVE_UNORDERED or PRIMESIEVE_ORDERED.
+ * @param ctx    User pointer passed to the callback.
+ *
+ * In case an error occurs the error message is printed to the
+ * standard error stream and the C errno variable is set to EDOM.
+ */
+void primesieve_for_each_prime(uint64_t start, uint64_t stop, int order, void (*callback)(uint64_t prime, void* ctx), void* ctx);
+
+/**
+ * Call callback(primes, size, ctx) for each block of primes
+ * within the interval [start, stop], i.e. once per sieved
+ * segment. This is faster than primesieve_for_each_prime().
+ * The primes of each block are in ascending order, the order of
+ * the blocks is specified using PRIMESIEVE_UNORDERED or
+ * PRIMESIEVE_ORDERED (see primesieve_for_each_prime()).
+ */
+void primesieve_for_each_prime_block(uint64_t start, uint64_t stop, int order, void (*callback)(const uint64_t* primes, size_t size, void* ctx), void* ctx);
+
+/**
+ * Call callback(low, sieve, size, ctx) for each sieved segment
+ * of the interval [start, stop]. The sieve array is passed to the
+ * callback without copying or decoding it, it is only valid during
+ * the callback. size is the number of uint64_t words. Bit i of
+ * byte j of the sieve array (the array's memory) is the number
+ * low + j * 30 + { 7, 11, 13, 17, 19, 23, 29, 31 }[i], a bit is
+ * set if its number is prime. The bits of numbers outside
+ * [start, stop] are 0, the primes 2, 3 and 5 are not part of the
+ * sieve array.
+ * @param order  PRIMESIEVE_ORDERED: the segments are sieved by
+ *               the calling thread in ascending order.
+ *               PRIMESIEVE_UNORDERED: the segments are sieved using
+ *               all CPU cores and the callback is called concurrently.
+ */
+void primesieve_for_each_segment(uint64_t start, uint64_t stop, int order, void (*callback)(uint64_t low, const uint64_t* sieve, size_t size, void* ctx), void* ctx);
+
 /**
  * Print the twin primes within the interval [start, stop]
- * to the standard output.
+ * to the standard output (in ascending order).
+ * By default all CPU cores are used, use
+ * primesieve_set_num_threads(int threads) to change the
+ * number of threads.
  */
 void primesieve_print_twins(uint64_t start, uint64_t stop);
 
 /**
  * Print the prime triplets within the interval [start, stop]
- * to the standard output.
+ * to the standard output (in ascending order).
+ * By default all CPU cores are used, use
+ * primesieve_set_num_threads(int threads) to change the
+ * number of threads.
  */
 void primesieve_print_triplets(uint64_t start, uint64_t stop);
 
 /**
  * Print the prime quadruplets within the interval [start, stop]
- * to the standard output.
+ * to the standard output (in ascending order).
+ * By default all CPU cores are used, use
+ * primesieve_set_num_threads(int threads) to change the
+ * number of threads.
  */
 void primesieve_print_quadruplets(uint64_t start, uint64_t stop);
 
 /**
  * Print the prime quintuplets within the interval [start, stop]
- * to the standard output.
+ * to the standard output (in ascending order).
+ * By default all CPU cores are used, use
+ * primesieve_set_num_threads(int threads) to change the
+ * number of threads.
  */
 void primesieve_print_quintuplets(uint64_t start, uint64_t stop);
 
 /**
  * Print the prime sextuplets within the interval [start, stop]
- * to the standard output.
+ * to the standard output (in ascending order).
+ * By default all CPU cores are used, use
+ * primesieve_set_num_threads(int threads) to change the
+ * number of threads.
  */
 void primesieve_print_sextuplets(uint64_t start, uint64_t stop);
 
+/**
+ * Build a prime count index file that stores pi(x) at the
+ * checkpoints x = k * stride <= stop. The primes between the
+ * checkpoints are counted using all CPU cores.
+ * @param stride  Distance between 2 checkpoints, 0 selects a
+ *                power of 2 in [2^20, 2^32] so that the index
+ *                has about 1024 checkpoints.
+ *
+ * In case an error occurs the error message is printed to the
+ * standard error stream and the C errno variable is set to EDOM.
+ */
+void primesieve_build_count_index(const char* filename, uint64_t stop, uint64_t stride);
+
+/**
+ * Memory map the prime count index file built using
+ * primesieve_build_count_index(). Afterwards primesieve_count_primes()
+ * and primesieve_nth_prime() only sieve the numbers between start,
+ * stop and their nearest checkpoints. NULL unloads the index.
+ *
+ * In case an error occurs (e.g. invalid index file) the error
+ * message is printed to the standard error stream and the C errno
+ * variable is set to EDOM.
+ */
+void primesieve_load_count_index(const char* filename);
+
+/**
+ * Build a prime atlas file: a bitmap of the primes <= stop
+ * (8 bits per 30 numbers, about stop / 30 bytes) with a
+ * rank/select directory. The primes are sieved using all
+ * CPU cores.
+ *
+ * In case an error occurs the error message is printed to the
+ * standard error stream and the C errno variable is set to EDOM.
+ */
+void primesieve_build_prime_atlas(const char* filename, uint64_t stop);
+
+/**
+ * Memory map the prime atlas file built using
+ * primesieve_build_prime_atlas(). Afterwards primesieve_count_primes()
+ * and primesieve_nth_prime() look up the primes <= atlas limit in
+ * the atlas instead of sieving, the primes > atlas limit are still
+ * sieved. NULL unloads the atlas.
+ *
+ * In case an error occurs (e.g. invalid atlas file) the error
+ * message is printed to the standard error stream and the C errno
+ * variable is set to EDOM.
+ */
+void primesieve_load_prime_atlas(const char* filename);
+
 /**
  * Returns the largest valid stop number for primesieve.
  * @return 2^64-1 (UINT64_MAX).
@@ -226,16 +460,16 @@ int primesieve_get_num_threads(void);
 void primesieve_set_sieve_size(int sieve_size);
 
 /**
- * Set the number of threads for use in
- * primesieve_count_*() and primesieve_nth_prime().
- * By default all CPU cores are used.
+ * Set the number of threads for use in primesieve_count_*(),
+ * primesieve_print_*(), primesieve_generate_*() and
+ * primesieve_nth_prime(). By default all CPU cores are used.
  */
 void primesieve_set_num_threads(int num_threads);
 
 /**
  * Deallocate a primes array created using the
- * primesieve_generate_primes() or primesieve_generate_n_primes()
- * functions.
+ * primesieve_generate_primes(), primesieve_generate_n_primes()
+ * or primesieve_decode_primes() functions.
  */
 void primesieve_free(void* primes);
 
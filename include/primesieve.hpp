@@ -22,11 +22,56 @@
 #include <primesieve/StorePrimes.hpp>
 
 #include <stdint.h>
+#include <cstddef>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace primesieve {
 
+/// Output formats supported by print_primes(start, stop, format)
+enum PrintFormat
+{
+  /// One prime per line as decimal text (default)
+  TEXT_FORMAT,
+  /// 4 byte little-endian unsigned integers, requires stop < 2^32
+  UINT32_FORMAT,
+  /// 8 byte little-endian unsigned integers
+  UINT64_FORMAT,
+  /// LEB128 varints of (prime - previous prime) / 2,
+  /// the varint 0 is followed by an absolute prime.
+  GAPS_FORMAT
+};
+
+/// Order in which for_each_prime() passes the primes to the functor
+enum ForEachOrder
+{
+  /// The functor is called concurrently by multiple threads,
+  /// the blocks of primes arrive in arbitrary order.
+  UNORDERED,
+  /// The functor is called by a single thread at a time
+  /// and the primes arrive in ascending order.
+  ORDERED
+};
+
+/// Prime gap statistics of an interval, see count_gaps()
+struct prime_gaps
+{
+  /// counts[g] is the number of gaps of size g
+  std::vector<uint64_t> counts;
+  /// first[g] is the smaller prime of the first
+  /// gap of size g, or 0 if there is no such gap.
+  std::vector<uint64_t> first;
+  /// The maximal gaps in ascending order, each record is a pair
+  /// of (smaller prime, gap). A gap is maximal if all gaps that
+  /// precede it inside the interval are smaller.
+  std::vector<std::pair<uint64_t, uint64_t>> records;
+};
+
 /// Appends the primes <= stop to the end of the primes vector.
+/// Large intervals are processed using all CPU cores.
 /// @vect: std::vector or other vector type that is API compatible
 ///        with std::vector.
 ///
@@ -38,6 +83,7 @@ inline void generate_primes(uint64_t stop, vect* primes)
 }
 
 /// Appends the primes inside [start, stop] to the end of the primes vector.
+/// Large intervals are processed using all CPU cores.
 /// @vect: std::vector or other vector type that is API compatible
 ///        with std::vector.
 ///
@@ -49,6 +95,7 @@ inline void generate_primes(uint64_t start, uint64_t stop, vect* primes)
 }
 
 /// Appends the first n primes to the end of the primes vector.
+/// Large n are processed using all CPU cores.
 /// @vect: std::vector or other vector type that is API compatible
 ///        with std::vector.
 ///
@@ -60,6 +107,7 @@ inline void generate_n_primes(uint64_t n, vect* primes)
 }
 
 /// Appends the first n primes >= start to the end of the primes vector.
+/// Large n are processed using all CPU cores.
 /// @vect: std::vector or other vector type that is API compatible
 ///        with std::vector.
 ///
@@ -136,36 +184,324 @@ uint64_t count_quintuplets(uint64_t start, uint64_t stop);
 ///
 uint64_t count_sextuplets(uint64_t start, uint64_t stop);
 
+/// Count the primes inside each of the n intervals
+/// [starts[i], stops[i]] and store the counts in counts[i].
+/// The intervals are sorted and merged and their covering
+/// range is sieved only once using all CPU cores. This is much
+/// faster than calling count_primes() for each interval if
+/// there are many small intervals (e.g. histogram buckets).
+///
+void count_primes_batch(const uint64_t* starts,
+                        const uint64_t* stops,
+                        std::size_t n,
+                        uint64_t* counts);
+
+/// Count the primes inside each interval [first, second],
+/// see count_primes_batch() above.
+///
+inline std::vector<uint64_t> count_primes_batch(const std::vector<std::pair<uint64_t, uint64_t>>& intervals)
+{
+  std::vector<uint64_t> starts, stops;
+  starts.reserve(intervals.size());
+  stops.reserve(intervals.size());
+
+  for (const auto& interval : intervals)
+  {
+    starts.push_back(interval.first);
+    stops.push_back(interval.second);
+  }
+
+  std::vector<uint64_t> counts(intervals.size());
+  count_primes_batch(starts.data(), stops.data(), intervals.size(), counts.data());
+  return counts;
+}
+
+/// Count the primes inside [start, stop] per bucket of width
+/// numbers using a single sieving pass, counts[i] is the
+/// number of primes inside [start + i * width,
+/// start + (i + 1) * width - 1]. The last bucket ends at stop.
+/// Throws a primesieve_error if width is 0 or if there are
+/// more than 2^22 buckets. By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
+///
+std::vector<uint64_t> count_primes_histogram(uint64_t start, uint64_t stop, uint64_t width);
+
+/// Count the twin primes inside [start, stop] per bucket of
+/// width numbers, see count_primes_histogram() above. A twin
+/// prime is only counted if both its primes are inside the
+/// same bucket, hence counts[i] equals count_twins() of
+/// the ith bucket.
+///
+std::vector<uint64_t> count_twins_histogram(uint64_t start, uint64_t stop, uint64_t width);
+
+/// Count the gaps between consecutive primes inside [start, stop]
+/// by gap size and find the first occurrence of each gap size and
+/// the maximal gaps using a single sieving pass. The gaps are
+/// computed directly in the sieve array, the primes are not
+/// stored. By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
+///
+prime_gaps count_gaps(uint64_t start, uint64_t stop);
+
+/// Count the primes inside [start, stop] in each residue class
+/// modulo q using a single sieving pass, counts[r] is the number
+/// of primes p inside [start, stop] with p % q = r and the
+/// returned vector has q elements. For small moduli
+/// (e.g. q = 4, 10, 12, 30) the primes are counted directly in
+/// the sieve array using popcount(), the primes are not
+/// extracted. Throws a primesieve_error if q = 0 or q > 2^24.
+/// Each thread uses q * 8 bytes of memory for its counts,
+/// for q > 2^21 fewer threads are used to limit the memory
+/// usage to 1 GiB. By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
+///
+std::vector<uint64_t> count_primes_mod(uint64_t start, uint64_t stop, uint64_t q);
+
 /// Print the primes within the interval [start, stop]
-/// to the standard output.
+/// to the standard output (in ascending order).
+/// By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
 ///
 void print_primes(uint64_t start, uint64_t stop);
 
+/// Print the primes within the interval [start, stop] to the
+/// standard output (in ascending order) using the given format.
+/// The binary formats are much faster than the TEXT_FORMAT and
+/// use less space, use decode_primes() to read them back.
+/// By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
+///
+void print_primes(uint64_t start, uint64_t stop, PrintFormat format);
+
+/// Decodes the primes of the data printed by
+/// print_primes(start, stop, format) and appends them to the
+/// primes vector. Throws a primesieve_error if the data is
+/// not valid for the given binary format.
+/// @param insert  Appends count primes to the primes vector.
+///
+void decode_primes(const void* data,
+                   std::size_t bytes,
+                   PrintFormat format,
+                   void* primes,
+                   void (*insert)(void* primes, const uint64_t* first, std::size_t count));
+
+/// Used by decode_primes()
+template <typename T>
+inline void decode_primes_insert(void* primes, const uint64_t* first, std::size_t count)
+{
+  using V = typename T::value_type;
+  T& vect = *(T*) primes;
+
+  if (first[count - 1] > std::numeric_limits<V>::max())
+    throw primesieve_error("decode_primes(): " + getTypeName<V>() + " is too narrow for prime " + std::to_string(first[count - 1]));
+
+  vect.insert(vect.end(), first, first + count);
+}
+
+/// Decodes the primes of the data printed by
+/// print_primes(start, stop, format) and appends them to the
+/// end of the primes vector. Throws a primesieve_error if the
+/// data is not valid for the given binary format.
+/// @vect: std::vector or other vector type that is API compatible
+///        with std::vector.
+///
+template <typename vect>
+inline void decode_primes(const void* data,
+                          std::size_t bytes,
+                          PrintFormat format,
+                          vect* primes)
+{
+  if (primes)
+    decode_primes(data, bytes, format, primes, decode_primes_insert<vect>);
+}
+
+/// Calls callback(ctx, primes, size) for each block of primes
+/// within the interval [start, stop]. The primes of each block
+/// are in ascending order. The blocks are generated using
+/// multi-threading, see ForEachOrder.
+///
+void for_each_prime_block(uint64_t start,
+                          uint64_t stop,
+                          ForEachOrder order,
+                          void* ctx,
+                          void (*callback)(void* ctx, const uint64_t* primes, std::size_t size));
+
+/// Used by for_each_prime_block(start, stop, f, order)
+template <typename F>
+inline void for_each_prime_block_call(void* ctx, const uint64_t* primes, std::size_t size)
+{
+  F& f = *(F*) ctx;
+  f(primes, size);
+}
+
+/// Used by for_each_prime(start, stop, f, order)
+template <typename F>
+inline void for_each_prime_call(void* ctx, const uint64_t* primes, std::size_t size)
+{
+  F& f = *(F*) ctx;
+  for (std::size_t i = 0; i < size; i++)
+    f(primes[i]);
+}
+
+/// Calls f(primes, size) for each block of primes within the
+/// interval [start, stop], i.e. once per sieved segment. This
+/// is the fastest way to process all primes without storing
+/// them in a vector. By default all CPU cores are used and f is
+/// called concurrently by multiple threads (UNORDERED), hence f
+/// must be thread-safe. Use ORDERED to process the primes in
+/// ascending order. Exceptions thrown by f are propagated to
+/// the caller.
+///
+template <typename F>
+inline void for_each_prime_block(uint64_t start,
+                                 uint64_t stop,
+                                 F&& f,
+                                 ForEachOrder order = UNORDERED)
+{
+  using T = typename std::remove_reference<F>::type;
+  for_each_prime_block(start, stop, order, (void*) &f, for_each_prime_block_call<T>);
+}
+
+/// Calls f(prime) for each prime within the interval
+/// [start, stop]. By default all CPU cores are used and f is
+/// called concurrently by multiple threads (UNORDERED), hence f
+/// must be thread-safe. Use ORDERED to process the primes in
+/// ascending order. Exceptions thrown by f are propagated to
+/// the caller.
+///
+template <typename F>
+inline void for_each_prime(uint64_t start,
+                           uint64_t stop,
+                           F&& f,
+                           ForEachOrder order = UNORDERED)
+{
+  using T = typename std::remove_reference<F>::type;
+  for_each_prime_block(start, stop, order, (void*) &f, for_each_prime_call<T>);
+}
+
+/// Calls callback(ctx, low, sieve, size) for each sieved segment
+/// of the interval [start, stop]. The sieve array of the segment
+/// is passed to the callback without copying or decoding it, it
+/// is only valid during the callback. The sieve array uses 1 bit
+/// per number coprime to 30 (8 bits per 30 numbers) and a bit is
+/// set if its number is prime:
+///
+/// Bit i of byte j of the sieve array (the array's memory) is the
+/// number low + j * 30 + { 7, 11, 13, 17, 19, 23, 29, 31 }[i].
+/// On little-endian CPUs bit b of sieve[w] is the number
+/// low + w * 240 + (b / 8) * 30 + { 7, 11, 13, ... }[b % 8].
+///
+/// The bits of numbers outside [start, stop] are 0. The primes
+/// 2, 3 and 5 are not part of the sieve array. With ORDERED the
+/// segments are sieved by the calling thread in ascending order.
+/// With UNORDERED (default) the segments are sieved using all
+/// CPU cores and the callback is called concurrently by the
+/// threads, the segments of different threads may overlap by a
+/// few bytes but never share a set bit.
+///
+void for_each_segment(uint64_t start,
+                      uint64_t stop,
+                      ForEachOrder order,
+                      void* ctx,
+                      void (*callback)(void* ctx, uint64_t low, const uint64_t* sieve, std::size_t size));
+
+/// Used by for_each_segment(start, stop, f, order)
+template <typename F>
+inline void for_each_segment_call(void* ctx, uint64_t low, const uint64_t* sieve, std::size_t size)
+{
+  F& f = *(F*) ctx;
+  f(low, sieve, size);
+}
+
+/// Calls f(low, sieve, size) for each sieved segment of the
+/// interval [start, stop], see for_each_segment() above.
+///
+template <typename F>
+inline void for_each_segment(uint64_t start,
+                             uint64_t stop,
+                             F&& f,
+                             ForEachOrder order = UNORDERED)
+{
+  using T = typename std::remove_reference<F>::type;
+  for_each_segment(start, stop, order, (void*) &f, for_each_segment_call<T>);
+}
+
 /// Print the twin primes within the interval [start, stop]
-/// to the standard output.
+/// to the standard output (in ascending order).
+/// By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
 ///
 void print_twins(uint64_t start, uint64_t stop);
 
 /// Print the prime triplets within the interval [start, stop]
-/// to the standard output.
+/// to the standard output (in ascending order).
+/// By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
 ///
 void print_triplets(uint64_t start, uint64_t stop);
 
 /// Print the prime quadruplets within the interval [start, stop]
-/// to the standard output.
+/// to the standard output (in ascending order).
+/// By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
 ///
 void print_quadruplets(uint64_t start, uint64_t stop);
 
 /// Print the prime quintuplets within the interval [start, stop]
-/// to the standard output.
+/// to the standard output (in ascending order).
+/// By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
 ///
 void print_quintuplets(uint64_t start, uint64_t stop);
 
 /// Print the prime sextuplets within the interval [start, stop]
-/// to the standard output.
+/// to the standard output (in ascending order).
+/// By default all CPU cores are used, use
+/// primesieve::set_num_threads(int threads) to change the
+/// number of threads.
 ///
 void print_sextuplets(uint64_t start, uint64_t stop);
 
+/// Build a prime count index file that stores pi(x) at the
+/// checkpoints x = k * stride <= stop. The primes between the
+/// checkpoints are counted using all CPU cores.
+/// @param stride  Distance between 2 checkpoints, 0 selects
+///                a power of 2 in [2^20, 2^32] so that the index
+///                has about 1024 checkpoints.
+///
+void build_count_index(const std::string& filename, uint64_t stop, uint64_t stride = 0);
+
+/// Memory map the prime count index file built using
+/// build_count_index(). Afterwards count_primes() and
+/// nth_prime() only sieve the numbers between start, stop and
+/// their nearest checkpoints. An empty filename unloads the index.
+///
+void load_count_index(const std::string& filename);
+
+/// Build a prime atlas file: a bitmap of the primes <= stop
+/// (8 bits per 30 numbers, about stop / 30 bytes) with a
+/// rank/select directory. The primes are sieved using all
+/// CPU cores.
+///
+void build_prime_atlas(const std::string& filename, uint64_t stop);
+
+/// Memory map the prime atlas file built using build_prime_atlas().
+/// Afterwards count_primes() and nth_prime() look up the primes
+/// <= atlas limit in the atlas instead of sieving, the primes
+/// > atlas limit are still sieved. nth_prime(1, n) finds the next
+/// prime > n. An empty filename unloads the atlas.
+///
+void load_prime_atlas(const std::string& filename);
+
 /// Returns the largest valid stop number for primesieve.
 /// @return 2^64-1 (UINT64_MAX).
 ///
@@ -184,9 +520,9 @@ int get_num_threads();
 ///
 void set_sieve_size(int sieve_size);
 
-/// Set the number of threads for use in
-/// primesieve::count_*() and primesieve::nth_prime().
-/// By default all CPU cores are used.
+/// Set the number of threads for use in primesieve::count_*(),
+/// primesieve::print_*(), primesieve::generate_*() and
+/// primesieve::nth_prime(). By default all CPU cores are used.
 ///
 void set_num_threads(int num_threads);
 
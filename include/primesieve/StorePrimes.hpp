@@ -2,7 +2,7 @@
 /// @file   StorePrimes.hpp
 /// @brief  Store primes in a vector.
 ///
-/// Copyright (C) 2022 Kim Walisch, <kim.walisch@gmail.com>
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
 ///
 /// This file is distributed under the BSD License. See the COPYING
 /// file in the top level directory.
@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <limits>
 #include <string>
+#include <type_traits>
 
 #if defined(min) || defined(max)
   #undef min
@@ -59,6 +60,96 @@ template <> inline std::string getTypeName<uint32_t>() { return "uint32_t"; }
 template <> inline std::string getTypeName<int64_t>() { return "int64_t"; }
 template <> inline std::string getTypeName<uint64_t>() { return "uint64_t"; }
 
+/// Store the primes inside [start, stop] into the primes vector
+/// using multi-threading. First the primes inside each chunk of
+/// [start, stop] are counted in parallel and the memory for all
+/// primes is reserved using reserve(primes, count). Then the
+/// calling thread appends the chunks in ascending order using
+/// append(primes, count) while the other threads store the
+/// primes of the chunks that have already been appended at their
+/// precomputed offsets. Hence std::vector's zero fill of the new
+/// elements is not done serially before storing the primes.
+/// Returns false (and does nothing) if the distance is too small
+/// for multi-threading.
+/// @prime_bytes: sizeof(primes[0]), must be 2, 4 or 8.
+/// @reserve: Reserves memory for count more elements, the
+///           primes vector must not be reallocated by the
+///           subsequent append() calls.
+/// @append: Appends count elements to the primes vector and
+///          returns a pointer to the first new element.
+///
+bool store_primes_parallel(uint64_t start,
+                           uint64_t stop,
+                           std::size_t prime_bytes,
+                           void* primes,
+                           void (*reserve)(void* primes, std::size_t count),
+                           void* (*append)(void* primes, std::size_t count));
+
+/// Store at most n primes inside [start, stop] using 32-bit
+/// primes. The primes are generated directly as uint32_t
+/// which halves the memory traffic compared to generating
+/// 64-bit primes and narrowing each prime.
+/// Returns the number of primes stored.
+/// @pre stop < 2^32
+/// @insert: Appends count primes to the primes vector.
+///
+uint64_t store_primes32(uint64_t start,
+                        uint64_t stop,
+                        uint64_t n,
+                        void* primes,
+                        void (*insert)(void* primes, const uint32_t* first, std::size_t count));
+
+/// Returns the nth prime >= start if the first n primes >= start
+/// should be stored using multi-threading, else returns 0.
+///
+uint64_t store_n_primes_stop(uint64_t n, uint64_t start);
+
+/// Used by store_primes_parallel()
+template <typename T>
+inline void store_primes_reserve(void* primes, std::size_t count)
+{
+  T& vect = *(T*) primes;
+  vect.reserve(vect.size() + count);
+}
+
+/// Used by store_primes_parallel()
+template <typename T>
+inline void* store_primes_append(void* primes, std::size_t count)
+{
+  T& vect = *(T*) primes;
+  std::size_t size = vect.size();
+  vect.resize(size + count);
+  return (void*) &vect[size];
+}
+
+/// Used by store_primes32()
+template <typename T>
+inline void store_primes_insert32(void* primes, const uint32_t* first, std::size_t count)
+{
+  T& vect = *(T*) primes;
+  vect.insert(vect.end(), first, first + count);
+}
+
+/// Returns true if libprimesieve can store primes
+/// of type V using 32-bit primes.
+///
+template <typename V>
+inline bool is_store_primes32()
+{
+  return std::is_integral<V>::value &&
+         sizeof(V) == 4;
+}
+
+/// Returns true if libprimesieve can store primes
+/// of type V using multi-threading.
+///
+template <typename V>
+inline bool is_store_primes_parallel()
+{
+  return std::is_integral<V>::value &&
+         (sizeof(V) == 2 || sizeof(V) == 4 || sizeof(V) == 8);
+}
+
 template <typename T>
 inline void store_primes(uint64_t start,
                          uint64_t stop,
@@ -83,21 +174,33 @@ inline void store_primes(uint64_t start,
   if (stop > std::numeric_limits<V>::max())
     throw primesieve_error("store_primes(): " + getTypeName<V>() + " is too narrow for generating primes up to " + std::to_string(stop));
 
+  if (is_store_primes_parallel<V>() &&
+      store_primes_parallel(start, stop, sizeof(V), &primes, store_primes_reserve<T>, store_primes_append<T>))
+    return;
+
   std::size_t size = primes.size() + prime_count_upper(start, stop);
   primes.reserve(size);
 
+  // stop <= std::numeric_limits<V>::max() < 2^32
+  if (is_store_primes32<V>())
+  {
+    store_primes32(start, stop, std::numeric_limits<uint64_t>::max(), &primes, store_primes_insert32<T>);
+    return;
+  }
+
   primesieve::iterator it(start, stop);
-  it.generate_next_primes();
+  std::size_t blockSize;
+  const uint64_t* block = it.next_primes_block(&blockSize);
 
   // primesieve::iterator throws an exception if one tries to
   // generate primes > 2^64. Hence we must avoid calling
-  // generate_next_primes() after the largest 64-bit prime.
+  // next_primes_block() after the largest 64-bit prime.
   uint64_t limit = std::min(stop, maxPrime64bits - 1);
 
-  for (; it.primes_[it.size_ - 1] <= limit; it.generate_next_primes())
-    primes.insert(primes.end(), it.primes_, it.primes_ + it.size_);
-  for (std::size_t i = 0; it.primes_[i] <= limit; i++)
-    primes.push_back((V) it.primes_[i]);
+  for (; block[blockSize - 1] <= limit; block = it.next_primes_block(&blockSize))
+    primes.insert(primes.end(), block, block + blockSize);
+  for (std::size_t i = 0; block[i] <= limit; i++)
+    primes.push_back((V) block[i]);
 
   if (stop >= maxPrime64bits)
     primes.push_back((V) maxPrime64bits);
@@ -124,6 +227,21 @@ inline void store_n_primes(uint64_t n,
     return;
 
   using V = typename T::value_type;
+
+  if (is_store_primes_parallel<V>())
+  {
+    uint64_t nthPrime = store_n_primes_stop(n, start);
+
+    if (nthPrime)
+    {
+      if (nthPrime > std::numeric_limits<V>::max())
+        throw primesieve_error("store_n_primes(): " + getTypeName<V>() + " is too narrow for generating primes up to " + std::to_string(nthPrime));
+
+      store_primes(start, nthPrime, primes);
+      return;
+    }
+  }
+
   std::size_t size = primes.size() + (std::size_t) n;
   primes.reserve(size);
 
@@ -135,27 +253,44 @@ inline void store_n_primes(uint64_t n,
   uint64_t nthPrime = (uint64_t)(n * (logn + loglogn));
   uint64_t stop = start + nthPrime;
 
+  if (is_store_primes32<V>())
+  {
+    // stop is only an estimate of the nth prime, if it
+    // is too small we continue up to the largest V.
+    uint64_t maxV = std::numeric_limits<V>::max();
+    uint64_t stop32 = std::min(stop, maxV);
+    uint64_t count = store_primes32(start, stop32, n, &primes, store_primes_insert32<T>);
+
+    if (count < n && stop32 < maxV)
+      count += store_primes32(stop32 + 1, maxV, n - count, &primes, store_primes_insert32<T>);
+    if (count < n)
+      throw primesieve_error("store_n_primes(): " + getTypeName<V>() + " is too narrow for generating primes up to " + std::to_string(stop));
+
+    return;
+  }
+
   primesieve::iterator it(start, stop);
-  it.generate_next_primes();
+  std::size_t blockSize;
+  const uint64_t* block = it.next_primes_block(&blockSize);
 
-  while (n >= it.size_)
+  while (n >= blockSize)
   {
-    if (it.primes_[it.size_ - 1] > std::numeric_limits<V>::max())
+    if (block[blockSize - 1] > std::numeric_limits<V>::max())
       throw primesieve_error("store_n_primes(): " + getTypeName<V>() + " is too narrow for generating primes up to " + std::to_string(stop));
 
-    primes.insert(primes.end(), it.primes_, it.primes_ + it.size_);
-    n -= it.size_;
+    primes.insert(primes.end(), block, block + blockSize);
+    n -= blockSize;
     if (n == 0)
       return;
 
-    it.generate_next_primes();
+    block = it.next_primes_block(&blockSize);
   }
 
-  if (it.primes_[n - 1] > std::numeric_limits<V>::max())
+  if (block[n - 1] > std::numeric_limits<V>::max())
     throw primesieve_error("store_n_primes(): " + getTypeName<V>() + " is too narrow for generating primes up to " + std::to_string(stop));
 
   for (std::size_t i = 0; i < (std::size_t) n; i++)
-    primes.push_back((V) it.primes_[i]);
+    primes.push_back((V) block[i]);
 
 #if defined(_MSC_VER)
   #pragma warning(pop)
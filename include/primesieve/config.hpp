@@ -60,6 +60,29 @@ constexpr uint64_t MAX_CACHE_ITERATOR = 1 << 30;
 ///
 constexpr uint64_t MIN_THREAD_DISTANCE = (uint64_t) 1e7;
 
+/// When printing primes using multi-threading each thread
+/// converts the primes of its chunk to text and stores them in a
+/// buffer of about PRINT_BUFFER_BYTES. The buffers are printed to
+/// stdout in order. At most 2 buffers per thread are in flight.
+/// for_each_prime(start, stop, f, ORDERED) uses buffers of the
+/// same size for the primes of each chunk.
+///
+constexpr uint64_t PRINT_BUFFER_BYTES = 8 << 20;
+
+/// Maximum number of buckets of count_primes_histogram().
+/// Each bucket uses 56 bytes of memory (counts and result),
+/// a larger number of buckets requires a larger bucket width.
+///
+constexpr uint64_t MAX_HISTOGRAM_BUCKETS = 1 << 22;
+
+/// If sqrt(stop) >= MIN_SHARED_SIEVING_PRIMES, ParallelSieve
+/// generates the sieving primes <= sqrt(stop) only once (in
+/// parallel) and all threads read them from a shared array.
+/// For smaller stop numbers generating the sieving primes
+/// for each chunk is cheap.
+///
+constexpr uint64_t MIN_SHARED_SIEVING_PRIMES = 1 << 20;
+
 /// Maximum CPU cache line size in bytes (of all CPU types that
 /// will be produced over the next few decades).
 /// In order to prevent false sharing when using a mutex (or atomic
@@ -0,0 +1,27 @@
+///
+/// @file  cpu_supports_avx512_vpopcnt.hpp
+/// @brief Detect if the x86 CPU supports AVX512 VPOPCNTDQ.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef CPU_SUPPORTS_AVX512_VPOPCNT_HPP
+#define CPU_SUPPORTS_AVX512_VPOPCNT_HPP
+
+namespace primesieve {
+
+bool has_avx512_vpopcnt();
+
+} // namespace
+
+namespace {
+
+/// Initialized at startup
+const bool cpu_supports_avx512_vpopcnt = primesieve::has_avx512_vpopcnt();
+
+} // namespace
+
+#endif
@@ -23,6 +23,7 @@ int get_num_threads();
 int get_sieve_size();
 
 uint64_t get_max_stop();
+uint64_t popcount(const uint64_t* array, uint64_t size);
 uint64_t popcount(const Vector<uint64_t>& vect);
 
 } // namespace
@@ -120,6 +120,30 @@ void primesieve_jump_to(primesieve_iterator* it, uint64_t start, uint64_t stop_h
 #endif
 void primesieve_skipto(primesieve_iterator* it, uint64_t start, uint64_t stop_hint);
 
+/**
+ * Generate the next primes in a helper thread while the current
+ * primes are being processed. This is beneficial if you do a
+ * significant amount of work per prime, otherwise it may run
+ * slower. primesieve_next_prime() is not affected as the primes
+ * arrays are only swapped in primesieve_generate_next_primes().
+ * primesieve_prev_prime() does not use prefetching.
+ * @param enable  1 to enable prefetching, 0 to disable
+ *                prefetching (default).
+ */
+void primesieve_enable_prefetch(primesieve_iterator* it, int enable);
+
+/**
+ * Set the maximum number of primes returned by
+ * primesieve_next_primes_block() and
+ * primesieve_generate_next_primes(). The default block size
+ * is 2^10 primes, the block size is clamped to [2^7, 2^27].
+ * Note that the returned blocks may be smaller, especially at
+ * the start of the iteration if no stop_hint is used. Should
+ * be called before iterating, otherwise the new block size is
+ * used once the iterator sieves the next interval.
+ */
+void primesieve_set_block_size(primesieve_iterator* it, size_t block_size);
+
 /**
  * Used internally by primesieve_next_prime().
  * primesieve_generate_next_primes() fills (overwrites) the primes
@@ -160,6 +184,30 @@ static inline uint64_t primesieve_next_prime(primesieve_iterator* it)
   return it->primes[it->i];
 }
 
+/**
+ * Get the next block of primes i.e. the remaining primes of the
+ * primes array or a new array of primes if all primes of the
+ * current primes array have been used. Afterwards
+ * primesieve_next_prime() returns the first prime after the
+ * block. The block stays valid until the next call to any
+ * primesieve_iterator function.
+ * @param size  The number of primes in the block (> 0).
+ * @return      Pointer to the first prime of the block.
+ *              If any error occurs the block contains
+ *              PRIMESIEVE_ERROR.
+ */
+static inline const uint64_t* primesieve_next_primes_block(primesieve_iterator* it, size_t* size)
+{
+  const uint64_t* block;
+  it->i += 1;
+  IF_UNLIKELY_PRIMESIEVE(it->i >= it->size)
+    primesieve_generate_next_primes(it);
+  block = &it->primes[it->i];
+  *size = it->size - it->i;
+  it->i = it->size - 1;
+  return block;
+}
+
 /**
  * Get the previous prime.
  * primesieve_prev_prime(n) returns 0 for n <= 2.
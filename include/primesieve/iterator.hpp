@@ -93,6 +93,28 @@ struct iterator
   ///
   void clear() noexcept;
 
+  /// Generate the next primes in a helper thread while the
+  /// current primes are being processed. This is beneficial if
+  /// you do a significant amount of work per prime, otherwise
+  /// it may run slower. next_prime() is not affected as the
+  /// primes arrays are only swapped in generate_next_primes().
+  /// prev_prime() does not use prefetching, calling prev_prime()
+  /// stops the helper thread (until the next call to
+  /// generate_next_primes()). Prefetching is disabled by default.
+  ///
+  void enable_prefetch(bool enable = true);
+
+  /// Set the maximum number of primes returned by
+  /// next_primes_block() and generate_next_primes().
+  /// The default block size is 2^10 primes, the block size
+  /// is clamped to [2^7, 2^27]. Note that the returned blocks
+  /// may be smaller, especially at the start of the iteration
+  /// if no stop_hint is used. Should be called before
+  /// iterating, otherwise the new block size is used once the
+  /// iterator sieves the next interval.
+  ///
+  void set_block_size(std::size_t block_size);
+
   /// Used internally by next_prime().
   /// generate_next_primes() fills (overwrites) the primes array with
   /// the next few primes (~ 2^10) that are larger than the current
@@ -127,6 +149,25 @@ struct iterator
     return primes_[i_];
   }
 
+  /// Get the next block of primes i.e. the remaining primes of the
+  /// primes array or a new array of primes if all primes of the
+  /// current primes array have been used. Afterwards next_prime()
+  /// returns the first prime after the block. The block stays
+  /// valid until the next call to any non-const method.
+  /// @param size  The number of primes in the block (> 0).
+  /// @return      Pointer to the first prime of the block.
+  ///
+  const uint64_t* next_primes_block(std::size_t* size)
+  {
+    i_ += 1;
+    IF_UNLIKELY_PRIMESIEVE(i_ >= size_)
+      generate_next_primes();
+    const uint64_t* block = &primes_[i_];
+    *size = size_ - i_;
+    i_ = size_ - 1;
+    return block;
+  }
+
   /// Get the previous prime.
   /// prev_prime(n) returns 0 for n <= 2.
   /// Note that next_prime() runs up to 2x faster than prev_prime().
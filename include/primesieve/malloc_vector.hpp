@@ -116,6 +116,14 @@ public:
       reserve_unchecked(n);
   }
 
+  /// Resize the vector without initializing
+  /// the new elements (like primesieve::Vector).
+  void resize(std::size_t n)
+  {
+    reserve(n);
+    end_ = array_ + n;
+  }
+
 private:
   T* array_ = nullptr;
   T* end_ = nullptr;
@@ -0,0 +1,176 @@
+///
+/// @file   ChunkScheduler.cpp
+/// @brief  Work-stealing scheduler with guided chunk sizes used
+///         by ParallelSieve for counting primes. With a fixed
+///         chunk size the threads may finish far apart on hybrid
+///         CPUs (with fast and slow cores), on busy machines and
+///         near 2^64 where the cost per chunk varies a lot.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "ChunkScheduler.hpp"
+
+#include <primesieve/macros.hpp>
+#include <primesieve/pmath.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace primesieve {
+
+ChunkScheduler::ChunkScheduler(uint64_t start,
+                               uint64_t stop,
+                               int threads,
+                               uint64_t minChunk,
+                               uint64_t maxChunk) :
+  ranges_(new Range[threads]),
+  remaining_(stop - start),
+  minChunk_(minChunk),
+  maxChunk_(std::max(minChunk, maxChunk)),
+  threads_(threads)
+{
+  ASSERT(threads > 0);
+  ASSERT(start <= stop);
+  uint64_t dist = (stop - start) / threads;
+
+  for (int t = 0; t < threads; t++)
+  {
+    ranges_[t].low = start + dist * t;
+    ranges_[t].high = start + dist * (t + 1);
+  }
+
+  ranges_[threads - 1].high = stop;
+}
+
+/// Set the NUMA node of the thread,
+/// must be called before next().
+///
+void ChunkScheduler::setNode(int thread, std::size_t node)
+{
+  ASSERT(thread >= 0 && thread < threads_);
+  std::lock_guard<std::mutex> lock(ranges_[thread].mutex);
+  ranges_[thread].node = node;
+}
+
+/// Get the next chunk [low, high] of the thread. Returns
+/// false once all ranges have been processed.
+///
+bool ChunkScheduler::next(int thread,
+                          uint64_t* low,
+                          uint64_t* high)
+{
+  ASSERT(thread >= 0 && thread < threads_);
+  Range& range = ranges_[thread];
+
+  do
+  {
+    std::lock_guard<std::mutex> lock(range.mutex);
+    uint64_t dist = range.high - range.low;
+
+    if (dist > 0)
+    {
+      uint64_t chunk = remaining_.load(std::memory_order_relaxed);
+      chunk /= (uint64_t) threads_ * 2;
+      chunk = inBetween(minChunk_, chunk, maxChunk_);
+
+      // Avoid leaving behind a tiny chunk
+      if (chunk >= dist || dist - chunk < minChunk_)
+        chunk = dist;
+
+      *low = range.low;
+      *high = range.low + chunk;
+      range.low = *high;
+      remaining_.fetch_sub(chunk, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  while (steal(thread));
+
+  return false;
+}
+
+/// Move the upper half of the largest remaining range
+/// into the thread's own (empty) range. Ranges of threads
+/// on the same NUMA node are preferred. Returns false
+/// if there is nothing left to steal.
+///
+bool ChunkScheduler::steal(int thread)
+{
+  std::size_t node;
+
+  {
+    std::lock_guard<std::mutex> lock(ranges_[thread].mutex);
+    node = ranges_[thread].node;
+  }
+
+  while (true)
+  {
+    int victim = -1;
+    int localVictim = -1;
+    uint64_t maxDist = 0;
+    uint64_t maxLocalDist = 0;
+
+    for (int i = 1; i < threads_; i++)
+    {
+      int t = (thread + i) % threads_;
+      std::lock_guard<std::mutex> lock(ranges_[t].mutex);
+      uint64_t dist = ranges_[t].high - ranges_[t].low;
+
+      if (dist > maxDist)
+      {
+        maxDist = dist;
+        victim = t;
+      }
+
+      if (dist > maxLocalDist &&
+          ranges_[t].node == node)
+      {
+        maxLocalDist = dist;
+        localVictim = t;
+      }
+    }
+
+    if (localVictim >= 0)
+      victim = localVictim;
+    if (victim < 0)
+      return false;
+
+    uint64_t low;
+    uint64_t high;
+
+    {
+      Range& range = ranges_[victim];
+      std::lock_guard<std::mutex> lock(range.mutex);
+      uint64_t dist = range.high - range.low;
+
+      // The victim's range has been emptied
+      // in the meantime, try again.
+      if (dist == 0)
+        continue;
+
+      uint64_t half = dist / 2;
+      if (half < minChunk_)
+        half = dist;
+
+      high = range.high;
+      low = high - half;
+      range.high = low;
+    }
+
+    Range& range = ranges_[thread];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    range.low = low;
+    range.high = high;
+
+    return true;
+  }
+}
+
+} // namespace
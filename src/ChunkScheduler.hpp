@@ -0,0 +1,82 @@
+///
+/// @file   ChunkScheduler.hpp
+/// @brief  Work-stealing scheduler with guided chunk sizes used
+///         by ParallelSieve for counting primes.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef CHUNKSCHEDULER_HPP
+#define CHUNKSCHEDULER_HPP
+
+#include <primesieve/config.hpp>
+#include <primesieve/macros.hpp>
+
+#include <stdint.h>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace primesieve {
+
+/// The interval [start, stop] is split into one contiguous
+/// range per thread. Each thread takes chunks from the front
+/// of its own range, the chunk size is proportional to the
+/// total remaining distance (guided self-scheduling), hence
+/// chunks start large and get smaller towards the end. Once
+/// a thread's range is empty it steals the upper half of the
+/// largest remaining range of another thread.
+///
+/// On computers with multiple NUMA nodes, threads first try to
+/// steal from threads on the same NUMA node. This is only a
+/// preference: the ranges are assigned by thread id, not by
+/// NUMA node. Hence the threads of a node do not own a
+/// contiguous block of [start, stop]. The memory that matters
+/// (sieve array and buckets) is allocated by each thread and
+/// is therefore node-local anyway. Only the stealing order is
+/// NUMA aware.
+///
+/// Consecutive chunks share their boundary: chunk [low, high]
+/// is followed by chunk [high, x]. The caller is responsible
+/// for mapping these bounds to non-overlapping intervals.
+///
+class ChunkScheduler
+{
+public:
+  ChunkScheduler(uint64_t start,
+                 uint64_t stop,
+                 int threads,
+                 uint64_t minChunk,
+                 uint64_t maxChunk);
+
+  void setNode(int thread, std::size_t node);
+  bool next(int thread, uint64_t* low, uint64_t* high);
+
+private:
+  bool steal(int thread);
+
+  struct Range
+  {
+    std::mutex mutex;
+    uint64_t low = 0;
+    uint64_t high = 0;
+    /// NUMA node of the thread
+    std::size_t node = 0;
+    // Use padding to avoid CPU false sharing
+    MAYBE_UNUSED char pad[config::MAX_CACHE_LINE_SIZE];
+  };
+
+  std::unique_ptr<Range[]> ranges_;
+  std::atomic<uint64_t> remaining_;
+  uint64_t minChunk_;
+  uint64_t maxChunk_;
+  int threads_;
+};
+
+} // namespace
+
+#endif
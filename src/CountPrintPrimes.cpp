@@ -15,16 +15,19 @@
 #include "CountPrintPrimes.hpp"
 #include "Erat.hpp"
 #include "PrimeSieveClass.hpp"
+#include "PrintFormat.hpp"
+#include "SharedSievingPrimes.hpp"
 #include "SievingPrimes.hpp"
 
+#include <primesieve/ctz.hpp>
 #include <primesieve/forward.hpp>
 #include <primesieve/macros.hpp>
 #include <primesieve/pmath.hpp>
+#include <primesieve/popcnt.hpp>
 #include <primesieve/util.hpp>
 
 #include <stdint.h>
 #include <algorithm>
-#include <iostream>
 
 using namespace primesieve;
 
@@ -94,6 +97,7 @@ ALWAYS_INLINE void append_prime_as_string(Vector<char>& vect, uint64_t prime)
 namespace primesieve {
 
 CountPrintPrimes::CountPrintPrimes(PrimeSieve& ps) :
+  printBuffer_(ps.getPrintBuffer()),
   counts_(ps.getCounts()),
   ps_(ps)
 {
@@ -113,11 +117,14 @@ CountPrintPrimes::CountPrintPrimes(PrimeSieve& ps) :
 ///
 void CountPrintPrimes::initCounts()
 {
+  kMasks_.fill(0);
+
   for (unsigned i = 1; i < counts_.size(); i++)
   {
     if (ps_.isCount(i))
     {
       kCounts_[i].resize(256);
+      maxK_ = i;
 
       for (uint64_t j = 0; j < 256; j++)
       {
@@ -126,14 +133,43 @@ void CountPrintPrimes::initCounts()
           if ((j & *b) == *b)
             kCounts_[i][j]++;
       }
+
+      // The k-tuplet patterns are runs of i + 1
+      // consecutive 1 bits within a byte.
+      for (auto* b = bitmasks[i]; *b <= 0xff; b++)
+      {
+        uint64_t first = ctz64(*b);
+        ASSERT(*b >> first == (2ull << i) - 1);
+        kMasks_[i] |= (1ull << first) * 0x0101010101010101ull;
+      }
     }
   }
 }
 
+/// The sieving primes are either generated using SievingPrimes
+/// or read from the sieving primes shared by all threads.
+///
 void CountPrintPrimes::sieve()
 {
-  uint64_t sieveSize = ps_.getSieveSize();
-  INDETERMINATE SievingPrimes sievingPrimes(this, sieveSize, memoryPool_);
+  const SharedSievingPrimes* shared = ps_.getSievingPrimes();
+
+  if (shared)
+  {
+    ASSERT(shared->getMaxPrime() >= isqrt(stop_));
+    SharedSievingPrimes::Reader sievingPrimes(*shared);
+    sieve(sievingPrimes);
+  }
+  else
+  {
+    uint64_t sieveSize = ps_.getSieveSize();
+    INDETERMINATE SievingPrimes sievingPrimes(this, sieveSize, memoryPool_);
+    sieve(sievingPrimes);
+  }
+}
+
+template <typename T>
+void CountPrintPrimes::sieve(T& sievingPrimes)
+{
   uint64_t prime = sievingPrimes.next();
 
   while (hasNextSegment())
@@ -144,12 +180,22 @@ void CountPrintPrimes::sieve()
     for (; prime <= sqrtHigh; prime = sievingPrimes.next())
       addSievingPrime(prime);
 
-    sieveSegment();
+    if (ps_.getHistogram())
+    {
+      sieveSegment();
+      countHistogram();
+    }
+    else
+    {
+      // Count the primes while sieving
+      if (ps_.isCountPrimes())
+        counts_[0] += sieveCountSegment();
+      else
+        sieveSegment();
+      if (ps_.isCountkTuplets())
+        countkTuplets(0, sieve_.size() * sizeof(uint64_t), counts_);
+    }
 
-    if (ps_.isCountPrimes())
-      counts_[0] += popcount(sieve_);
-    if (ps_.isCountkTuplets())
-      countkTuplets();
     if (ps_.isPrintPrimes())
       printPrimes();
     if (ps_.isPrintkTuplets())
@@ -159,39 +205,289 @@ void CountPrintPrimes::sieve()
   }
 }
 
-void CountPrintPrimes::countkTuplets()
+/// Continue sieving mode used by ParallelSieve. Count the primes
+/// and prime k-tuplets inside [start, stop]. If start follows
+/// the stop number of the previous countChunk() call, we continue
+/// sieving where we stopped, this way the sieving primes and
+/// their multiples are not recomputed for each chunk. Otherwise
+/// we restart sieving at start, but keep all allocated memory.
+/// @pre stop % 30 == 2 or stop == stop_, hence the chunks
+///      end at a byte boundary of the sieve array.
+///
+void CountPrintPrimes::countChunk(uint64_t start, uint64_t stop)
 {
-  // i = 1 twins, i = 2 triplets, ...
-  for (unsigned i = 1; i < counts_.size(); i++)
+  ASSERT(start >= 7);
+  ASSERT(start <= stop);
+  ASSERT(stop <= stop_);
+  ASSERT(stop % 30 == 2 || stop == stop_);
+  ASSERT(!ps_.isPrint());
+
+  if (start != next_)
+    restart(start);
+
+  // Overflows to 0 if stop = 2^64-1
+  next_ = stop + 1;
+  bool isCounted = false;
+
+  while (true)
   {
-    if (ps_.isCount(i))
+    if (byteIdx_ >= sieveBytes_)
     {
-      const uint8_t* sieve = (const uint8_t*) sieve_.data();
-      std::size_t sieveBytes = sieve_.size() * sizeof(uint64_t);
-      uint64_t sum = 0;
+      if (!hasNextSegment() ||
+          segmentLow_ + 7 > stop)
+        break;
+
+      low_ = segmentLow_;
+      uint64_t sqrtHigh = isqrt(segmentHigh_);
+
+      if (ps_.getSievingPrimes())
+        for (; prime_ <= sqrtHigh; prime_ = sharedPrimes_.next())
+          addSievingPrime(prime_);
+      else
+        for (; prime_ <= sqrtHigh; prime_ = sievingPrimes_.next())
+          addSievingPrime(prime_);
+
+      // If the entire segment is <= stop
+      // we count the primes while sieving.
+      isCounted = ps_.isCountPrimes() && segmentHigh_ <= stop;
+
+      if (isCounted)
+        counts_[0] += sieveCountSegment();
+      else
+        sieveSegment();
+
+      byteIdx_ = 0;
+      sieveBytes_ = sieve_.size() * sizeof(uint64_t);
+    }
 
-      for (std::size_t j = 0; j < sieveBytes; j += 4)
-      {
-        sum += kCounts_[i][sieve[j+0]];
-        sum += kCounts_[i][sieve[j+1]];
-        sum += kCounts_[i][sieve[j+2]];
-        sum += kCounts_[i][sieve[j+3]];
-      }
+    // Bytes of the current segment <= stop
+    std::size_t first = byteIdx_;
+    std::size_t last = first;
 
-      counts_[i] += sum;
+    if (stop >= low_ + 7)
+    {
+      uint64_t bytes = (stop - low_ - 7) / 30 + 1;
+      last = (std::size_t) std::min(bytes, (uint64_t) sieveBytes_);
+      last = std::max(last, first);
     }
+
+    if (ps_.isCountPrimes() && !isCounted)
+      countPrimes(first, last);
+    if (ps_.isCountkTuplets())
+      countkTuplets(first, last, counts_);
+    if (ps_.isStatus())
+      ps_.updateStatus((last - first) * 30);
+
+    byteIdx_ = last;
+
+    if (last < sieveBytes_)
+      break;
   }
 }
 
-/// Print primes to stdout
-void CountPrintPrimes::printPrimes()
+/// Restart sieving at start, the MemoryPool's buckets
+/// are reused for the new sieving primes.
+///
+void CountPrintPrimes::restart(uint64_t start)
+{
+  uint64_t sieveSize = ps_.getSieveSize();
+  memoryPool_.reset();
+  Erat::init(start, stop_, sieveSize, memoryPool_);
+  const SharedSievingPrimes* shared = ps_.getSievingPrimes();
+
+  if (shared)
+  {
+    ASSERT(shared->getMaxPrime() >= isqrt(stop_));
+    sharedPrimes_ = SharedSievingPrimes::Reader(*shared);
+    prime_ = sharedPrimes_.next();
+  }
+  else
+  {
+    sievingPrimes_.init(this, sieveSize, memoryPool_);
+    prime_ = sievingPrimes_.next();
+  }
+
+  byteIdx_ = 0;
+  sieveBytes_ = 0;
+}
+
+/// Count the primes inside the bytes [first, last[
+/// of the sieve array.
+///
+void CountPrintPrimes::countPrimes(std::size_t first, std::size_t last)
+{
+  std::size_t sieveBytes = sieve_.size() * sizeof(uint64_t);
+
+  if (first == 0 && last == sieveBytes)
+    counts_[0] += popcount(sieve_);
+  else
+  {
+    const uint8_t* sieve = (const uint8_t*) sieve_.data();
+    uint64_t sum = 0;
+
+    for (; first < last && first % 8 != 0; first++)
+      sum += popcnt64(sieve[first]);
+    for (; first + 8 <= last; first += 8)
+      sum += popcnt64(sieve_[first / 8]);
+    for (; first < last; first++)
+      sum += popcnt64(sieve[first]);
+
+    counts_[0] += sum;
+  }
+}
+
+/// Count the prime k-tuplets inside the bytes [first, last[
+/// of the sieve array. All requested k-tuplet types are
+/// counted in a single pass over the sieve words: a run of
+/// i + 1 consecutive 1 bits is found using i shifts and ANDs,
+/// the runs at the pattern positions (kMasks_) are then
+/// counted using popcnt64().
+///
+void CountPrintPrimes::countkTuplets(std::size_t first,
+                                     std::size_t last,
+                                     counts_t& counts)
+{
+  const uint8_t* sieve = (const uint8_t*) sieve_.data();
+
+  for (; first < last && first % 8 != 0; first++)
+    countkTuplets(sieve[first], counts);
+
+  std::size_t wordLast = first + (last - first) / 8 * 8;
+  counts_t sums;
+  sums.fill(0);
+
+  for (std::size_t j = first / 8; j < wordLast / 8; j++)
+  {
+    uint64_t bits = to_littleendian(sieve_[j]);
+    uint64_t run = bits;
+
+    // i = 1 twins, i = 2 triplets, ...
+    for (unsigned i = 1; i <= maxK_; i++)
+    {
+      run &= bits >> i;
+      sums[i] += popcnt64(run & kMasks_[i]);
+    }
+  }
+
+  for (unsigned i = 1; i <= maxK_; i++)
+    counts[i] += sums[i];
+
+  for (first = wordLast; first < last; first++)
+    countkTuplets(sieve[first], counts);
+}
+
+/// Count the prime k-tuplets of a single byte
+void CountPrintPrimes::countkTuplets(uint8_t byte, counts_t& counts)
+{
+  for (unsigned i = 1; i <= maxK_; i++)
+    if (ps_.isCount(i))
+      counts[i] += kCounts_[i][byte];
+}
+
+/// Histogram mode: count the primes and prime k-tuplets of
+/// the current segment per bucket. Bucket edges that fall
+/// inside the segment are mapped to bit indexes of the
+/// sieve array, the bits of each bucket are then counted
+/// using popcount() on whole words.
+///
+void CountPrintPrimes::countHistogram()
+{
+  Vector<counts_t>& histogram = *ps_.getHistogram();
+  uint64_t bits = sieve_.size() * 64;
+  uint64_t maxDist = sieve_.size() * 240 + 7;
+  uint64_t bucket = ps_.getBucket(std::max(low_ + 7, start_));
+  uint64_t first = 0;
+
+  while (true)
+  {
+    ASSERT(bucket < histogram.size());
+    uint64_t bucketStop = ps_.getBucketStop(bucket);
+    uint64_t last = bits;
+
+    if (bucketStop < stop_ &&
+        bucketStop + 1 - low_ < maxDist)
+      last = Erat::bitIndex(bucketStop + 1 - low_);
+
+    countBits(first, last, histogram[bucket]);
+
+    if (last >= bits)
+      break;
+
+    first = last;
+    bucket++;
+  }
+}
+
+/// Count the primes and prime k-tuplets inside the bits
+/// [first, last[ of the sieve array. The bits of partial
+/// bytes are masked, hence a prime k-tuplet is only
+/// counted if all its primes are inside [first, last[.
+///
+void CountPrintPrimes::countBits(uint64_t first,
+                                 uint64_t last,
+                                 counts_t& counts)
+{
+  ASSERT(first <= last);
+
+  if (ps_.isCountPrimes())
+    counts[0] += Erat::countBits(sieve_.data(), first, last);
+
+  if (ps_.isCountkTuplets())
+  {
+    const uint8_t* sieve = (const uint8_t*) sieve_.data();
+    std::size_t byteFirst = (std::size_t) ceilDiv(first, (uint64_t) 8);
+    std::size_t byteLast = (std::size_t) (last / 8);
+
+    if (byteFirst <= byteLast)
+    {
+      countkTuplets(byteFirst, byteLast, counts);
+      if (first % 8)
+        countkTuplets((uint8_t) (sieve[first / 8] & (0xff << (first % 8))), counts);
+      if (last % 8)
+        countkTuplets((uint8_t) (sieve[byteLast] & ((1u << (last % 8)) - 1)), counts);
+    }
+    else
+    {
+      // first and last are inside the same byte
+      unsigned mask = (0xff << (first % 8)) & ((1u << (last % 8)) - 1);
+      countkTuplets((uint8_t) (sieve[first / 8] & mask), counts);
+    }
+  }
+}
+
+/// When printing using multi-threading the primes are
+/// appended to the PrimeSieve's print buffer, which is
+/// later printed in order by the ParallelSieve class.
+///
+Vector<char>& CountPrintPrimes::getBuffer()
+{
+  if (printBuffer_)
+    return *printBuffer_;
+  else
+  {
+    charBuffer_.clear();
+    return charBuffer_;
+  }
+}
+
+void CountPrintPrimes::print(Vector<char>& buffer)
+{
+  if (!printBuffer_)
+    ps_.write(buffer.data(), buffer.size());
+}
+
+/// @writePrime: Writes a prime to a char pointer
+/// using the user's print format.
+///
+template <typename T>
+void CountPrintPrimes::printPrimes(T writePrime)
 {
   uint64_t low = low_;
   std::size_t i = 0;
 
   while (i < sieve_.size())
   {
-    charBuffer_.clear();
+    Vector<char>& buffer = getBuffer();
     std::size_t size = i + (1 << 13);
     size = std::min(size, sieve_.size());
 
@@ -199,17 +495,62 @@ void CountPrintPrimes::printPrimes()
     {
       uint64_t bits = to_littleendian(sieve_[i]);
 
+      // Reserve space for the 64 primes of the
+      // sieve word instead of resizing per prime.
+      std::size_t oldSize = buffer.size();
+      buffer.resize(oldSize + 64 * MAX_PRIME_BYTES);
+      char* p = &buffer[oldSize];
+
       for (; bits != 0; bits &= bits - 1)
       {
         uint64_t prime = nextPrime(bits, low);
-        append_prime_as_string(charBuffer_, prime);
-        charBuffer_.push_back('\n');
+        p = writePrime(p, prime);
       }
 
+      buffer.resize(p - buffer.data());
       low += 8 * 30;
     }
 
-    std::cout.write(charBuffer_.data(), charBuffer_.size());
+    print(buffer);
+  }
+}
+
+/// Print primes to stdout
+void CountPrintPrimes::printPrimes()
+{
+  switch (ps_.getPrintFormat())
+  {
+    case UINT32_FORMAT:
+      printPrimes([](char* p, uint64_t prime) {
+        return write_prime_uint32(p, prime);
+      });
+      break;
+
+    case UINT64_FORMAT:
+      printPrimes([](char* p, uint64_t prime) {
+        return write_prime_uint64(p, prime);
+      });
+      break;
+
+    case GAPS_FORMAT:
+    {
+      // The gaps continue after the primes
+      // printed by the previous segments.
+      uint64_t prev = ps_.getPrevPrime();
+      printPrimes([&](char* p, uint64_t prime) {
+        return write_prime_gap(p, prime, prev);
+      });
+      ps_.setPrevPrime(prev);
+      break;
+    }
+
+    default:
+    {
+      DecimalPrinter decimalPrinter;
+      printPrimes([&](char* p, uint64_t prime) {
+        return decimalPrinter.write(p, prime);
+      });
+    }
   }
 }
 
@@ -219,7 +560,7 @@ void CountPrintPrimes::printkTuplets()
   // i = 1 twins, i = 2 triplets, ...
   unsigned i = 1;
   uint64_t low = low_;
-  charBuffer_.clear();
+  Vector<char>& buffer = getBuffer();
   const uint8_t* sieve = (const uint8_t*) sieve_.data();
   std::size_t sieveBytes = sieve_.size() * sizeof(uint64_t);
 
@@ -232,30 +573,30 @@ void CountPrintPrimes::printkTuplets()
     {
       if ((sieve[j] & *bitmask) == *bitmask)
       {
-        charBuffer_.push_back('(');
+        buffer.push_back('(');
         uint64_t bits = *bitmask;
 
         for (; bits != 0; bits &= bits - 1)
         {
           uint64_t prime = nextPrime(bits, low);
-          append_prime_as_string(charBuffer_, prime);
+          append_prime_as_string(buffer, prime);
 
           if (bits & (bits - 1))
           {
-            charBuffer_.push_back(',');
-            charBuffer_.push_back(' ');
+            buffer.push_back(',');
+            buffer.push_back(' ');
           }
           else
           {
-            charBuffer_.push_back(')');
-            charBuffer_.push_back('\n');
+            buffer.push_back(')');
+            buffer.push_back('\n');
           }
         }
       }
     }
   }
 
-  std::cout.write(charBuffer_.data(), charBuffer_.size());
+  print(buffer);
 }
 
 } // namespace
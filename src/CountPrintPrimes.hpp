@@ -13,11 +13,14 @@
 #include "Erat.hpp"
 #include "MemoryPool.hpp"
 #include "PrimeSieveClass.hpp"
+#include "SharedSievingPrimes.hpp"
+#include "SievingPrimes.hpp"
 
 #include <primesieve/macros.hpp>
 #include <primesieve/Vector.hpp>
 
 #include <stdint.h>
+#include <cstddef>
 
 namespace primesieve {
 
@@ -30,19 +33,45 @@ class CountPrintPrimes : public Erat
 public:
   CountPrintPrimes(PrimeSieve&);
   NOINLINE void sieve();
+  NOINLINE void countChunk(uint64_t start, uint64_t stop);
 private:
   uint64_t low_ = 0;
+  /// Continue sieving mode state, see countChunk()
+  uint64_t next_ = 0;
+  uint64_t prime_ = 0;
+  std::size_t byteIdx_ = 0;
+  std::size_t sieveBytes_ = 0;
+  SievingPrimes sievingPrimes_;
+  SharedSievingPrimes::Reader sharedPrimes_;
   /// Count lookup tables for prime k-tuplets
   Vector<uint8_t> kCounts_[6];
+  /// kMasks_[i] has a 1 bit at the first bit of each
+  /// k-tuplet pattern of each byte, 0 if not counted.
+  counts_t kMasks_;
+  /// Largest k-tuplet index that is counted
+  unsigned maxK_ = 0;
   Vector<char> charBuffer_;
+  /// Ordered multi-threaded printing buffer
+  Vector<char>* printBuffer_ = nullptr;
   counts_t& counts_;
   /// Reference to the associated PrimeSieve object
   PrimeSieve& ps_;
   MemoryPool memoryPool_;
+  template <typename T>
+  void sieve(T& sievingPrimes);
   void initCounts();
-  void countkTuplets();
+  void restart(uint64_t start);
+  void countPrimes(std::size_t first, std::size_t last);
+  void countkTuplets(std::size_t first, std::size_t last, counts_t& counts);
+  void countkTuplets(uint8_t byte, counts_t& counts);
+  void countHistogram();
+  void countBits(uint64_t first, uint64_t last, counts_t& counts);
   void printPrimes();
+  template <typename T>
+  void printPrimes(T appendPrime);
   void printkTuplets();
+  Vector<char>& getBuffer();
+  void print(Vector<char>& buffer);
 };
 
 } // namespace
@@ -17,8 +17,11 @@
 #include "PreSieve.hpp"
 
 #include <primesieve/config.hpp>
+#include <primesieve/forward.hpp>
 #include <primesieve/macros.hpp>
 #include <primesieve/pmath.hpp>
+#include <primesieve/popcnt.hpp>
+#include <primesieve/util.hpp>
 
 #include <stdint.h>
 #include <algorithm>
@@ -46,6 +49,17 @@ const primesieve::Array<uint8_t, 37> unsetLarger =
   0xff, 0xff, 0xff, 0xff, 0xff
 };
 
+/// Number of bits of a sieve byte whose numbers are < rem,
+/// this is the popcount of ~unsetSmaller[rem].
+const primesieve::Array<uint8_t, 37> bitsSmaller =
+{
+  0, 0, 0, 0, 0, 0, 0, 0,
+  1, 1, 1, 1, 2, 2, 3, 3,
+  3, 3, 4, 4, 5, 5, 5, 5,
+  6, 6, 6, 6, 6, 6, 7, 7,
+  8, 8, 8, 8, 8
+};
+
 } // namespace
 
 namespace primesieve {
@@ -236,12 +250,69 @@ uint64_t Erat::byteRemainder(uint64_t n)
   return (n - 7) % 30 + 7;
 }
 
+/// Number of bits of the sieve array whose numbers are
+/// < segmentLow + dist, segmentLow is a multiple of 30.
+///
+uint64_t Erat::bitIndex(uint64_t dist)
+{
+  if (dist <= 7)
+    return 0;
+
+  uint64_t rem = byteRemainder(dist);
+  uint64_t byte = (dist - rem) / 30;
+  return byte * 8 + bitsSmaller[rem];
+}
+
+/// Count the 1 bits of the sieve array inside [first, last[.
+/// Bit i of the sieve array is bit (i % 8) of byte (i / 8),
+/// i.e. bit (i % 64) of the little-endian word (i / 64).
+///
+uint64_t Erat::countBits(const uint64_t* sieve,
+                         uint64_t first,
+                         uint64_t last)
+{
+  if (first >= last)
+    return 0;
+
+  uint64_t i = first / 64;
+  uint64_t j = last / 64;
+  uint64_t lowMask = ~0ull << (first % 64);
+  uint64_t highMask = ~0ull >> (63 - (last - 1) % 64);
+
+  if (i == (last - 1) / 64)
+    return popcnt64(to_littleendian(sieve[i]) & lowMask & highMask);
+
+  uint64_t count = popcnt64(to_littleendian(sieve[i]) & lowMask);
+  count += popcount(&sieve[i + 1], j - (i + 1));
+
+  if (last % 64)
+    count += popcnt64(to_littleendian(sieve[j]) & highMask);
+
+  return count;
+}
+
 void Erat::sieveSegment()
+{
+  sieveSegment(nullptr);
+}
+
+/// Sieve the next segment and return the number
+/// of 1 bits of its sieve array. The bits are counted
+/// while crossing off (see crossOff(count)).
+///
+uint64_t Erat::sieveCountSegment()
+{
+  uint64_t count = 0;
+  sieveSegment(&count);
+  return count;
+}
+
+void Erat::sieveSegment(uint64_t* count)
 {
   if (segmentHigh_ < stop_)
   {
     preSieve();
-    crossOff();
+    crossOff(count);
 
     uint64_t dist = sieve_.size() * 240;
     segmentLow_ = checkedAdd(segmentLow_, dist);
@@ -249,10 +320,10 @@ void Erat::sieveSegment()
     segmentHigh_ = std::min(segmentHigh_, stop_);
   }
   else
-    sieveLastSegment();
+    sieveLastSegment(count);
 }
 
-void Erat::sieveLastSegment()
+void Erat::sieveLastSegment(uint64_t* count)
 {
   uint64_t rem = byteRemainder(stop_);
   uint64_t dist = (stop_ - rem) - segmentLow_;
@@ -260,7 +331,10 @@ void Erat::sieveLastSegment()
   sieve_.resize(ceilDiv(sieveBytes, sizeof(uint64_t)));
 
   preSieve();
-  crossOff();
+
+  // Crossing off only unsets bits, hence we can unset
+  // the bits > stop before crossing off. This way
+  // crossOff(count) counts the final sieve array.
 
   // unset bits > stop
   uint8_t* sieve = (uint8_t*) sieve_.data();
@@ -271,6 +345,7 @@ void Erat::sieveLastSegment()
   for (; i % sizeof(uint64_t); i++)
     sieve[i] = 0;
 
+  crossOff(count);
   segmentLow_ = stop_;
 }
 
@@ -290,14 +365,29 @@ void Erat::preSieve()
   }
 }
 
-void Erat::crossOff()
+/// If count != nullptr the 1 bits of the sieve array are
+/// added to count. In this case EratMedium and EratBig cross
+/// off their multiples first and EratSmall runs last, so that
+/// EratSmall can count each L1 cache sized chunk right after
+/// its final write. This saves an additional pass over the
+/// (L2 cache sized) sieve array.
+///
+void Erat::crossOff(uint64_t* count)
 {
-  if (eratSmall_.hasSievingPrimes())
+  if (!count && eratSmall_.hasSievingPrimes())
     eratSmall_.crossOff(sieve_);
   if (eratMedium_.hasSievingPrimes())
     eratMedium_.crossOff(sieve_);
   if (eratBig_.hasSievingPrimes())
     eratBig_.crossOff(sieve_);
+
+  if (count)
+  {
+    if (eratSmall_.hasSievingPrimes())
+      *count += eratSmall_.crossOffCount(sieve_);
+    else
+      *count += popcount(sieve_);
+  }
 }
 
 } // namespace
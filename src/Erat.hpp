@@ -35,6 +35,9 @@ class Erat
 {
 public:
   uint64_t getStop() const;
+  static uint64_t bitIndex(uint64_t dist);
+  static uint64_t countBits(const uint64_t* sieve, uint64_t first, uint64_t last);
+  static uint64_t nextPrime(uint64_t, uint64_t);
 
 protected:
   /// Sieve primes >= start_
@@ -52,8 +55,8 @@ protected:
   void init(uint64_t, uint64_t, uint64_t, MemoryPool& memoryPool);
   void addSievingPrime(uint64_t);
   NOINLINE void sieveSegment();
+  NOINLINE uint64_t sieveCountSegment();
   bool hasNextSegment() const;
-  static uint64_t nextPrime(uint64_t, uint64_t);
 
 private:
   uint64_t maxEratSmall_ = 0;
@@ -65,8 +68,9 @@ private:
   static uint64_t getL1CacheSize();
   void initAlgorithms(uint64_t maxSieveBytes, MemoryPool&);
   void preSieve();
-  void crossOff();
-  void sieveLastSegment();
+  void crossOff(uint64_t* count);
+  void sieveSegment(uint64_t* count);
+  void sieveLastSegment(uint64_t* count);
 };
 
 /// Convert the 1st set bit into a prime number.
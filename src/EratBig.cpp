@@ -146,6 +146,7 @@ void EratBig::init(uint64_t stop,
   uint64_t maxMultipleIndex = sieveBytes - 1 + maxNextMultiple;
   uint64_t maxSegmentIndex = maxMultipleIndex >> log2SieveBytes_;
   uint64_t maxSize = maxSegmentIndex + 1;
+  buckets_.clear();
   buckets_.reserve(maxSize);
 }
 
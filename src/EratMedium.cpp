@@ -42,6 +42,8 @@ void EratMedium::init(uint64_t stop,
   stop_ = stop;
   maxPrime_ = maxPrime;
   memoryPool_ = &memoryPool;
+  buckets_.clear();
+  currentBuckets_.clear();
 }
 
 /// Add a new sieving prime to EratMedium
@@ -19,6 +19,7 @@
 #include "Bucket.hpp"
 
 #include <primesieve/bits.hpp>
+#include <primesieve/forward.hpp>
 #include <primesieve/macros.hpp>
 #include <primesieve/pmath.hpp>
 
@@ -43,6 +44,7 @@ void EratSmall::init(uint64_t stop,
   maxPrime_ = maxPrime;
   l1CacheSize_ = (std::size_t) l1CacheSize;
   std::size_t count = primeCountUpper(maxPrime);
+  primes_.clear();
   primes_.reserve(count);
 }
 
@@ -73,6 +75,30 @@ void EratSmall::crossOff(Vector<uint64_t>& sieve)
   }
 }
 
+/// Same as crossOff(sieve) but additionally counts the 1 bits
+/// of the sieve array. Each L1 cache sized chunk is counted
+/// right after its multiples have been crossed off while it is
+/// still in the L1 cache. This avoids an additional pass over
+/// the sieve array but requires that EratMedium and EratBig
+/// have already crossed off their multiples.
+///
+uint64_t EratSmall::crossOffCount(Vector<uint64_t>& sieve)
+{
+  ASSERT(l1CacheSize_ % sizeof(uint64_t) == 0);
+  uint8_t* sieve8 = (uint8_t*) sieve.data();
+  std::size_t sieveBytes = sieve.size() * sizeof(uint64_t);
+  uint64_t count = 0;
+
+  for (std::size_t i = 0; i < sieveBytes; i += l1CacheSize_)
+  {
+    std::size_t chunkSize = std::min(l1CacheSize_, sieveBytes - i);
+    crossOff(&sieve8[i], chunkSize);
+    count += popcount(&sieve[i / sizeof(uint64_t)], chunkSize / sizeof(uint64_t));
+  }
+
+  return count;
+}
+
 /// Segmented sieve of Eratosthenes with wheel factorization
 /// optimized for small sieving primes that have many multiples
 /// per segment. This algorithm uses a hardcoded modulo 30
@@ -30,6 +30,7 @@ class EratSmall : public Wheel30_t
 public:
   void init(uint64_t, uint64_t, uint64_t);
   void crossOff(Vector<uint64_t>& sieve);
+  uint64_t crossOffCount(Vector<uint64_t>& sieve);
   bool hasSievingPrimes() const { return !primes_.empty(); }
 private:
   uint64_t maxPrime_ = 0;
@@ -0,0 +1,232 @@
+///
+/// @file   GapCounter.cpp
+/// @brief  Prime gap analysis using a single sieving pass. The
+///         primes are not stored, the gaps are computed directly
+///         from the 1 bits of the sieve array of each segment and
+///         runs of zero words (large gaps) are skipped. Each
+///         segment adds the gaps between its own primes to the
+///         accumulator of its thread, the gaps between the last
+///         prime of a segment and the first prime of the next
+///         segment are added by finish().
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "GapCounter.hpp"
+#include "Erat.hpp"
+
+#include <primesieve/macros.hpp>
+#include <primesieve/popcnt.hpp>
+#include <primesieve/util.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace primesieve {
+
+GapCounter::GapCounter(uint64_t start, uint64_t stop) :
+  start_(start),
+  stop_(stop)
+{ }
+
+void GapCounter::addGap(Vector<Gap>& gaps,
+                        uint64_t prime,
+                        uint64_t gap)
+{
+  if (gap >= gaps.size())
+    gaps.resize(gap + 1);
+
+  gaps[gap].count++;
+  if (!gaps[gap].first || prime < gaps[gap].first)
+    gaps[gap].first = prime;
+}
+
+/// Must be called once by each thread before it adds its
+/// first segment, the thread's gaps are merged by finish().
+///
+GapCounter::Local* GapCounter::addThread()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  locals_.emplace_back(new Local);
+  Local* local = locals_.back().get();
+  local->counter = this;
+  local->gaps.resize(256);
+  return local;
+}
+
+/// Add the gaps between the primes of the segment's sieve
+/// array to the thread's Local object, low % 30 == 0.
+///
+void GapCounter::addSegment(Local& local,
+                            uint64_t low,
+                            const uint64_t* sieve,
+                            std::size_t size)
+{
+  ASSERT(low % 30 == 0);
+  Vector<Gap>& gaps = local.gaps;
+  Gap* data = gaps.data();
+  std::size_t maxGap = gaps.size();
+  uint64_t count = 0;
+  uint64_t first = 0;
+
+  // primes[0] is the previous prime, the primes
+  // of the current word are stored at primes[1].
+  Array<uint64_t, 1 + 64> primes;
+  primes[0] = 0;
+
+  for (std::size_t i = 0; i < size; i++)
+  {
+    uint64_t bits = to_littleendian(sieve[i]);
+
+    // Skip the words without primes
+    if (bits == 0)
+      continue;
+
+    uint64_t wordLow = low + i * 240;
+    std::size_t num = popcnt64(bits);
+    count += num;
+    std::size_t j = 1;
+
+    // Convert the 1 bits into primes, nextPrime()
+    // may be called with bits = 0 (see Erat.hpp).
+    do
+    {
+      primes[j+0] = Erat::nextPrime(bits, wordLow); bits &= bits - 1;
+      primes[j+1] = Erat::nextPrime(bits, wordLow); bits &= bits - 1;
+      primes[j+2] = Erat::nextPrime(bits, wordLow); bits &= bits - 1;
+      primes[j+3] = Erat::nextPrime(bits, wordLow); bits &= bits - 1;
+      j += 4;
+    }
+    while (j <= num);
+
+    j = 1;
+    if (!first)
+      first = primes[j++];
+
+    for (; j <= num; j++)
+    {
+      uint64_t prime = primes[j - 1];
+      uint64_t gap = primes[j] - prime;
+
+      if_unlikely(gap >= maxGap)
+      {
+        gaps.resize(gap + 1);
+        maxGap = gaps.size();
+        data = gaps.data();
+      }
+
+      // The segments of a thread are in ascending order
+      if (data[gap].count++ == 0)
+        data[gap].first = prime;
+    }
+
+    primes[0] = primes[num];
+  }
+
+  if (first)
+  {
+    local.primeCount += count;
+    local.bounds.push_back(Bounds{first, primes[0]});
+  }
+}
+
+/// Must be called after all segments have been added. Merges
+/// the Local objects of the threads, adds the primes < 7 and
+/// the gaps between adjacent segments, then computes the
+/// maximal gaps. A gap is maximal if all gaps between the
+/// primes >= start that precede it are smaller.
+///
+void GapCounter::finish()
+{
+  Vector<Bounds> bounds;
+
+  for (const auto& local : locals_)
+  {
+    const Vector<Gap>& gaps = local->gaps;
+    primeCount_ += local->primeCount;
+    bounds.insert(bounds.end(), local->bounds.begin(), local->bounds.end());
+
+    if (gaps.size() > gaps_.size())
+      gaps_.resize(gaps.size());
+
+    for (std::size_t gap = 0; gap < gaps.size(); gap++)
+    {
+      if (gaps[gap].count)
+      {
+        gaps_[gap].count += gaps[gap].count;
+        if (!gaps_[gap].first || gaps[gap].first < gaps_[gap].first)
+          gaps_[gap].first = gaps[gap].first;
+      }
+    }
+  }
+
+  locals_.clear();
+
+  for (uint64_t prime : { 2, 3, 5 })
+  {
+    if (start_ <= prime && prime <= stop_)
+    {
+      primeCount_++;
+      bounds.push_back(Bounds{prime, prime});
+    }
+  }
+
+  std::sort(bounds.begin(), bounds.end(),
+    [](const Bounds& a, const Bounds& b) { return a.first < b.first; });
+
+  for (std::size_t i = 1; i < bounds.size(); i++)
+  {
+    uint64_t prime = bounds[i - 1].last;
+    addGap(gaps_, prime, bounds[i].first - prime);
+  }
+
+  // Remove the unused gap sizes
+  std::size_t size = gaps_.size();
+  while (size > 0 && !gaps_[size - 1].count)
+    size--;
+  gaps_.resize(size);
+
+  // The first occurrences of the maximal gaps are
+  // smaller than the first occurrences of all larger gaps.
+  records_.clear();
+  uint64_t minFirst = ~0ull;
+
+  for (std::size_t gap = gaps_.size(); gap-- > 0;)
+  {
+    uint64_t first = gaps_[gap].first;
+    if (first && first < minFirst)
+    {
+      records_.push_back(Record{first, gap});
+      minFirst = first;
+    }
+  }
+
+  std::reverse(records_.begin(), records_.end());
+}
+
+/// Number of primes inside [start, stop]
+uint64_t GapCounter::getPrimeCount() const
+{
+  return primeCount_;
+}
+
+/// getGaps()[g] contains the gaps of size g
+const Vector<GapCounter::Gap>& GapCounter::getGaps() const
+{
+  return gaps_;
+}
+
+/// The maximal gaps in ascending order
+const Vector<GapCounter::Record>& GapCounter::getRecords() const
+{
+  return records_;
+}
+
+} // namespace
@@ -0,0 +1,90 @@
+///
+/// @file   GapCounter.hpp
+/// @brief  Prime gap analysis: counts the gaps of each size,
+///         finds the first occurrence of each gap size and the
+///         maximal (record) gaps inside [start, stop].
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef GAPCOUNTER_HPP
+#define GAPCOUNTER_HPP
+
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace primesieve {
+
+/// Each thread adds its segments (in ascending order) to its
+/// own Local object, the Local objects of the threads are
+/// merged and the gaps between the segments are added by
+/// finish().
+///
+class GapCounter
+{
+public:
+  struct Gap
+  {
+    /// Number of gaps of this size
+    uint64_t count = 0;
+    /// Smaller prime of the first gap of this size, 0 if none
+    uint64_t first = 0;
+  };
+
+  struct Record
+  {
+    uint64_t prime;
+    uint64_t gap;
+  };
+
+  struct Bounds
+  {
+    uint64_t first;
+    uint64_t last;
+  };
+
+  /// The gaps of the segments of a thread, the
+  /// same Local object is used for all segments
+  /// of the thread.
+  struct Local
+  {
+    GapCounter* counter;
+    uint64_t primeCount = 0;
+    /// gaps[g] contains the gaps of size g
+    Vector<Gap> gaps;
+    /// First and last prime of each segment
+    Vector<Bounds> bounds;
+  };
+
+  GapCounter(uint64_t start, uint64_t stop);
+  Local* addThread();
+  void addSegment(Local& local, uint64_t low, const uint64_t* sieve, std::size_t size);
+  void finish();
+  uint64_t getPrimeCount() const;
+  const Vector<Gap>& getGaps() const;
+  const Vector<Record>& getRecords() const;
+
+private:
+  void addGap(Vector<Gap>& gaps, uint64_t prime, uint64_t gap);
+  uint64_t start_;
+  uint64_t stop_;
+  uint64_t primeCount_ = 0;
+  /// gaps_[g] contains the gaps of size g
+  Vector<Gap> gaps_;
+  Vector<Record> records_;
+  /// One Local object per thread
+  std::vector<std::unique_ptr<Local>> locals_;
+  std::mutex mutex_;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,199 @@
+///
+/// @file   IntervalCounter.cpp
+/// @brief  Count the primes inside many intervals using a single
+///         sieving pass. The sorted interval boundaries split the
+///         covering range into pieces. For each sieved segment the
+///         1 bits between consecutive boundaries are counted using
+///         popcount() on the words of the sieve array, at the
+///         boundaries the bits of the partial words are masked.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "IntervalCounter.hpp"
+#include "Erat.hpp"
+
+#include <primesieve/Vector.hpp>
+#include <primesieve/macros.hpp>
+#include <primesieve/pmath.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace primesieve {
+
+/// Intervals with start > stop are empty
+IntervalCounter::IntervalCounter(const uint64_t* starts,
+                                 const uint64_t* stops,
+                                 std::size_t size) :
+  starts_(starts),
+  stops_(stops),
+  size_(size)
+{
+  const uint64_t maxStop = std::numeric_limits<uint64_t>::max();
+  Vector<Range> intervals;
+
+  for (std::size_t i = 0; i < size; i++)
+  {
+    if (starts[i] > stops[i] || stops[i] < 7)
+      continue;
+
+    // The primes < 7 are not part of the sieve array
+    uint64_t start = std::max<uint64_t>(starts[i], 7);
+    intervals.push_back(Range{start, stops[i]});
+    bounds_.push_back(start);
+    if (stops[i] < maxStop)
+      bounds_.push_back(stops[i] + 1);
+  }
+
+  std::sort(intervals.begin(), intervals.end(),
+    [](const Range& a, const Range& b) { return a.start < b.start; });
+
+  // Merge the overlapping intervals. If the gap between 2
+  // intervals is small we also merge them, sieving the gap
+  // is cheaper than initializing the sieve again.
+  for (const auto& interval : intervals)
+  {
+    if (!ranges_.empty())
+    {
+      Range& last = ranges_.back();
+      uint64_t gap = std::max<uint64_t>(isqrt(interval.stop), 1 << 16);
+
+      if (interval.start <= checkedAdd(last.stop, gap))
+      {
+        last.stop = std::max(last.stop, interval.stop);
+        continue;
+      }
+    }
+
+    ranges_.push_back(interval);
+  }
+
+  std::sort(bounds_.begin(), bounds_.end());
+  bounds_.resize(std::unique(bounds_.begin(), bounds_.end()) - bounds_.begin());
+}
+
+/// The ranges that must be sieved
+const Vector<IntervalCounter::Range>& IntervalCounter::getRanges() const
+{
+  return ranges_;
+}
+
+/// Must be called once by each thread before it adds
+/// its first segment of the current range. The Local
+/// objects of the previous ranges are reused.
+///
+IntervalCounter::Local* IntervalCounter::addThread()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (threads_ == locals_.size())
+  {
+    locals_.emplace_back(new Local);
+    Local* local = locals_.back().get();
+    local->counter = this;
+    local->counts.resize(bounds_.size());
+    std::fill(local->counts.begin(), local->counts.end(), 0);
+  }
+
+  return locals_[threads_++].get();
+}
+
+/// Must be called after all threads have finished
+/// sieving the current range.
+///
+void IntervalCounter::finishRange()
+{
+  threads_ = 0;
+}
+
+/// Count the 1 bits of the sieve array of the segment that
+/// starts at low and add them to the thread's counts.
+///
+void IntervalCounter::addSegment(Local& local,
+                                 uint64_t low,
+                                 const uint64_t* sieve,
+                                 std::size_t size)
+{
+  ASSERT(low % 30 == 0);
+  uint64_t* counts = local.counts.data();
+  uint64_t bits = size * 64;
+  uint64_t maxDist = size * 8 * 30 + 7;
+
+  // Piece i - 1 contains the segment's first number
+  std::size_t i = std::upper_bound(bounds_.begin(), bounds_.end(), low) - bounds_.begin();
+  uint64_t first = 0;
+
+  for (; i < bounds_.size() && bounds_[i] - low < maxDist; i++)
+  {
+    uint64_t last = Erat::bitIndex(bounds_[i] - low);
+    uint64_t count = Erat::countBits(sieve, first, last);
+
+    if (count > 0)
+    {
+      ASSERT(i > 0);
+      counts[i - 1] += count;
+    }
+
+    first = last;
+  }
+
+  uint64_t count = Erat::countBits(sieve, first, bits);
+
+  if (count > 0)
+  {
+    ASSERT(i > 0);
+    counts[i - 1] += count;
+  }
+}
+
+/// Merge the counts of the threads, sum up the counts of
+/// the pieces of each interval and add the primes 2, 3 and 5.
+///
+void IntervalCounter::getCounts(uint64_t* counts) const
+{
+  Vector<uint64_t> pi(bounds_.size() + 1);
+  std::fill(pi.begin(), pi.end(), 0);
+
+  for (const auto& local : locals_)
+    for (std::size_t i = 0; i < bounds_.size(); i++)
+      pi[i + 1] += local->counts[i];
+
+  for (std::size_t i = 0; i < bounds_.size(); i++)
+    pi[i + 1] += pi[i];
+
+  auto piBefore = [&](uint64_t n)
+  {
+    std::size_t i = std::lower_bound(bounds_.begin(), bounds_.end(), n) - bounds_.begin();
+    return pi[i];
+  };
+
+  for (std::size_t i = 0; i < size_; i++)
+  {
+    uint64_t start = starts_[i];
+    uint64_t stop = stops_[i];
+    counts[i] = 0;
+
+    if (start > stop)
+      continue;
+
+    for (uint64_t prime : { 2, 3, 5 })
+      counts[i] += (start <= prime && prime <= stop);
+
+    if (stop >= 7)
+    {
+      start = std::max<uint64_t>(start, 7);
+      uint64_t end = (stop < std::numeric_limits<uint64_t>::max()) ? piBefore(stop + 1) : pi.back();
+      counts[i] += end - piBefore(start);
+    }
+  }
+}
+
+} // namespace
@@ -0,0 +1,77 @@
+///
+/// @file   IntervalCounter.hpp
+/// @brief  Count the primes inside many intervals using a single
+///         sieving pass. The interval boundaries split the covering
+///         range into pieces, the primes of each piece are counted
+///         directly in the sieve arrays of the sieved segments.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef INTERVALCOUNTER_HPP
+#define INTERVALCOUNTER_HPP
+
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace primesieve {
+
+/// The segments can be added by multiple threads
+/// simultaneously in any order. Each thread counts the
+/// primes of its segments in its own Local object.
+///
+class IntervalCounter
+{
+public:
+  struct Range
+  {
+    uint64_t start;
+    uint64_t stop;
+  };
+
+  /// The counts of a thread, the same Local object
+  /// is used for all segments of the thread.
+  struct Local
+  {
+    IntervalCounter* counter;
+    /// Number of primes >= 7 of each piece
+    Vector<uint64_t> counts;
+  };
+
+  IntervalCounter(const uint64_t* starts,
+                  const uint64_t* stops,
+                  std::size_t size);
+
+  const Vector<Range>& getRanges() const;
+  Local* addThread();
+  void finishRange();
+  void addSegment(Local& local, uint64_t low, const uint64_t* sieve, std::size_t size);
+  void getCounts(uint64_t* counts) const;
+
+private:
+  const uint64_t* starts_;
+  const uint64_t* stops_;
+  std::size_t size_;
+  /// The sorted intervals merged into disjoint ranges
+  Vector<Range> ranges_;
+  /// Sorted start numbers of the pieces, the numbers
+  /// of piece i are [bounds_[i], bounds_[i + 1][.
+  Vector<uint64_t> bounds_;
+  /// The Local objects are reused for all ranges
+  std::vector<std::unique_ptr<Local>> locals_;
+  /// Number of Local objects used by the current range
+  std::size_t threads_ = 0;
+  std::mutex mutex_;
+};
+
+} // namespace
+
+#endif
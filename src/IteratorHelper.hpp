@@ -1,7 +1,7 @@
 ///
 /// @file   IteratorHelper.hpp
 ///
-/// Copyright (C) 2025 Kim Walisch, <kim.walisch@gmail.com>
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
 ///
 /// This file is distributed under the BSD License. See the COPYING
 /// file in the top level directory.
@@ -10,11 +10,17 @@
 #ifndef ITERATOR_HELPER_HPP
 #define ITERATOR_HELPER_HPP
 
+#include "IteratorPrefetcher.hpp"
 #include "PrimeGenerator.hpp"
+#include <primesieve/config.hpp>
 #include <primesieve/macros.hpp>
+#include <primesieve/pmath.hpp>
 #include <primesieve/Vector.hpp>
 
 #include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 
 namespace primesieve {
 
@@ -28,6 +34,10 @@ struct IteratorData
 
   ~IteratorData()
   {
+    // The prefetcher's helper thread uses the
+    // primeGenerator, hence it must be stopped first.
+    prefetcher.reset();
+
     if (primeGenerator)
       primeGenerator->~PrimeGenerator();
   }
@@ -41,6 +51,47 @@ struct IteratorData
     }
   }
 
+  /// Stop the prefetcher's helper thread and copy the user's
+  /// current primes into our primes vector. Afterwards the
+  /// iterator continues from the current primes as if the
+  /// prefetcher had never been used.
+  ///
+  void deletePrefetcher(uint64_t*& userPrimes,
+                        std::size_t size)
+  {
+    if (prefetcher)
+    {
+      // The user's primes are stored in the prefetcher's
+      // buffer which is not used by the helper thread.
+      bool isCopy = userPrimes && size > 0;
+
+      if (isCopy)
+      {
+        primes.resize(size);
+        std::copy_n(userPrimes, size, primes.data());
+        userPrimes = primes.data();
+      }
+
+      prefetcher.reset();
+      deletePrimeGenerator();
+
+      if (isCopy)
+      {
+        stop = primes.back();
+        include_start_number = false;
+      }
+    }
+  }
+
+  /// fillNextPrimes() requires space for 64 more primes,
+  /// the largest block uses MAX_CACHE_ITERATOR bytes.
+  void setBlockSize(std::size_t size)
+  {
+    std::size_t minSize = 1 << 7;
+    std::size_t maxSize = config::MAX_CACHE_ITERATOR / sizeof(uint64_t);
+    blockSize = inBetween(minSize, size, maxSize);
+  }
+
   void deletePrimes()
   {
     primes.deallocate();
@@ -53,13 +104,19 @@ struct IteratorData
     // into an existing buffer. This way we don't
     // need to allocate any new memory.
     ASSERT(primeGenerator == nullptr);
-    primeGenerator = new (primeGeneratorBuffer) PrimeGenerator(start, stop);
+    primeGenerator = new (primeGeneratorBuffer) PrimeGenerator(start, stop, blockSize);
   }
 
   uint64_t stop;
   uint64_t dist = 0;
   bool include_start_number = true;
+  bool isPrefetch = false;
+  /// Max number of primes generated by generate_next_primes().
+  /// A buffer of 1024 primes provides good performance
+  /// with little memory usage.
+  std::size_t blockSize = 1 << 10;
   PrimeGenerator* primeGenerator = nullptr;
+  std::unique_ptr<IteratorPrefetcher> prefetcher;
   Vector<uint64_t> primes;
   alignas(PrimeGenerator) char primeGeneratorBuffer[sizeof(PrimeGenerator)];
 };
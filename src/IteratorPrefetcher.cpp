@@ -0,0 +1,160 @@
+///
+/// @file   IteratorPrefetcher.cpp
+/// @brief  Generates the next primes of primesieve::iterator
+///         in a helper thread while the user processes the
+///         current primes. This is enabled using
+///         iterator::enable_prefetch() and is useful if the
+///         user does a significant amount of work per prime.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "IteratorPrefetcher.hpp"
+#include "IteratorHelper.hpp"
+#include "PrimeGenerator.hpp"
+
+#include <primesieve/macros.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace primesieve {
+
+/// The helper thread immediately
+/// starts filling the 1st buffer.
+///
+IteratorPrefetcher::IteratorPrefetcher(IteratorData& iterData,
+                                       uint64_t start,
+                                       uint64_t stopHint) :
+  iterData_(iterData),
+  start_(start),
+  stopHint_(stopHint)
+{
+  // If prefetching has been enabled after next_prime() has
+  // been used, the PrimeGenerator has already been initialized
+  // and it will not resize our buffers.
+  if (iterData_.primeGenerator)
+    buffers_[0].resize(iterData_.primes.size());
+
+  thread_ = std::thread(&IteratorPrefetcher::prefetch, this);
+}
+
+IteratorPrefetcher::~IteratorPrefetcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    isStop_ = true;
+  }
+
+  cond_.notify_all();
+  thread_.join();
+}
+
+/// Returns the buffer filled by the helper thread (waits if the
+/// buffer is not ready yet) and requests the helper thread to
+/// fill the other buffer. The user must not access the previous
+/// buffer anymore after calling next().
+///
+uint64_t* IteratorPrefetcher::next(std::size_t* size)
+{
+  std::size_t idx;
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [&]() { return isReady_ || error_; });
+
+    if (error_)
+      std::rethrow_exception(error_);
+
+    idx = fillIdx_;
+    fillIdx_ = 1 - idx;
+    isReady_ = false;
+    isRequested_ = true;
+  }
+
+  cond_.notify_all();
+  *size = sizes_[idx];
+  return buffers_[idx].data();
+}
+
+/// Helper thread
+void IteratorPrefetcher::prefetch()
+{
+  while (true)
+  {
+    std::size_t idx;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [&]() { return isStop_ || isRequested_; });
+
+      if (isStop_)
+        return;
+
+      idx = fillIdx_;
+      isRequested_ = false;
+    }
+
+    try
+    {
+      std::size_t size = 0;
+      fill(buffers_[idx], &size);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sizes_[idx] = size;
+        isReady_ = true;
+      }
+    }
+    catch (...)
+    {
+      // The exception is rethrown by next()
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = std::current_exception();
+    }
+
+    cond_.notify_all();
+  }
+}
+
+/// Same algorithm as iterator::generate_next_primes()
+void IteratorPrefetcher::fill(Vector<uint64_t>& primes,
+                              std::size_t* size)
+{
+  while (true)
+  {
+    if (!iterData_.primeGenerator)
+    {
+      IteratorHelper::updateNext(start_, stopHint_, iterData_);
+      iterData_.newPrimeGenerator(start_, iterData_.stop);
+    }
+
+    // The PrimeGenerator only resizes the buffer it
+    // has been initialized with, hence both buffers
+    // must have the same size. Only the helper thread
+    // resizes the buffers, so this is thread safe.
+    std::size_t maxSize = std::max(buffers_[0].size(), buffers_[1].size());
+    if (primes.size() < maxSize)
+    {
+      primes.clear();
+      primes.resize(maxSize);
+    }
+
+    iterData_.primeGenerator->fillNextPrimes(primes, size);
+
+    if_unlikely(*size == 0)
+      iterData_.deletePrimeGenerator();
+    else
+      return;
+  }
+}
+
+} // namespace
@@ -0,0 +1,68 @@
+///
+/// @file   IteratorPrefetcher.hpp
+/// @brief  Generates the next primes of primesieve::iterator
+///         in a helper thread while the user processes the
+///         current primes.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef ITERATOR_PREFETCHER_HPP
+#define ITERATOR_PREFETCHER_HPP
+
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace primesieve {
+
+struct IteratorData;
+
+/// Uses 2 buffers: the user iterates over the primes of one
+/// buffer while the helper thread fills the other buffer. The
+/// buffers are swapped in next() which is only called by
+/// generate_next_primes(), i.e. once per ~ 2^10 primes. Hence
+/// next_prime() is not slowed down by any synchronization.
+///
+class IteratorPrefetcher
+{
+public:
+  IteratorPrefetcher(IteratorData& iterData,
+                     uint64_t start,
+                     uint64_t stopHint);
+  ~IteratorPrefetcher();
+  uint64_t* next(std::size_t* size);
+
+private:
+  void prefetch();
+  void fill(Vector<uint64_t>& primes, std::size_t* size);
+
+  /// The helper thread exclusively uses the
+  /// iterData_'s PrimeGenerator while prefetching.
+  IteratorData& iterData_;
+  uint64_t start_;
+  uint64_t stopHint_;
+  Vector<uint64_t> buffers_[2];
+  std::size_t sizes_[2] = { 0, 0 };
+  /// Buffer that is filled by the helper thread
+  std::size_t fillIdx_ = 0;
+  bool isRequested_ = true;
+  bool isReady_ = false;
+  bool isStop_ = false;
+  std::exception_ptr error_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::thread thread_;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,145 @@
+///
+/// @file   MappedFile.cpp
+/// @brief  Read-only memory mapped file. On POSIX systems we use
+///         mmap() and on Windows MapViewOfFile(). The pages of
+///         the file are loaded lazily by the operating system
+///         and shared by all processes that map the same file.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "MappedFile.hpp"
+
+#include <primesieve/primesieve_error.hpp>
+
+#include <stdint.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if defined(_WIN32)
+  #if !defined(NOMINMAX)
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <sys/types.h>
+  #include <unistd.h>
+#endif
+
+namespace primesieve {
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::string& filename) :
+  filename_(filename)
+{
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (file == INVALID_HANDLE_VALUE)
+    throw primesieve_error("failed to open " + filename_);
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size))
+  {
+    CloseHandle(file);
+    throw primesieve_error("failed to get size of " + filename_);
+  }
+
+  file_ = (void*) file;
+  size_ = (std::size_t) size.QuadPart;
+
+  // Mapping an empty file fails
+  if (size_ == 0)
+    return;
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  const void* data = nullptr;
+
+  if (mapping)
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+  if (!data)
+  {
+    if (mapping)
+      CloseHandle(mapping);
+    CloseHandle(file);
+    throw primesieve_error("failed to map " + filename_);
+  }
+
+  mapping_ = (void*) mapping;
+  data_ = (const uint8_t*) data;
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_)
+    UnmapViewOfFile(data_);
+  if (mapping_)
+    CloseHandle((HANDLE) mapping_);
+  CloseHandle((HANDLE) file_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filename) :
+  filename_(filename)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+
+  if (fd == -1)
+    throw primesieve_error("failed to open " + filename_ + ": " + std::strerror(errno));
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+  {
+    int err = errno;
+    ::close(fd);
+    throw primesieve_error("failed to get size of " + filename_ + ": " + std::strerror(err));
+  }
+
+  if ((uint64_t) st.st_size > std::numeric_limits<std::size_t>::max())
+  {
+    ::close(fd);
+    throw primesieve_error("file too large: " + filename_);
+  }
+
+  size_ = (std::size_t) st.st_size;
+
+  // Mapping an empty file fails
+  if (size_ > 0)
+  {
+    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+
+    if (data == MAP_FAILED)
+    {
+      int err = errno;
+      ::close(fd);
+      throw primesieve_error("failed to map " + filename_ + ": " + std::strerror(err));
+    }
+
+    data_ = (const uint8_t*) data;
+  }
+
+  // The mapping remains valid after closing the file
+  ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_)
+    ::munmap((void*) data_, size_);
+}
+
+#endif
+
+} // namespace
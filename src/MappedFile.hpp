@@ -0,0 +1,45 @@
+///
+/// @file   MappedFile.hpp
+/// @brief  Read-only memory mapped file.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+
+namespace primesieve {
+
+class MappedFile
+{
+public:
+  /// Maps the whole file into memory
+  MappedFile(const std::string& filename);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const uint8_t* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  const std::string& filename() const { return filename_; }
+
+private:
+  std::string filename_;
+  const uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+#if defined(_WIN32)
+  void* file_ = nullptr;
+  void* mapping_ = nullptr;
+#endif
+};
+
+} // namespace
+
+#endif
@@ -143,4 +143,34 @@ void MemoryPool::freeBucket(Bucket* bucket)
   stock_ = bucket;
 }
 
+/// Put all buckets back into the stock without freeing
+/// any memory. This must only be called once the sieving
+/// primes of all users of the MemoryPool are discarded.
+///
+void MemoryPool::reset()
+{
+  stock_ = nullptr;
+
+  for (auto& memory : memory_)
+  {
+    void* ptr = (void*) memory.data();
+    std::size_t bytes = memory.size();
+
+    if_unlikely(!std::align(sizeof(Bucket), sizeof(Bucket), ptr, bytes))
+      throw primesieve_error("MemoryPool: failed to align memory!");
+
+    Bucket* buckets = (Bucket*) ptr;
+    std::size_t count = bytes / sizeof(Bucket);
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+      buckets[i].reset();
+      buckets[i].setNext((i + 1 < count) ? &buckets[i + 1] : stock_);
+    }
+
+    if (count > 0)
+      stock_ = buckets;
+  }
+}
+
 } // namespace
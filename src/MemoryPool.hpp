@@ -23,6 +23,7 @@ class MemoryPool
 public:
   NOINLINE void addBucket(SievingPrime*& sievingPrime);
   void freeBucket(Bucket* bucket);
+  void reset();
 
 private:
   void updateAllocCount();
@@ -0,0 +1,202 @@
+///
+/// @file   NumaInfo.cpp
+/// @brief  Get the CPU cores of each NUMA node. On servers with
+///         multiple CPU sockets ParallelSieve pins its threads to
+///         the NUMA nodes in round-robin order. Since each thread
+///         allocates and initializes (first touch) its own sieve
+///         array and MemoryPool buckets, the Linux kernel then
+///         allocates this memory on the thread's local NUMA node.
+///         Near 10^19 each thread uses more than 1 GiB of memory,
+///         accessing that memory on a remote node is slow.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "NumaInfo.hpp"
+
+#include <primesieve/macros.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#if defined(__linux__) && \
+    __has_include(<sched.h>)
+  #include <sched.h>
+  #define LINUX_AFFINITY
+#endif
+
+namespace {
+
+/// A list file contains a human readable
+/// list of CPU IDs or NUMA node IDs.
+/// Example: 0-8,18-26
+///
+primesieve::Vector<int> parseList(const std::string& filename)
+{
+  primesieve::Vector<int> ids;
+  std::ifstream file(filename);
+  std::string list;
+
+  if (!file || !(file >> list))
+    return ids;
+
+  std::string token;
+  std::istringstream tokenStream(list);
+
+  while (std::getline(tokenStream, token, ','))
+  {
+    std::size_t pos = token.find('-');
+    int first = std::stoi(token.substr(0, pos));
+    int last = first;
+
+    if (pos != std::string::npos)
+      last = std::stoi(token.substr(pos + 1));
+
+    for (int id = first; id <= last; id++)
+      ids.push_back(id);
+  }
+
+  return ids;
+}
+
+#if defined(LINUX_AFFINITY)
+
+/// Remove the CPU cores that are not in the process's
+/// CPU affinity mask (e.g. when using taskset).
+///
+void removeDisallowed(primesieve::Vector<int>& cpus)
+{
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+
+  if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+    return;
+
+  primesieve::Vector<int> allowed;
+
+  for (int cpu : cpus)
+    if (cpu >= CPU_SETSIZE || CPU_ISSET(cpu, &cpuSet))
+      allowed.push_back(cpu);
+
+  cpus = std::move(allowed);
+}
+
+#endif
+
+} // namespace
+
+namespace primesieve {
+
+/// The NUMA nodes are read on first use, i.e. when the
+/// ThreadPool starts its first thread, not during static
+/// initialization of the library. The pool's threads only
+/// use this object when they start.
+///
+const NumaInfo& NumaInfo::get()
+{
+  static const NumaInfo numaInfo;
+  return numaInfo;
+}
+
+NumaInfo::NumaInfo()
+{
+  init("/sys/devices/system/node", true);
+}
+
+/// Used for testing, read the NUMA nodes
+/// from a copy of /sys/devices/system/node.
+///
+NumaInfo::NumaInfo(const std::string& path)
+{
+  init(path, false);
+}
+
+void NumaInfo::init(const std::string& path,
+                    MAYBE_UNUSED bool isAffinity)
+{
+  try
+  {
+    // The node IDs may not be contiguous
+    Vector<int> nodes = parseList(path + "/online");
+
+    for (int node : nodes)
+    {
+      std::string cpuList = path + "/node" + std::to_string(node) + "/cpulist";
+      Vector<int> cpus = parseList(cpuList);
+
+#if defined(LINUX_AFFINITY)
+      if (isAffinity)
+        removeDisallowed(cpus);
+#endif
+
+      if (!cpus.empty())
+        cpus_.push_back(std::move(cpus));
+    }
+  }
+  catch (const std::exception&)
+  {
+    cpus_.clear();
+  }
+
+  if (cpus_.empty())
+    cpus_.emplace_back();
+}
+
+std::size_t NumaInfo::nodes() const
+{
+  return cpus_.size();
+}
+
+/// The threads are distributed to the
+/// NUMA nodes in round-robin order.
+///
+std::size_t NumaInfo::getNode(std::size_t threadId) const
+{
+  return threadId % cpus_.size();
+}
+
+const Vector<int>& NumaInfo::cpus(std::size_t node) const
+{
+  ASSERT(node < cpus_.size());
+  return cpus_[node];
+}
+
+/// Restrict the calling thread to the CPU
+/// cores of the NUMA node. Returns true
+/// on success.
+///
+bool NumaInfo::pinThread(MAYBE_UNUSED std::size_t node) const
+{
+#if defined(LINUX_AFFINITY)
+  const Vector<int>& cpus = this->cpus(node);
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  int count = 0;
+
+  for (int cpu : cpus)
+  {
+    if (cpu < CPU_SETSIZE)
+    {
+      CPU_SET(cpu, &cpuSet);
+      count++;
+    }
+  }
+
+  // pid = 0 is the calling thread
+  return count > 0 &&
+         sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
+
+} // namespace
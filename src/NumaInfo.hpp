@@ -0,0 +1,44 @@
+///
+/// @file   NumaInfo.hpp
+/// @brief  Get the CPU cores of each NUMA node.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef NUMAINFO_HPP
+#define NUMAINFO_HPP
+
+#include <primesieve/Vector.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace primesieve {
+
+/// On Linux the NUMA nodes are read from /sys/devices/system/node.
+/// NUMA nodes without CPU cores (memory only nodes) are ignored.
+/// If the NUMA topology is unknown (e.g. on other operating
+/// systems) there is a single node without any CPU cores.
+///
+class NumaInfo
+{
+public:
+  static const NumaInfo& get();
+  NumaInfo();
+  NumaInfo(const std::string& path);
+  std::size_t nodes() const;
+  std::size_t getNode(std::size_t threadId) const;
+  const Vector<int>& cpus(std::size_t node) const;
+  bool pinThread(std::size_t node) const;
+
+private:
+  void init(const std::string& path, bool isAffinity);
+  Vector<Vector<int>> cpus_;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,142 @@
+///
+/// @file   OrderedPipeline.hpp
+/// @brief  Process chunks in parallel and consume their results
+///         strictly in ascending chunk order. Used for printing
+///         primes and for for_each_prime() with ORDERED.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef ORDEREDPIPELINE_HPP
+#define ORDEREDPIPELINE_HPP
+
+#include "ThreadPool.hpp"
+
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace primesieve {
+
+/// The threads call produce(i, buffer) for the chunks
+/// i = 0 ... iters - 1 in ascending order, each chunk uses
+/// the buffer buffers[i % buffers.size()]. The calling thread
+/// calls consume(buffer) for the chunks strictly in ascending
+/// order. A thread may only start producing chunk i once chunk
+/// i - buffers.size() has been consumed, this bounds the memory
+/// usage. If produce() or consume() throws an exception, all
+/// threads stop after their current chunk and the exception
+/// is rethrown.
+///
+template <typename T, typename Produce, typename Consume>
+void orderedPipeline(int threads,
+                     uint64_t iters,
+                     Vector<T>& buffers,
+                     Produce&& produce,
+                     Consume&& consume)
+{
+  std::size_t maxBuffers = buffers.size();
+  Vector<char> isReady(maxBuffers);
+  std::fill(isReady.begin(), isReady.end(), 0);
+  std::mutex mutex;
+  std::condition_variable cond;
+  uint64_t consumed = 0;
+  uint64_t next = 0;
+  bool abort = false;
+
+  auto stopAll = [&]()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      abort = true;
+    }
+
+    cond.notify_all();
+  };
+
+  // Each thread executes 1 task
+  auto task = [&]()
+  {
+    try
+    {
+      while (true)
+      {
+        uint64_t i;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          i = next++;
+          if (i >= iters)
+            break;
+          cond.wait(lock, [&]() { return abort || i < consumed + maxBuffers; });
+          if (abort)
+            break;
+        }
+
+        produce(i, buffers[i % maxBuffers]);
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          isReady[i % maxBuffers] = true;
+        }
+
+        cond.notify_all();
+      }
+    }
+    catch (...)
+    {
+      stopAll();
+      throw;
+    }
+  };
+
+  auto futures = submitTasks(threads, task);
+
+  try
+  {
+    for (uint64_t i = 0; i < iters; i++)
+    {
+      std::size_t j = i % maxBuffers;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&]() { return abort || isReady[j]; });
+        if (abort)
+          break;
+      }
+
+      // The buffer is not modified by the threads
+      // until it has been marked as consumed.
+      consume(buffers[j]);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        isReady[j] = false;
+        consumed++;
+      }
+
+      cond.notify_all();
+    }
+  }
+  catch (...)
+  {
+    stopAll();
+    waitAll(futures);
+    throw;
+  }
+
+  waitAll(futures);
+
+  for (auto& f : futures)
+    f.get();
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,124 @@
+///
+/// @file   OutputFile.cpp
+/// @brief  File used by primesieve --print --output=FILE. On POSIX
+///         systems we use pwrite() and on Windows WriteFile() with
+///         an OVERLAPPED offset, both write at an explicit file
+///         offset without modifying a shared file position. Hence
+///         multiple threads can write to the same file at once.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "OutputFile.hpp"
+
+#include <primesieve/primesieve_error.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#if defined(_WIN32)
+  #if !defined(NOMINMAX)
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/types.h>
+  #include <unistd.h>
+#endif
+
+namespace primesieve {
+
+#if defined(_WIN32)
+
+OutputFile::OutputFile(const std::string& filename) :
+  filename_(filename)
+{
+  HANDLE handle = CreateFileA(filename.c_str(), GENERIC_WRITE, 0, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (handle == INVALID_HANDLE_VALUE)
+    throw primesieve_error("failed to open " + filename_);
+
+  handle_ = (void*) handle;
+}
+
+OutputFile::~OutputFile()
+{
+  CloseHandle((HANDLE) handle_);
+}
+
+void OutputFile::write(const char* data,
+                       std::size_t size,
+                       uint64_t offset)
+{
+  while (size > 0)
+  {
+    // The size of a WriteFile() call is a DWORD
+    DWORD bytes = (DWORD) std::min(size, (std::size_t) (1u << 30));
+    DWORD written = 0;
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = (DWORD) offset;
+    overlapped.OffsetHigh = (DWORD) (offset >> 32);
+
+    if (!WriteFile((HANDLE) handle_, data, bytes, &written, &overlapped) ||
+        written == 0)
+      throw primesieve_error("failed to write to " + filename_);
+
+    data += written;
+    size -= written;
+    offset += written;
+  }
+}
+
+#else
+
+OutputFile::OutputFile(const std::string& filename) :
+  filename_(filename)
+{
+  fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+  if (fd_ == -1)
+    throw primesieve_error("failed to open " + filename_ + ": " + std::strerror(errno));
+}
+
+OutputFile::~OutputFile()
+{
+  ::close(fd_);
+}
+
+void OutputFile::write(const char* data,
+                       std::size_t size,
+                       uint64_t offset)
+{
+  while (size > 0)
+  {
+    ssize_t written = ::pwrite(fd_, data, size, (off_t) offset);
+
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      throw primesieve_error("failed to write to " + filename_ + ": " + std::strerror(errno));
+
+    data += written;
+    size -= (std::size_t) written;
+    offset += (uint64_t) written;
+  }
+}
+
+#endif
+
+void OutputFile::write(const char* data, std::size_t size)
+{
+  write(data, size, offset_);
+  offset_ += size;
+}
+
+} // namespace
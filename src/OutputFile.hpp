@@ -0,0 +1,49 @@
+///
+/// @file   OutputFile.hpp
+/// @brief  File used by primesieve --print --output=FILE. Supports
+///         writing at explicit offsets which allows multiple
+///         threads to write their chunks of primes simultaneously.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef OUTPUTFILE_HPP
+#define OUTPUTFILE_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+
+namespace primesieve {
+
+class OutputFile
+{
+public:
+  /// Creates or truncates the file
+  OutputFile(const std::string& filename);
+  ~OutputFile();
+  OutputFile(const OutputFile&) = delete;
+  OutputFile& operator=(const OutputFile&) = delete;
+
+  /// Append data to the end of the previous sequential write
+  void write(const char* data, std::size_t size);
+  /// Write data at the given file offset, thread safe
+  void write(const char* data, std::size_t size, uint64_t offset);
+
+private:
+  std::string filename_;
+  /// Offset of the next sequential write
+  uint64_t offset_ = 0;
+#if defined(_WIN32)
+  void* handle_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+};
+
+} // namespace
+
+#endif
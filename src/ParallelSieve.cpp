@@ -1,6 +1,6 @@
 ///
 /// @file   ParallelSieve.cpp
-/// @brief  Multi-threaded prime sieve using std::async.
+/// @brief  Multi-threaded prime sieve using a thread pool.
 ///
 /// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
 ///
@@ -9,20 +9,42 @@
 ///
 
 #include "ParallelSieve.hpp"
+#include "ChunkScheduler.hpp"
+#include "CountPrintPrimes.hpp"
+#include "GapCounter.hpp"
+#include "IntervalCounter.hpp"
+#include "OrderedPipeline.hpp"
+#include "OutputFile.hpp"
+#include "PrimeAtlas.hpp"
+#include "PrimeGenerator.hpp"
+#include "PrimePi.hpp"
 #include "PrimeSieveClass.hpp"
+#include "PrintFormat.hpp"
+#include "ResidueCounter.hpp"
+#include "SegmentSieve.hpp"
+#include "SharedSievingPrimes.hpp"
+#include "ThreadPool.hpp"
 
 #include <primesieve/config.hpp>
 #include <primesieve/forward.hpp>
+#include <primesieve/iterator.hpp>
 #include <primesieve/macros.hpp>
 #include <primesieve/pmath.hpp>
+#include <primesieve/primesieve_error.hpp>
 #include <primesieve/Vector.hpp>
 
 #include <stdint.h>
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <future>
+#include <iostream>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <string>
 
 using std::size_t;
 using namespace primesieve;
@@ -36,28 +58,124 @@ counts_t& operator+=(counts_t& v1, const counts_t& v2)
   return v1;
 }
 
+/// Store the n primes inside [start, stop]
 template <typename T>
-class RelaxedAtomic
+void storeChunk(uint64_t start,
+                uint64_t stop,
+                uint64_t n,
+                T* primes)
 {
-public:
-  RelaxedAtomic(T n) : atomic_(n) { }
-  // Postfix Increment
-  T operator++(int)
+  primesieve::iterator it(start, stop);
+  uint64_t i = 0;
+
+  // We know the exact number of primes inside [start, stop],
+  // hence we never generate primes > stop. This is important
+  // as primesieve::iterator throws an exception if one tries
+  // to generate primes > 2^64.
+  while (i < n)
+  {
+    it.generate_next_primes();
+    std::size_t size = (std::size_t) std::min((uint64_t) it.size_, n - i);
+
+    for (std::size_t j = 0; j < size; j++)
+      primes[i + j] = (T) it.primes_[j];
+
+    i += size;
+  }
+}
+
+/// Store the n primes inside [start, stop] using 32-bit primes,
+/// the primes are generated directly as uint32_t without
+/// narrowing each prime from uint64_t.
+/// @pre stop < 2^32
+///
+void storeChunk(uint64_t start,
+                uint64_t stop,
+                uint64_t n,
+                uint32_t* primes)
+{
+  // A buffer of 4096 primes fits into the L1 cache
+  PrimeGenerator primeGenerator(start, stop, 1 << 12);
+  Vector<uint32_t> buffer;
+  uint64_t i = 0;
+
+  while (i < n)
+  {
+    std::size_t size;
+    primeGenerator.fillNextPrimes(buffer, &size);
+    ASSERT(size > 0);
+    size = (std::size_t) std::min((uint64_t) size, n - i);
+    std::copy_n(buffer.data(), size, &primes[i]);
+    i += size;
+  }
+}
+
+/// Number of bytes of the primes inside [start, stop] printed
+/// using the given format. For the TEXT_FORMAT the primes
+/// are counted separately for each number of digits.
+///
+uint64_t getPrintBytes(PrimeSieve& ps,
+                       uint64_t start,
+                       uint64_t stop,
+                       int format)
+{
+  if (format == UINT32_FORMAT)
+    return ps.countPrimes(start, stop) * 4;
+  if (format == UINT64_FORMAT)
+    return ps.countPrimes(start, stop) * 8;
+
+  ASSERT(format == TEXT_FORMAT);
+  uint64_t bytes = 0;
+  uint64_t pow10 = 10;
+
+  // Each prime is followed by '\n'
+  for (uint64_t digits = 1; start <= stop; digits++)
+  {
+    uint64_t high = stop;
+    if (digits < 20)
+      high = std::min(stop, pow10 - 1);
+    if (start <= high)
+      bytes += ps.countPrimes(start, high) * (digits + 1);
+    if (high == stop)
+      break;
+
+    start = std::max(start, pow10);
+    pow10 *= 10;
+  }
+
+  return bytes;
+}
+
+/// Call f(primes, size) for each block of primes inside
+/// [start, stop] in ascending order, stops if f() returns false.
+///
+template <typename F>
+void forEachBlock(uint64_t start, uint64_t stop, F&& f)
+{
+  // PrimeGenerator throws an exception if stop = 2^64-1 as the
+  // next prime would be > 2^64. 2^64-1 and 2^64-2 are not prime.
+  stop = std::min(stop, std::numeric_limits<uint64_t>::max() - 1);
+
+  // A buffer of 1024 primes fits into the L1 cache
+  PrimeGenerator primeGenerator(start, stop, 1 << 10);
+  Vector<uint64_t> primes;
+  std::size_t size;
+
+  while (true)
   {
-    return atomic_.fetch_add(1, std::memory_order_relaxed);
+    primeGenerator.fillNextPrimes(primes, &size);
+    if (size == 0 || !f(primes.data(), size))
+      break;
   }
-private:
-  // Use padding to avoid CPU false sharing
-  MAYBE_UNUSED char pad1[config::MAX_CACHE_LINE_SIZE];
-  std::atomic<T> atomic_;
-  MAYBE_UNUSED char pad2[config::MAX_CACHE_LINE_SIZE];
-};
+}
 
 } // namespace
 
 namespace primesieve {
 
-ParallelSieve::ParallelSieve()
+ParallelSieve::ParallelSieve() :
+  countIndex_(PrimeCountIndex::get()),
+  atlas_(PrimeAtlas::get())
 {
   int threads = get_num_threads();
   setNumThreads(threads);
@@ -79,6 +197,28 @@ void ParallelSieve::setNumThreads(int threads)
   numThreads_ = inBetween(1, threads, getMaxThreads());
 }
 
+/// Enable or disable counting primes using LMO, used for testing
+void ParallelSieve::setLMO(bool enable)
+{
+  isLMO_ = enable;
+}
+
+/// Print primes to this file instead of stdout
+void ParallelSieve::setOutputFilename(const std::string& filename)
+{
+  outputFilename_ = filename;
+}
+
+/// Idle time in seconds of each thread of the last multi-threaded
+/// count, i.e. the time during which the thread had no more work
+/// while other threads were still sieving. Empty if the last
+/// sieve() call did not count in parallel.
+///
+const Vector<double>& ParallelSieve::getIdleSeconds() const
+{
+  return idleSeconds_;
+}
+
 /// Get an ideal number of threads for
 /// the start and stop numbers.
 ///
@@ -87,6 +227,12 @@ int ParallelSieve::idealNumThreads() const
   if (start_ > stop_)
     return 1;
 
+  // Waiting for tasks submitted from a worker
+  // thread could deadlock the thread pool.
+  if (ThreadPool::isWorkerThread() ||
+      ThreadPool::isDestroyed())
+    return 1;
+
   uint64_t threshold = isqrt(stop_) / 5;
   threshold = std::max(threshold, config::MIN_THREAD_DISTANCE);
   uint64_t threads = getDistance() / threshold;
@@ -119,6 +265,41 @@ uint64_t ParallelSieve::getThreadDistance(int threads) const
   return threadDist;
 }
 
+/// Printing requires a buffer for each chunk, hence we
+/// use smaller chunks than for counting primes in order
+/// to limit the memory usage.
+///
+uint64_t ParallelSieve::getPrintDistance(int threads) const
+{
+  // Approximate number of chars per number of the
+  // print buffer: log10(stop) + 2 chars per prime
+  // and 1 / log(stop) primes per number.
+  double x = (double) std::max(stop_, (uint64_t) 10);
+  double charsPerNumber = (std::log10(x) + 2) / std::log(x);
+
+  return getBufferDistance(threads, charsPerNumber);
+}
+
+/// Get a chunk distance so that the buffer of each
+/// chunk uses about PRINT_BUFFER_BYTES bytes.
+/// @bytesPerNumber: Approximate buffer bytes per number.
+///
+uint64_t ParallelSieve::getBufferDistance(int threads,
+                                          double bytesPerNumber) const
+{
+  uint64_t threadDist = getThreadDistance(threads);
+  uint64_t dist = (uint64_t) (config::PRINT_BUFFER_BYTES / bytesPerNumber);
+
+  // Each chunk requires generating the sieving primes
+  // <= sqrt(stop), this initialization overhead
+  // should not dominate the total run time.
+  dist = std::max(dist, isqrt(stop_));
+  dist = std::max(dist, config::MIN_THREAD_DISTANCE);
+  dist += 30 - dist % 30;
+
+  return std::min(dist, threadDist);
+}
+
 /// (n % 30) == 2 ensures that prime k-tuplets
 /// cannot be split at thread boundaries.
 ///
@@ -132,6 +313,55 @@ uint64_t ParallelSieve::align(uint64_t n) const
     return n32 - n % 30;
 }
 
+/// Get the bounds [start, stop] of the ith chunk
+/// of size threadDist of the interval [start_, stop_].
+///
+void ParallelSieve::getChunk(uint64_t i,
+                             uint64_t threadDist,
+                             uint64_t* start,
+                             uint64_t* stop) const
+{
+  uint64_t low = start_ + threadDist * i;
+  uint64_t high = checkedAdd(low, threadDist);
+  *stop = align(high);
+
+  if (low > start_)
+    *start = align(low) + 1;
+  else
+    *start = low;
+}
+
+/// Generate the sieving primes <= sqrt(stop) in parallel, the
+/// threads then read the sieving primes from this shared array
+/// instead of regenerating them for each chunk. Returns false
+/// if sqrt(stop) is too small for this to be worthwhile. There
+/// is a single copy, not one per NUMA node. Its parts are first
+/// touched by the threads that fill them and are read
+/// sequentially (1 byte per prime).
+///
+bool ParallelSieve::initSievingPrimes(SharedSievingPrimes& sievingPrimes,
+                                      int threads)
+{
+  if (isqrt(stop_) < config::MIN_SHARED_SIEVING_PRIMES)
+    return false;
+
+  // Use more parts than threads as the
+  // primes are sparser in the last parts.
+  std::size_t parts = (std::size_t) threads * 4;
+  sievingPrimes.init(stop_, parts);
+  INDETERMINATE RelaxedAtomic<std::size_t> a(0);
+
+  auto task = [&]()
+  {
+    std::size_t i;
+    while ((i = a++) < parts)
+      sievingPrimes.fill(i);
+  };
+
+  runParallel(threads, task);
+  return true;
+}
+
 /// Print sieving status to stdout
 bool ParallelSieve::tryUpdateStatus(uint64_t dist)
 {
@@ -149,63 +379,1151 @@ bool ParallelSieve::tryUpdateStatus(uint64_t dist)
 void ParallelSieve::sieve()
 {
   reset();
+  idleSeconds_.clear();
+  // Left over if countHistogram() threw an exception
+  setHistogram(nullptr, 0, 0);
+  file_.reset();
+  setOutputFile(nullptr);
+
+  if (!outputFilename_.empty() && isPrint())
+  {
+    file_.reset(new OutputFile(outputFilename_));
+    setOutputFile(file_.get());
+  }
 
   if (start_ > stop_)
     return;
 
+  // The atlas, the index and LMO are only used if they
+  // are cheaper than the methods after them.
+  if (isCountPrimes() &&
+      !isCountkTuplets() &&
+      !isPrint())
+  {
+    if (atlas_ && countPrimesAtlas())
+      return;
+    if (countIndex_ && countPrimesIndex())
+      return;
+    if (countPrimesLMO())
+      return;
+  }
+
   int threads = idealNumThreads();
 
   if (threads == 1)
     PrimeSieve::sieve();
   else
   {
+    checkPrintFormat();
     setStatus(0);
     auto t1 = std::chrono::steady_clock::now();
+
+    // The byte size of each chunk can only be precomputed
+    // for primes, not for prime k-tuplets or prime gaps.
+    if (file_ &&
+        isPrintPrimes() &&
+        getPrintFormat() != GAPS_FORMAT)
+      writeParallel(threads);
+    else if (isPrint())
+      printParallel(threads);
+    else
+      countParallel(threads);
+
+    auto t2 = std::chrono::steady_clock::now();
+    std::chrono::duration<double> seconds = t2 - t1;
+    seconds_ = seconds.count();
+    setStatus(100);
+  }
+
+  // Close the file
+  setOutputFile(nullptr);
+  file_.reset();
+}
+
+/// Cost of counting the primes inside [start, stop] without
+/// the index and the atlas, in units of the cost of sieving a
+/// number. Sieving [start, stop] costs stop - start, LMO is
+/// used if it is enabled and cheaper.
+///
+double ParallelSieve::countCost(uint64_t start, uint64_t stop) const
+{
+  if (start > stop)
+    return 0;
+
+  double cost = (double) (stop - start);
+  if (isLMO_)
+    cost = std::min(cost, primePiLMOCost(start, stop));
+
+  return cost;
+}
+
+/// Cost of counting the primes inside [start, stop] using the
+/// index, see countPrimesIndex(). Returns infinity if no index
+/// has been loaded.
+///
+double ParallelSieve::indexCost(uint64_t start, uint64_t stop) const
+{
+  if (!countIndex_)
+    return std::numeric_limits<double>::infinity();
+
+  uint64_t x[2] = { start - 1, stop };
+  double cost = 0;
+
+  // pi(start - 1) = 0 for start = 0
+  for (int i = (start == 0); i < 2; i++)
+  {
+    uint64_t pi;
+    uint64_t checkpoint = countIndex_->nearest(x[i], &pi);
+    uint64_t low = std::min(x[i], checkpoint);
+    uint64_t high = std::max(x[i], checkpoint);
+    if (low < high)
+      cost += countCost(low + 1, high);
+  }
+
+  return cost;
+}
+
+/// Count the primes inside [start, stop] using the prime atlas,
+/// the primes > atlas limit are counted using the cheapest of
+/// the index, LMO and sieving. Counting the primes <= atlas
+/// limit is nearly free, hence the atlas is used if counting
+/// the primes > atlas limit is not more expensive than counting
+/// [start, stop] without the atlas. Returns false if
+/// start > atlas limit or if it is cheaper not to use the atlas.
+///
+bool ParallelSieve::countPrimesAtlas()
+{
+  ASSERT(atlas_);
+  uint64_t limit = atlas_->getLimit();
+
+  if (start_ > limit)
+    return false;
+
+  if (stop_ > limit)
+  {
+    double cost = std::min(countCost(limit + 1, stop_), indexCost(limit + 1, stop_));
+    double noAtlasCost = std::min(countCost(start_, stop_), indexCost(start_, stop_));
+    if (cost > noAtlasCost)
+      return false;
+  }
+
+  setStatus(0);
+  auto t1 = std::chrono::steady_clock::now();
+  counts_[0] = atlas_->countPrimes(start_, std::min(stop_, limit));
+
+  if (stop_ > limit)
+  {
+    // Uses the index or LMO if they are cheaper than sieving
+    INDETERMINATE ParallelSieve ps;
+    ps.atlas_.reset();
+    ps.isLMO_ = isLMO_;
+    ps.setNumThreads(numThreads_);
+    ps.setSieveSize(getSieveSize());
+    counts_[0] += ps.countPrimes(limit + 1, stop_);
+  }
+
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+  setStatus(100);
+
+  return true;
+}
+
+/// Find the nth prime > start (or < start if n < 0) using the
+/// prime atlas if it contains the nth prime. Otherwise we sieve,
+/// the primes inside the atlas are still counted using the atlas.
+///
+uint64_t ParallelSieve::nthPrime(int64_t n, uint64_t start)
+{
+  uint64_t prime;
+
+  if (atlas_)
+  {
+    auto t1 = std::chrono::steady_clock::now();
+
+    if (atlas_->nthPrime(n, start, &prime))
+    {
+      setStart(start);
+      auto t2 = std::chrono::steady_clock::now();
+      std::chrono::duration<double> seconds = t2 - t1;
+      seconds_ = seconds.count();
+      return prime;
+    }
+  }
+
+  return PrimeSieve::nthPrime(n, start);
+}
+
+/// Count the primes inside [start, stop] using the prime count
+/// index: pi(stop) - pi(start - 1). pi(x) = pi(c) +- the primes
+/// between x and its nearest checkpoint c, hence we only sieve
+/// the numbers between start - 1, stop and their nearest
+/// checkpoints. Returns false if counting the primes between
+/// these numbers and their checkpoints is not cheaper than
+/// counting [start, stop] without the index (using sieving or
+/// LMO, whichever is cheaper).
+///
+bool ParallelSieve::countPrimesIndex()
+{
+  ASSERT(countIndex_);
+  uint64_t x[2] = { start_ - 1, stop_ };
+  uint64_t checkpoint[2];
+  uint64_t pi[2] = { 0, 0 };
+
+  if (indexCost(start_, stop_) >= countCost(start_, stop_))
+    return false;
+
+  for (int i = 0; i < 2; i++)
+  {
+    // pi(start - 1) = 0 for start = 0
+    if (i == 0 && start_ == 0)
+    {
+      checkpoint[i] = x[i] = 0;
+      continue;
+    }
+
+    checkpoint[i] = countIndex_->nearest(x[i], &pi[i]);
+  }
+
+  setStatus(0);
+  auto t1 = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < 2; i++)
+  {
+    if (x[i] > checkpoint[i])
+      pi[i] += countPrimesNoIndex(checkpoint[i] + 1, x[i]);
+    if (x[i] < checkpoint[i])
+      pi[i] -= countPrimesNoIndex(x[i] + 1, checkpoint[i]);
+  }
+
+  counts_[0] = pi[1] - pi[0];
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+  setStatus(100);
+
+  return true;
+}
+
+/// Count the primes inside [start, stop] as pi(stop) - pi(start - 1)
+/// using the LMO algorithm which uses O(x^(2/3)) operations.
+/// Returns false if it is faster to sieve [start, stop].
+///
+bool ParallelSieve::countPrimesLMO()
+{
+  if (!isLMO_ ||
+      !isPrimePiLMOFaster(start_, stop_))
+    return false;
+
+  setStatus(0);
+  auto t1 = std::chrono::steady_clock::now();
+  int threads = getNumThreads();
+
+  // See idealNumThreads()
+  if (ThreadPool::isWorkerThread() ||
+      ThreadPool::isDestroyed())
+    threads = 1;
+
+  counts_[0] = primePiLMO(stop_, threads);
+
+  if (start_ > 0)
+    counts_[0] -= primePiLMO(start_ - 1, threads);
+
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+  setStatus(100);
+
+  return true;
+}
+
+/// Count the primes inside [start, stop] using multi-threading,
+/// without using the index or the atlas. LMO is used if it is
+/// cheaper than sieving, countPrimesIndex() uses the same cost
+/// model (see countCost()) to decide whether counting the
+/// primes between the checkpoints is cheaper than counting
+/// [start, stop] without the index.
+///
+uint64_t ParallelSieve::countPrimesNoIndex(uint64_t start, uint64_t stop)
+{
+  INDETERMINATE ParallelSieve ps;
+  ps.countIndex_.reset();
+  ps.atlas_.reset();
+  ps.isLMO_ = isLMO_;
+  ps.setNumThreads(numThreads_);
+  ps.setSieveSize(getSieveSize());
+  return ps.countPrimes(start, stop);
+}
+
+/// Build the prime count index file for [0, stop], the index
+/// stores pi(k * stride) for k = 0 ... stop / stride. The
+/// primes between 2 checkpoints are counted using
+/// multi-threading.
+/// @stride: 0 selects PrimeCountIndex::defaultStride(stop).
+///
+void ParallelSieve::buildCountIndex(const std::string& filename,
+                                    uint64_t stride)
+{
+  reset();
+
+  if (stride == 0)
+    stride = PrimeCountIndex::defaultStride(stop_);
+
+  setStart(0);
+  setStatus(0);
+  auto t1 = std::chrono::steady_clock::now();
+  uint64_t checkpoints = stop_ / stride + 1;
+  Vector<uint64_t> pi;
+  pi.reserve(checkpoints);
+  pi.push_back(0);
+
+  for (uint64_t k = 1; k < checkpoints; k++)
+  {
+    uint64_t low = (k - 1) * stride + 1;
+    uint64_t high = k * stride;
+    pi.push_back(pi.back() + countPrimesNoIndex(low, high));
+    setStatus(high * 100.0 / std::max(stop_, (uint64_t) 1));
+  }
+
+  PrimeCountIndex::write(filename, stride, pi);
+
+  // The index ends at the last checkpoint <= stop
+  stop_ = (checkpoints - 1) * stride;
+  counts_[0] = pi.back();
+
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+  setStatus(100);
+}
+
+/// Count the primes and prime k-tuplets of the chunks the
+/// scheduler assigns to the thread. The chunks may be stolen
+/// from other threads and hence arrive in any order.
+///
+counts_t ParallelSieve::countChunks(ChunkScheduler& scheduler,
+                                    int thread,
+                                    const SharedSievingPrimes* sievingPrimes)
+{
+  INDETERMINATE PrimeSieve ps(this);
+  if (sievingPrimes)
+    ps.setSievingPrimes(sievingPrimes);
+  std::unique_ptr<CountPrintPrimes> countPrimes;
+  uint64_t low, high;
+  counts_t counts;
+  counts.fill(0);
+
+  while (scheduler.next(thread, &low, &high))
+  {
+    // Adjacent chunks share their boundary, the
+    // upper bound belongs to the lower chunk.
+    uint64_t start = (low > start_) ? align(low) + 1 : low;
+    uint64_t stop = align(high);
+
+    if (start > stop)
+      continue;
+
+    // The primes and k-tuplets < 7 are handled by
+    // PrimeSieve::sieve(). We must not use ps here, its
+    // sieve() resets the counts of countPrimes. The chunk
+    // may be stolen after the thread counted other chunks.
+    if (start < 7)
+    {
+      INDETERMINATE PrimeSieve first(this);
+      first.sieve(start, stop);
+      counts += first.getCounts();
+      continue;
+    }
+
+    // Sieve the primes inside [start, stop]. Consecutive
+    // chunks of the same thread are usually adjacent, in
+    // this case we continue sieving where the previous
+    // chunk stopped.
+    if (!countPrimes)
+    {
+      ps.setStart(start);
+      ps.setStop(stop_);
+      ps.getCounts().fill(0);
+      countPrimes.reset(new CountPrintPrimes(ps));
+    }
+
+    countPrimes->countChunk(start, stop);
+  }
+
+  if (countPrimes)
+    counts += ps.getCounts();
+
+  return counts;
+}
+
+/// Count the primes and prime k-tuplets in [start, stop]
+/// using multi-threading. The chunks are distributed by a
+/// work-stealing scheduler: chunks start large and get smaller
+/// towards the end of the interval and threads that run out of
+/// work steal from the other threads, hence all threads finish
+/// nearly at the same time even if some threads are slower.
+///
+void ParallelSieve::countParallel(int threads)
+{
+  // Each chunk requires generating the sieving primes
+  // <= sqrt(stop), this initialization overhead
+  // should not dominate the total run time.
+  uint64_t maxDist = getThreadDistance(threads);
+  uint64_t minDist = isqrt(stop_) * 4;
+  minDist = std::max(minDist, config::MIN_THREAD_DISTANCE);
+  minDist = std::min(minDist, maxDist);
+
+  SharedSievingPrimes sievingPrimes;
+  bool isShared = initSievingPrimes(sievingPrimes, threads);
+  ChunkScheduler scheduler(start_, stop_, threads, minDist, maxDist);
+  Vector<double> busySeconds(threads);
+  INDETERMINATE RelaxedAtomic<int> threadIds(0);
+
+  // The idle time of the threads must not include
+  // generating the shared sieving primes.
+  auto t1 = std::chrono::steady_clock::now();
+
+  // Each thread executes 1 task
+  auto task = [&]()
+  {
+    int id = threadIds++;
+    auto t2 = std::chrono::steady_clock::now();
+
+    // The thread ids (and hence the ranges) are not grouped
+    // by NUMA node, the node only affects work stealing.
+    scheduler.setNode(id, ThreadPool::getNumaNode());
+    counts_t counts = countChunks(scheduler, id, isShared ? &sievingPrimes : nullptr);
+    auto t3 = std::chrono::steady_clock::now();
+    std::chrono::duration<double> seconds = t3 - t2;
+    busySeconds[id] = seconds.count();
+    return counts;
+  };
+
+  auto futures = submitTasks(threads, task);
+  waitAll(futures);
+
+  for (auto& f : futures)
+    counts_ += f.get();
+
+  auto t4 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t4 - t1;
+  idleSeconds_.resize(threads);
+
+  for (int i = 0; i < threads; i++)
+    idleSeconds_[i] = std::max(0.0, seconds.count() - busySeconds[i]);
+}
+
+/// Print the primes or prime k-tuplets in [start, stop] using
+/// multi-threading. The threads sieve the chunks in ascending
+/// order and convert the primes of each chunk to text into a
+/// print buffer. The calling thread prints the buffers to
+/// stdout strictly in ascending chunk order, see
+/// orderedPipeline().
+///
+void ParallelSieve::printParallel(int threads)
+{
+  uint64_t dist = getDistance();
+  uint64_t threadDist = getPrintDistance(threads);
+  uint64_t iters = ((dist - 1) / threadDist) + 1;
+  threads = inBetween(1, threads, iters);
+  SharedSievingPrimes sievingPrimes;
+  bool isShared = initSievingPrimes(sievingPrimes, threads);
+
+  struct PrintBuffer
+  {
+    Vector<char> text;
+    counts_t counts;
+    /// Last printed prime of the chunk, 0 if none
+    uint64_t lastPrime;
+  };
+
+  Vector<PrintBuffer> buffers(threads * 2);
+  bool isGaps = (getPrintFormat() == GAPS_FORMAT);
+  uint64_t prevPrime = 0;
+
+  orderedPipeline(threads, iters, buffers,
+    [&](uint64_t i, PrintBuffer& buffer)
+    {
+      uint64_t start, stop;
+      getChunk(i, threadDist, &start, &stop);
+
+      // Print the primes inside [start, stop]
+      // into the chunk's print buffer.
+      INDETERMINATE PrimeSieve ps(this);
+      if (isShared)
+        ps.setSievingPrimes(&sievingPrimes);
+      buffer.text.clear();
+      ps.setPrintBuffer(&buffer.text);
+      ps.sieve(start, stop);
+      buffer.counts = ps.getCounts();
+      buffer.lastPrime = ps.getPrevPrime();
+    },
+    [&](PrintBuffer& buffer)
+    {
+      const char* data = buffer.text.data();
+      std::size_t size = buffer.text.size();
+
+      // The prime gaps of each chunk start with an absolute
+      // prime, we continue the gaps of the previous chunk
+      // so that the output is the same as if it had been
+      // printed by a single thread.
+      if (isGaps && buffer.lastPrime)
+      {
+        if (prevPrime)
+        {
+          char bytes[MAX_PRIME_BYTES];
+          char* end = bytes;
+          std::size_t skip = rewrite_first_gap(data, size, end, prevPrime);
+          write(bytes, end - bytes);
+          data += skip;
+          size -= skip;
+        }
+
+        prevPrime = buffer.lastPrime;
+      }
+
+      write(data, size);
+      counts_ += buffer.counts;
+    });
+}
+
+/// Print the primes inside [start, stop] to the output file
+/// using multi-threading. Unlike printParallel() there is no
+/// ordering stage: first the primes of each chunk are counted
+/// in parallel, from the counts we compute the number of bytes
+/// of each chunk and the chunk's file offset using a prefix
+/// sum. Then the threads write their chunks simultaneously at
+/// these offsets using OutputFile::write(data, size, offset).
+///
+void ParallelSieve::writeParallel(int threads)
+{
+  uint64_t dist = getDistance();
+  uint64_t threadDist = getPrintDistance(threads);
+  uint64_t iters = ((dist - 1) / threadDist) + 1;
+  threads = inBetween(1, threads, iters);
+  int format = getPrintFormat();
+
+  // offsets[i] = file offset of chunk i
+  Vector<uint64_t> offsets(iters + 1);
+  offsets[0] = 0;
+  INDETERMINATE RelaxedAtomic<uint64_t> a(0);
+  SharedSievingPrimes sievingPrimes;
+  bool isShared = initSievingPrimes(sievingPrimes, threads);
+
+  auto countTask = [&]()
+  {
+    // Not attached to this object,
+    // hence no status updates.
+    INDETERMINATE PrimeSieve ps;
+    ps.setSieveSize(getSieveSize());
+    if (isShared)
+      ps.setSievingPrimes(&sievingPrimes);
+    uint64_t i;
+
+    while ((i = a++) < iters)
+    {
+      uint64_t start, stop;
+      getChunk(i, threadDist, &start, &stop);
+      offsets[i + 1] = getPrintBytes(ps, start, stop, format);
+    }
+  };
+
+  runParallel(threads, countTask);
+
+  for (uint64_t i = 0; i < iters; i++)
+    offsets[i + 1] += offsets[i];
+
+  INDETERMINATE RelaxedAtomic<uint64_t> b(0);
+
+  auto writeTask = [&]()
+  {
+    INDETERMINATE PrimeSieve ps(this);
+    if (isShared)
+      ps.setSievingPrimes(&sievingPrimes);
+    Vector<char> buffer;
+    ps.setPrintBuffer(&buffer);
+    counts_t counts;
+    counts.fill(0);
+    uint64_t i;
+
+    while ((i = b++) < iters)
+    {
+      uint64_t start, stop;
+      getChunk(i, threadDist, &start, &stop);
+      buffer.clear();
+      ps.sieve(start, stop);
+      counts += ps.getCounts();
+
+      if (buffer.size() != offsets[i + 1] - offsets[i])
+        throw primesieve_error("writeParallel(): chunk size does not match precomputed size");
+
+      file_->write(buffer.data(), buffer.size(), offsets[i]);
+    }
+
+    return counts;
+  };
+
+  auto futures = submitTasks(threads, writeTask);
+  waitAll(futures);
+
+  for (auto& f : futures)
+    counts_ += f.get();
+}
+
+/// Store the primes inside [start, stop] into the user's primes
+/// vector using multi-threading. First the primes inside each
+/// chunk are counted in parallel and memory for the exact total
+/// number of primes is reserved. Then each thread stores the
+/// primes of its chunks directly at their precomputed offsets.
+/// std::vector zero fills the new elements when it is resized,
+/// hence the calling thread appends the chunks one at a time
+/// while the other threads store the chunks that have already
+/// been appended. Returns false if the distance is too small
+/// for multi-threading.
+/// @primeBytes: sizeof(primes[0]), must be 2, 4 or 8.
+/// @reserve: Reserves memory for count more elements.
+/// @append: Appends count elements to the primes vector and
+///          returns a pointer to the first new element.
+///
+bool ParallelSieve::storePrimes(std::size_t primeBytes,
+                                void* primes,
+                                void (*reserve)(void*, std::size_t),
+                                void* (*append)(void*, std::size_t))
+{
+  reset();
+
+  if (start_ > stop_)
+    return false;
+
+  int threads = idealNumThreads();
+  if (threads == 1)
+    return false;
+
+  auto t1 = std::chrono::steady_clock::now();
+  uint64_t dist = getDistance();
+  uint64_t threadDist = getThreadDistance(threads);
+  uint64_t iters = ((dist - 1) / threadDist) + 1;
+  threads = inBetween(1, threads, iters);
+
+  // offsets[i] = number of primes < chunk i
+  Vector<uint64_t> offsets(iters + 1);
+  offsets[0] = 0;
+  INDETERMINATE RelaxedAtomic<uint64_t> a(0);
+  SharedSievingPrimes sievingPrimes;
+  bool isShared = initSievingPrimes(sievingPrimes, threads);
+
+  auto countTask = [&]()
+  {
+    INDETERMINATE PrimeSieve ps(this);
+    if (isShared)
+      ps.setSievingPrimes(&sievingPrimes);
+    uint64_t i;
+
+    while ((i = a++) < iters)
+    {
+      uint64_t start, stop;
+      getChunk(i, threadDist, &start, &stop);
+      offsets[i + 1] = ps.countPrimes(start, stop);
+    }
+  };
+
+  runParallel(threads, countTask);
+
+  for (uint64_t i = 0; i < iters; i++)
+    offsets[i + 1] += offsets[i];
+
+  uint64_t count = offsets[iters];
+  counts_[0] = count;
+
+  if (count > 0)
+  {
+    // The primes vector is not reallocated after this
+    reserve(primes, (std::size_t) count);
+
+    // chunks[i] = first prime of chunk i, the primes of
+    // chunk i may only be stored once i < appended.
+    Vector<char*> chunks(iters);
+    uint64_t appended = 0;
+    bool abort = false;
+    std::mutex mutex;
+    std::condition_variable cond;
+    INDETERMINATE RelaxedAtomic<uint64_t> b(0);
+
+    auto storeTask = [&]()
+    {
+      uint64_t i;
+
+      while ((i = b++) < iters)
+      {
+        uint64_t n = offsets[i + 1] - offsets[i];
+        if (n == 0)
+          continue;
+
+        char* chunkPrimes;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          cond.wait(lock, [&]() { return abort || i < appended; });
+          if (abort)
+            break;
+          chunkPrimes = chunks[i];
+        }
+
+        uint64_t start, stop;
+        getChunk(i, threadDist, &start, &stop);
+
+        switch (primeBytes)
+        {
+          case 2: storeChunk(start, stop, n, (uint16_t*) chunkPrimes); break;
+          case 4: storeChunk(start, stop, n, (uint32_t*) chunkPrimes); break;
+          case 8: storeChunk(start, stop, n, (uint64_t*) chunkPrimes); break;
+          default: throw primesieve_error("store_primes(): unsupported prime type size!");
+        }
+      }
+    };
+
+    auto futures = submitTasks(threads, storeTask);
+
+    try
+    {
+      for (uint64_t i = 0; i < iters; i++)
+      {
+        uint64_t n = offsets[i + 1] - offsets[i];
+        char* chunkPrimes = nullptr;
+        if (n > 0)
+          chunkPrimes = (char*) append(primes, (std::size_t) n);
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          chunks[i] = chunkPrimes;
+          appended = i + 1;
+        }
+
+        cond.notify_all();
+      }
+    }
+    catch (...)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        abort = true;
+      }
+
+      cond.notify_all();
+      waitAll(futures);
+      throw;
+    }
+
+    waitAll(futures);
+
+    for (auto& f : futures)
+      f.get();
+  }
+
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+
+  return true;
+}
+
+/// Call callback(ctx, primes, size) for each block of primes
+/// inside [start, stop] using multi-threading. If ordered is
+/// true the blocks are passed to the callback in ascending order
+/// and the callback is never called concurrently. Otherwise the
+/// callback is called concurrently by the worker threads and the
+/// blocks arrive in arbitrary order (the primes of each block
+/// are in ascending order).
+///
+void ParallelSieve::forEachPrime(bool ordered,
+                                 void* ctx,
+                                 void (*callback)(void*, const uint64_t*, std::size_t))
+{
+  reset();
+
+  if (start_ > stop_)
+    return;
+
+  auto t1 = std::chrono::steady_clock::now();
+  int threads = idealNumThreads();
+
+  if (threads == 1)
+  {
+    forEachBlock(start_, stop_, [&](const uint64_t* primes, std::size_t size) {
+      callback(ctx, primes, size);
+      return true;
+    });
+  }
+  else if (ordered)
+    forEachOrdered(threads, ctx, callback);
+  else
+    forEachUnordered(threads, ctx, callback);
+
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+}
+
+/// The threads generate the primes of their chunks into
+/// buffers and the calling thread passes the buffers to the
+/// callback in ascending chunk order, see orderedPipeline().
+/// At most 2 buffers per thread are in flight.
+///
+void ParallelSieve::forEachOrdered(int threads,
+                                   void* ctx,
+                                   void (*callback)(void*, const uint64_t*, std::size_t))
+{
+  // Each prime uses 8 bytes and there
+  // are 1 / log(stop) primes per number.
+  double x = (double) std::max(stop_, (uint64_t) 10);
+  double bytesPerNumber = 8 / std::log(x);
+
+  uint64_t dist = getDistance();
+  uint64_t threadDist = getBufferDistance(threads, bytesPerNumber);
+  uint64_t iters = ((dist - 1) / threadDist) + 1;
+  threads = inBetween(1, threads, iters);
+  Vector<Vector<uint64_t>> buffers(threads * 2);
+
+  orderedPipeline(threads, iters, buffers,
+    [&](uint64_t i, Vector<uint64_t>& buffer)
+    {
+      uint64_t start, stop;
+      getChunk(i, threadDist, &start, &stop);
+      buffer.clear();
+
+      forEachBlock(start, stop, [&](const uint64_t* primes, std::size_t size) {
+        buffer.insert(buffer.end(), primes, primes + size);
+        return true;
+      });
+    },
+    [&](Vector<uint64_t>& buffer)
+    {
+      if (!buffer.empty())
+        callback(ctx, buffer.data(), buffer.size());
+    });
+}
+
+/// The worker threads call the callback directly for each
+/// block of primes of their chunks, no buffering is needed.
+/// If the callback throws an exception the other threads
+/// stop after their current block.
+///
+void ParallelSieve::forEachUnordered(int threads,
+                                     void* ctx,
+                                     void (*callback)(void*, const uint64_t*, std::size_t))
+{
+  uint64_t dist = getDistance();
+  uint64_t threadDist = getThreadDistance(threads);
+  uint64_t iters = ((dist - 1) / threadDist) + 1;
+  threads = inBetween(1, threads, iters);
+  INDETERMINATE RelaxedAtomic<uint64_t> a(0);
+  std::atomic<bool> abort(false);
+
+  auto task = [&]()
+  {
+    try
+    {
+      uint64_t i;
+
+      while ((i = a++) < iters && !abort)
+      {
+        uint64_t start, stop;
+        getChunk(i, threadDist, &start, &stop);
+
+        forEachBlock(start, stop, [&](const uint64_t* primes, std::size_t size) {
+          if (abort.load(std::memory_order_relaxed))
+            return false;
+          callback(ctx, primes, size);
+          return true;
+        });
+      }
+    }
+    catch (...)
+    {
+      abort = true;
+      throw;
+    }
+  };
+
+  runParallel(threads, task);
+}
+
+/// Call callback(ctx, segmentLow, sieve, size) for each sieved
+/// segment of [start, stop], the sieve array is passed to the
+/// callback without copying it. If ordered is true the segments
+/// are sieved by the calling thread in ascending order. Otherwise
+/// the segments are sieved using multi-threading and the callback
+/// is called concurrently by the worker threads, each thread
+/// sieves its segments in ascending order. If threadCtx is not
+/// nullptr each thread calls threadCtx(ctx) once before sieving
+/// and passes the returned pointer instead of ctx to callback,
+/// this allows the threads to use their own accumulators.
+///
+void ParallelSieve::forEachSegment(bool ordered,
+                                   void* ctx,
+                                   void (*callback)(void*, uint64_t, const uint64_t*, std::size_t),
+                                   void* (*threadCtx)(void*))
+{
+  reset();
+
+  // The primes < 7 are not part of the sieve array
+  uint64_t start = std::max<uint64_t>(start_, 7);
+  if (start > stop_)
+    return;
+
+  auto t1 = std::chrono::steady_clock::now();
+  int threads = ordered ? 1 : idealNumThreads();
+
+  if (threads == 1)
+  {
+    SegmentSieve segmentSieve(start, stop_, getSieveSize(), nullptr);
+    segmentSieve.sieve(threadCtx ? threadCtx(ctx) : ctx, callback);
+  }
+  else
+  {
     uint64_t dist = getDistance();
     uint64_t threadDist = getThreadDistance(threads);
     uint64_t iters = ((dist - 1) / threadDist) + 1;
     threads = inBetween(1, threads, iters);
     INDETERMINATE RelaxedAtomic<uint64_t> a(0);
+    SharedSievingPrimes sievingPrimes;
+    bool isShared = initSievingPrimes(sievingPrimes, threads);
 
-    // Each thread executes 1 task
     auto task = [&]()
     {
-      INDETERMINATE PrimeSieve ps(this);
+      void* localCtx = threadCtx ? threadCtx(ctx) : ctx;
       uint64_t i;
-      counts_t counts;
-      counts.fill(0);
 
       while ((i = a++) < iters)
       {
-        uint64_t start = start_ + threadDist * i;
-        uint64_t stop = checkedAdd(start, threadDist);
-        stop = align(stop);
+        uint64_t low, high;
+        getChunk(i, threadDist, &low, &high);
+        low = std::max<uint64_t>(low, 7);
 
-        if (start > start_)
-          start = align(start) + 1;
-
-        // Sieve the primes inside [start, stop]
-        ps.sieve(start, stop);
-        counts += ps.getCounts();
+        if (low <= high)
+        {
+          SegmentSieve segmentSieve(low, high, getSieveSize(), isShared ? &sievingPrimes : nullptr);
+          segmentSieve.sieve(localCtx, callback);
+        }
       }
-
-      return counts;
     };
 
-    Vector<std::future<counts_t>> futures;
-    futures.reserve(threads);
+    runParallel(threads, task);
+  }
 
-    for (int t = 0; t < threads; t++)
-      futures.emplace_back(std::async(std::launch::async, task));
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+}
 
-    for (auto& f : futures)
-      counts_ += f.get();
+/// Build the prime atlas file for [0, stop]. The segments
+/// are sieved using multi-threading and each thread writes
+/// the sieve arrays of its segments directly to the file.
+///
+void ParallelSieve::buildAtlas(const std::string& filename)
+{
+  auto t1 = std::chrono::steady_clock::now();
+  PrimeAtlasWriter writer(filename, stop_);
+  setStart(0);
 
-    auto t2 = std::chrono::steady_clock::now();
-    std::chrono::duration<double> seconds = t2 - t1;
-    seconds_ = seconds.count();
+  forEachSegment(false, &writer,
+    [](void* ctx, uint64_t low, const uint64_t* sieve, std::size_t size)
+    {
+      PrimeAtlasWriter* writer = (PrimeAtlasWriter*) ctx;
+      writer->addSegment(low, sieve, size);
+    });
+
+  counts_[0] = writer.finish();
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+}
+
+/// Count the primes inside the intervals [starts[i], stops[i]].
+/// The intervals are sorted and merged, each merged range is
+/// sieved once using multi-threading and the primes of each
+/// interval are counted in the sieve arrays of the segments.
+/// Each thread counts the primes in its own
+/// IntervalCounter::Local object.
+///
+void ParallelSieve::countPrimesBatch(const uint64_t* starts,
+                                     const uint64_t* stops,
+                                     std::size_t size,
+                                     uint64_t* counts)
+{
+  auto t1 = std::chrono::steady_clock::now();
+  IntervalCounter counter(starts, stops, size);
+
+  for (const auto& range : counter.getRanges())
+  {
+    setStart(range.start);
+    setStop(range.stop);
+
+    forEachSegment(false, &counter,
+      [](void* ctx, uint64_t low, const uint64_t* sieve, std::size_t size)
+      {
+        IntervalCounter::Local* local = (IntervalCounter::Local*) ctx;
+        local->counter->addSegment(*local, low, sieve, size);
+      },
+      [](void* ctx) -> void*
+      {
+        IntervalCounter* counter = (IntervalCounter*) ctx;
+        return counter->addThread();
+      });
+
+    counter.finishRange();
+  }
+
+  counter.getCounts(counts);
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+}
+
+/// Count the primes and prime k-tuplets inside [start, stop]
+/// per bucket of width numbers using a single sieving pass,
+/// histogram[i] contains the counts of the numbers
+/// [start + i * width, start + (i + 1) * width - 1].
+/// The chunks are aligned to bucket edges, hence each
+/// bucket is counted by a single thread.
+///
+void ParallelSieve::countHistogram(uint64_t width,
+                                   Vector<counts_t>& histogram)
+{
+  if (width == 0)
+    throw primesieve_error("histogram bucket width must be > 0");
+  if (isPrint())
+    throw primesieve_error("histogram cannot be combined with printing");
+
+  reset();
+  histogram.clear();
+
+  if (start_ > stop_)
+    return;
+
+  // Compare before adding 1 to prevent integer overflow
+  if ((stop_ - start_) / width >= config::MAX_HISTOGRAM_BUCKETS)
+    throw primesieve_error("histogram has more than " +
+        std::to_string(config::MAX_HISTOGRAM_BUCKETS) +
+        " buckets, use a larger bucket width");
+
+  uint64_t buckets = (stop_ - start_) / width + 1;
+  histogram.resize((std::size_t) buckets);
+  for (auto& counts : histogram)
+    counts.fill(0);
+
+  setHistogram(&histogram, start_, width);
+  auto t1 = std::chrono::steady_clock::now();
+  int threads = idealNumThreads();
+  uint64_t bucketsPerChunk = buckets;
+
+  if (threads > 1)
+  {
+    uint64_t threadDist = getThreadDistance(threads);
+    bucketsPerChunk = ceilDiv(threadDist, width);
+    uint64_t chunks = ceilDiv(buckets, bucketsPerChunk);
+    threads = (int) std::min(chunks, (uint64_t) threads);
+  }
+
+  if (threads == 1)
+    PrimeSieve::sieve();
+  else
+  {
+    setStatus(0);
+    SharedSievingPrimes sievingPrimes;
+    bool isShared = initSievingPrimes(sievingPrimes, threads);
+    uint64_t chunks = ceilDiv(buckets, bucketsPerChunk);
+    INDETERMINATE RelaxedAtomic<uint64_t> a(0);
+
+    auto task = [&]()
+    {
+      INDETERMINATE PrimeSieve ps(this);
+      if (isShared)
+        ps.setSievingPrimes(&sievingPrimes);
+      uint64_t i;
+
+      while ((i = a++) < chunks)
+      {
+        uint64_t first = i * bucketsPerChunk;
+        uint64_t last = std::min(first + bucketsPerChunk, buckets) - 1;
+        uint64_t low = start_ + first * width;
+        uint64_t high = std::min(getBucketStop(last), stop_);
+        ps.sieve(low, high);
+      }
+    };
+
+    runParallel(threads, task);
     setStatus(100);
   }
+
+  setHistogram(nullptr, 0, 0);
+  counts_.fill(0);
+  for (const auto& counts : histogram)
+    counts_ += counts;
+
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+}
+
+/// Prime gap analysis of [start, stop] using a single sieving
+/// pass. The segments are sieved using multi-threading and the
+/// gaps are computed directly in their sieve arrays. Each
+/// thread adds its gaps to its own GapCounter::Local object.
+///
+void ParallelSieve::countGaps(GapCounter& counter)
+{
+  auto t1 = std::chrono::steady_clock::now();
+
+  forEachSegment(false, &counter,
+    [](void* ctx, uint64_t low, const uint64_t* sieve, std::size_t size)
+    {
+      GapCounter::Local* local = (GapCounter::Local*) ctx;
+      local->counter->addSegment(*local, low, sieve, size);
+    },
+    [](void* ctx) -> void*
+    {
+      GapCounter* counter = (GapCounter*) ctx;
+      return counter->addThread();
+    });
+
+  counter.finish();
+  counts_[0] = counter.getPrimeCount();
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
+}
+
+/// Count the primes inside [start, stop] by residue class
+/// using a single sieving pass. Each thread counts the primes
+/// in its own ResidueCounter::Local object.
+///
+void ParallelSieve::countPrimesMod(ResidueCounter& counter)
+{
+  auto t1 = std::chrono::steady_clock::now();
+  int threads = numThreads_;
+
+  // Limit the memory usage of the threads' counts for large q
+  numThreads_ = std::min(threads, counter.getMaxThreads());
+
+  forEachSegment(false, &counter,
+    [](void* ctx, uint64_t low, const uint64_t* sieve, std::size_t size)
+    {
+      ResidueCounter::Local* local = (ResidueCounter::Local*) ctx;
+      local->counter->addSegment(*local, low, sieve, size);
+    },
+    [](void* ctx) -> void*
+    {
+      ResidueCounter* counter = (ResidueCounter*) ctx;
+      return counter->addThread();
+    });
+
+  numThreads_ = threads;
+
+  counts_[0] = counter.getPrimeCount();
+  auto t2 = std::chrono::steady_clock::now();
+  std::chrono::duration<double> seconds = t2 - t1;
+  seconds_ = seconds.count();
 }
 
 } // namespace
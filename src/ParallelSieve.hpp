@@ -12,34 +12,86 @@
 #ifndef PARALLELSIEVE_HPP
 #define PARALLELSIEVE_HPP
 
+#include "OutputFile.hpp"
+#include "PrimeAtlas.hpp"
+#include "PrimeCountIndex.hpp"
 #include "PrimeSieveClass.hpp"
 
 #include <primesieve/config.hpp>
 #include <primesieve/macros.hpp>
+#include <primesieve/Vector.hpp>
 
 #include <stdint.h>
+#include <cstddef>
+#include <memory>
 #include <mutex>
+#include <string>
 
 namespace primesieve {
 
+class ChunkScheduler;
+class GapCounter;
+class ResidueCounter;
+class SharedSievingPrimes;
+
 class ParallelSieve : public PrimeSieve
 {
 public:
   using PrimeSieve::sieve;
+  using PrimeSieve::nthPrime;
 
   ParallelSieve();
   static int getMaxThreads();
   int getNumThreads() const;
   int idealNumThreads() const;
+  const Vector<double>& getIdleSeconds() const;
   void setNumThreads(int numThreads);
+  void setLMO(bool);
+  void setOutputFilename(const std::string& filename);
   bool tryUpdateStatus(uint64_t);
   virtual void sieve();
+  uint64_t nthPrime(int64_t, uint64_t);
+  bool storePrimes(std::size_t, void*, void (*)(void*, std::size_t), void* (*)(void*, std::size_t));
+  void forEachPrime(bool, void*, void (*)(void*, const uint64_t*, std::size_t));
+  void forEachSegment(bool, void*, void (*)(void*, uint64_t, const uint64_t*, std::size_t), void* (*)(void*) = nullptr);
+  void buildCountIndex(const std::string& filename, uint64_t stride);
+  void buildAtlas(const std::string& filename);
+  void countPrimesBatch(const uint64_t*, const uint64_t*, std::size_t, uint64_t*);
+  void countHistogram(uint64_t, Vector<counts_t>&);
+  void countGaps(GapCounter&);
+  void countPrimesMod(ResidueCounter&);
+  counts_t countChunks(ChunkScheduler&, int, const SharedSievingPrimes*);
 
 private:
   uint64_t getThreadDistance(int) const;
+  uint64_t getPrintDistance(int) const;
+  uint64_t getBufferDistance(int, double) const;
   uint64_t align(uint64_t) const;
+  void getChunk(uint64_t, uint64_t, uint64_t*, uint64_t*) const;
+  bool initSievingPrimes(SharedSievingPrimes&, int);
+  void countParallel(int);
+  void printParallel(int);
+  void writeParallel(int);
+  double countCost(uint64_t, uint64_t) const;
+  double indexCost(uint64_t, uint64_t) const;
+  bool countPrimesAtlas();
+  bool countPrimesIndex();
+  bool countPrimesLMO();
+  uint64_t countPrimesNoIndex(uint64_t, uint64_t);
+  void forEachOrdered(int, void*, void (*)(void*, const uint64_t*, std::size_t));
+  void forEachUnordered(int, void*, void (*)(void*, const uint64_t*, std::size_t));
 
   int numThreads_ = 0;
+  /// Count primes using LMO if it is faster than sieving
+  bool isLMO_ = true;
+  Vector<double> idleSeconds_;
+  /// Used by primesieve --print --output=FILE
+  std::string outputFilename_;
+  std::unique_ptr<OutputFile> file_;
+  /// Used for counting primes if not nullptr
+  std::shared_ptr<const PrimeCountIndex> countIndex_;
+  /// Used for counting primes and nth prime if not nullptr
+  std::shared_ptr<const PrimeAtlas> atlas_;
   MAYBE_UNUSED char pad1[config::MAX_CACHE_LINE_SIZE];
   std::mutex mutex_;
   MAYBE_UNUSED char pad2[config::MAX_CACHE_LINE_SIZE];
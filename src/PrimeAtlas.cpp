@@ -0,0 +1,489 @@
+///
+/// @file   PrimeAtlas.cpp
+/// @brief  The prime atlas is a bitmap of the primes <= limit that
+///         uses the same layout as the sieve array: bit i of byte j
+///         corresponds to the number j * 30 + { 7, 11, 13, 17, 19,
+///         23, 29, 31 }[i]. The atlas file is built using
+///         primesieve --build-atlas (ParallelSieve::buildAtlas())
+///         and memory mapped by load_prime_atlas().
+///
+///         The rank directory stores the number of 1 bits before
+///         each superblock of 4096 bits (64-bit) and before each
+///         block of 512 bits relative to its superblock (16-bit).
+///         Hence pi(x) requires at most 8 popcounts within a single
+///         cache line. For select we additionally store the
+///         superblock of every 2^16-th 1 bit, the superblock of
+///         the nth 1 bit is then found using a short binary search.
+///
+///         File format (all integers are little-endian):
+///         64 bytes header: 8 bytes magic "PSATLAS1", limit,
+///         number of bitmap words, number of 1 bits, number of
+///         samples (64-bit each), zero padding. The header is
+///         followed by the bitmap (64-bit words), the superblock
+///         counts (64-bit, the last entry is the total count), the
+///         block counts (16-bit) and the select samples (64-bit).
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "PrimeAtlas.hpp"
+#include "MappedFile.hpp"
+#include "OutputFile.hpp"
+
+#include <primesieve/macros.hpp>
+#include <primesieve/popcnt.hpp>
+#include <primesieve/primesieve_error.hpp>
+#include <primesieve/util.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace {
+
+const char magic[8] = { 'P', 'S', 'A', 'T', 'L', 'A', 'S', '1' };
+const uint64_t offsets[8] = { 7, 11, 13, 17, 19, 23, 29, 31 };
+const std::size_t HEADER_BYTES = 64;
+const uint64_t BLOCK_WORDS = 8;
+const uint64_t SUPER_WORDS = 64;
+const uint64_t SAMPLE_RATE = 1 << 16;
+
+std::mutex atlasMutex;
+std::shared_ptr<const primesieve::PrimeAtlas> primeAtlas;
+
+uint64_t read_uint64(const uint8_t* p)
+{
+  uint64_t n;
+  std::memcpy(&n, p, sizeof(n));
+  return primesieve::to_littleendian(n);
+}
+
+uint64_t read_uint16(const uint8_t* p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+void write_uint64(primesieve::Vector<char>& buffer, uint64_t n)
+{
+  n = primesieve::to_littleendian(n);
+  const char* p = (const char*) &n;
+  buffer.insert(buffer.end(), p, p + sizeof(n));
+}
+
+void write_uint16(primesieve::Vector<char>& buffer, uint64_t n)
+{
+  buffer.push_back((char) (n & 0xff));
+  buffer.push_back((char) (n >> 8));
+}
+
+/// Number of bitmap words required for the numbers <= limit,
+/// rounded up to a multiple of the superblock size.
+///
+uint64_t bitmapWords(uint64_t limit)
+{
+  uint64_t bytes = limit / 30 + 1;
+  uint64_t superBytes = SUPER_WORDS * 8;
+  return ((bytes + superBytes - 1) / superBytes) * SUPER_WORDS;
+}
+
+/// The primes 2, 3 and 5 are not part of the bitmap
+uint64_t smallPrimes(uint64_t x)
+{
+  return (x >= 2) + (x >= 3) + (x >= 5);
+}
+
+} // namespace
+
+namespace primesieve {
+
+PrimeAtlas::PrimeAtlas(const std::string& filename) :
+  file_(filename)
+{
+  const uint8_t* data = file_.data();
+  std::size_t bytes = file_.size();
+
+  if (bytes < HEADER_BYTES ||
+      std::memcmp(data, magic, sizeof(magic)) != 0)
+    throw primesieve_error("invalid prime atlas file " + filename);
+
+  limit_ = read_uint64(data + 8);
+  words_ = read_uint64(data + 16);
+  ones_ = read_uint64(data + 24);
+  samples_ = read_uint64(data + 32);
+
+  if (words_ % SUPER_WORDS != 0 ||
+      words_ != bitmapWords(limit_) ||
+      words_ > bytes / 8 ||
+      ones_ > words_ * 64 ||
+      samples_ != (ones_ + SAMPLE_RATE - 1) / SAMPLE_RATE)
+    throw primesieve_error("invalid prime atlas file " + filename);
+
+  uint64_t supers = words_ / SUPER_WORDS;
+  uint64_t blocks = words_ / BLOCK_WORDS;
+  uint64_t size = HEADER_BYTES + words_ * 8 + (supers + 1) * 8 +
+                  blocks * 2 + samples_ * 8;
+
+  if (size != bytes)
+    throw primesieve_error("invalid prime atlas file " + filename);
+
+  bitmap_ = data + HEADER_BYTES;
+  supers_ = bitmap_ + words_ * 8;
+  blocks_ = supers_ + (supers + 1) * 8;
+  samplesArray_ = blocks_ + blocks * 2;
+  piLimit_ = pi(limit_);
+}
+
+uint64_t PrimeAtlas::getLimit() const
+{
+  return limit_;
+}
+
+uint64_t PrimeAtlas::word(uint64_t i) const
+{
+  ASSERT(i < words_);
+  return read_uint64(bitmap_ + i * 8);
+}
+
+/// Number of 1 bits before the ith superblock
+uint64_t PrimeAtlas::superCount(uint64_t i) const
+{
+  ASSERT(i <= words_ / SUPER_WORDS);
+  return read_uint64(supers_ + i * 8);
+}
+
+/// Number of 1 bits before the ith block,
+/// relative to the start of its superblock.
+///
+uint64_t PrimeAtlas::blockCount(uint64_t i) const
+{
+  ASSERT(i < words_ / BLOCK_WORDS);
+  return read_uint16(blocks_ + i * 2);
+}
+
+/// Superblock of the (i * SAMPLE_RATE)-th 1 bit
+uint64_t PrimeAtlas::sample(uint64_t i) const
+{
+  ASSERT(i < samples_);
+  return read_uint64(samplesArray_ + i * 8);
+}
+
+/// Number of 1 bits at bit positions < pos
+uint64_t PrimeAtlas::rank(uint64_t pos) const
+{
+  if (pos >= words_ * 64)
+    return ones_;
+
+  uint64_t w = pos / 64;
+  uint64_t b = w / BLOCK_WORDS;
+  uint64_t count = superCount(w / SUPER_WORDS) + blockCount(b);
+
+  for (uint64_t i = b * BLOCK_WORDS; i < w; i++)
+    count += popcnt64(word(i));
+
+  uint64_t bits = pos % 64;
+  if (bits)
+    count += popcnt64(word(w) << (64 - bits));
+
+  return count;
+}
+
+/// Bit position of the 1 bit that has
+/// k 1 bits before it, k < ones_.
+///
+uint64_t PrimeAtlas::select(uint64_t k) const
+{
+  ASSERT(k < ones_);
+  uint64_t i = k / SAMPLE_RATE;
+  uint64_t lo = sample(i);
+  uint64_t hi = words_ / SUPER_WORDS;
+
+  if (i + 1 < samples_)
+    hi = sample(i + 1) + 1;
+
+  // Find the last superblock with superCount <= k
+  while (hi - lo > 1)
+  {
+    uint64_t mid = lo + (hi - lo) / 2;
+    if (superCount(mid) <= k)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  k -= superCount(lo);
+  uint64_t b = lo * (SUPER_WORDS / BLOCK_WORDS);
+  uint64_t end = b + SUPER_WORDS / BLOCK_WORDS;
+
+  while (b + 1 < end && blockCount(b + 1) <= k)
+    b++;
+
+  k -= blockCount(b);
+  uint64_t w = b * BLOCK_WORDS;
+  uint64_t bits = word(w);
+
+  for (uint64_t cnt; (cnt = popcnt64(bits)) <= k; bits = word(++w))
+    k -= cnt;
+
+  // Clear the k lowest 1 bits
+  for (; k > 0; k--)
+    bits &= bits - 1;
+
+  uint64_t lowest = bits & (0 - bits);
+  return w * 64 + popcnt64(lowest - 1);
+}
+
+/// Returns the kth prime, 1 <= k <= pi(limit)
+uint64_t PrimeAtlas::kthPrime(uint64_t k) const
+{
+  ASSERT(k >= 1 && k <= piLimit_);
+  const uint64_t primes[3] = { 2, 3, 5 };
+
+  if (k <= 3)
+    return primes[k - 1];
+
+  uint64_t pos = select(k - 4);
+  return (pos / 8) * 30 + offsets[pos % 8];
+}
+
+/// Count the primes <= x, x <= limit
+uint64_t PrimeAtlas::pi(uint64_t x) const
+{
+  ASSERT(x <= limit_);
+  uint64_t count = smallPrimes(x);
+
+  if (x < 7)
+    return count;
+
+  // Count the bits of the last byte
+  // whose numbers are <= x.
+  uint64_t byte = (x - 7) / 30;
+  uint64_t rem = x - byte * 30;
+  uint64_t bits = 0;
+
+  for (uint64_t offset : offsets)
+    bits += (offset <= rem);
+
+  return count + rank(byte * 8 + bits);
+}
+
+/// Count the primes inside [start, stop], stop <= limit
+uint64_t PrimeAtlas::countPrimes(uint64_t start, uint64_t stop) const
+{
+  ASSERT(stop <= limit_);
+
+  if (start > stop)
+    return 0;
+  if (start == 0)
+    return pi(stop);
+
+  return pi(stop) - pi(start - 1);
+}
+
+/// Find the nth prime > start (or < start if n < 0) like
+/// PrimeSieve::nthPrime(n, start). Returns false if the
+/// nth prime is not inside the atlas, the caller must
+/// then fall back to sieving.
+///
+bool PrimeAtlas::nthPrime(int64_t n, uint64_t start, uint64_t* prime) const
+{
+  uint64_t k;
+
+  if (n >= 0)
+  {
+    if (start >= limit_)
+      return false;
+
+    // n = 0 is treated like n = 1
+    k = pi(start) + std::max<int64_t>(n, 1);
+    if (k > piLimit_)
+      return false;
+  }
+  else
+  {
+    if (start == 0 ||
+        start - 1 > limit_)
+      return false;
+
+    uint64_t abs_n = uint64_t(~n) + 1;
+    uint64_t piStart = pi(start - 1);
+    if (abs_n > piStart)
+      return false;
+
+    k = piStart - abs_n + 1;
+  }
+
+  *prime = kthPrime(k);
+  return true;
+}
+
+std::shared_ptr<const PrimeAtlas> PrimeAtlas::get()
+{
+  std::lock_guard<std::mutex> lock(atlasMutex);
+  return primeAtlas;
+}
+
+/// Load the atlas used by count_primes() and nth_prime(),
+/// an empty filename unloads the current atlas.
+///
+void PrimeAtlas::load(const std::string& filename)
+{
+  std::shared_ptr<const PrimeAtlas> atlas;
+
+  if (!filename.empty())
+    atlas = std::make_shared<const PrimeAtlas>(filename);
+
+  std::lock_guard<std::mutex> lock(atlasMutex);
+  primeAtlas = atlas;
+}
+
+PrimeAtlasWriter::PrimeAtlasWriter(const std::string& filename,
+                                   uint64_t limit) :
+  file_(filename),
+  limit_(limit),
+  words_(bitmapWords(limit)),
+  counts_(words_ / BLOCK_WORDS)
+{ }
+
+/// Write the sieve array of a segment to the bitmap.
+/// The sieve arrays of adjacent chunks overlap by one byte
+/// (below the chunk's start) and by the padding bytes above
+/// the chunk's stop, these bytes are 0. Hence we skip the 0
+/// bytes at both ends of the sieve array so that each thread
+/// only writes its own bytes, the gaps of the file are 0.
+///
+void PrimeAtlasWriter::addSegment(uint64_t low,
+                                  const uint64_t* sieve,
+                                  std::size_t size)
+{
+  const uint8_t* bytes = (const uint8_t*) sieve;
+  std::size_t first = 0;
+  std::size_t last = size * 8;
+
+  while (first < last && bytes[first] == 0)
+    first++;
+  while (last > first && bytes[last - 1] == 0)
+    last--;
+
+  if (first == last)
+    return;
+
+  ASSERT(low % 30 == 0);
+  uint64_t byte = low / 30 + first;
+  std::size_t n = last - first;
+  ASSERT(byte + n <= words_ * 8);
+  file_.write((const char*) &bytes[first], n, HEADER_BYTES + byte);
+  addCount(byte, &bytes[first], n);
+}
+
+/// Add the 1 bits of bytes[0, size[
+/// to the counts of their blocks.
+///
+void PrimeAtlasWriter::addCount(uint64_t byte,
+                                const uint8_t* bytes,
+                                std::size_t size)
+{
+  const uint64_t blockBytes = BLOCK_WORDS * 8;
+
+  while (size > 0)
+  {
+    std::size_t n = (std::size_t) std::min<uint64_t>(size, blockBytes - byte % blockBytes);
+    uint64_t count = 0;
+    std::size_t i = 0;
+
+    for (; i + 8 <= n; i += 8)
+    {
+      uint64_t bits;
+      std::memcpy(&bits, &bytes[i], sizeof(bits));
+      count += popcnt64(bits);
+    }
+
+    for (; i < n; i++)
+      count += popcnt64(bytes[i]);
+
+    // Blocks at the chunk boundaries are shared by 2 threads
+    counts_[byte / blockBytes].fetch_add((uint16_t) count, std::memory_order_relaxed);
+    byte += n;
+    bytes += n;
+    size -= n;
+  }
+}
+
+/// Write the rank/select directory and the header. The header
+/// is written last so that an incomplete file is invalid.
+/// Returns the number of primes <= limit.
+///
+uint64_t PrimeAtlasWriter::finish()
+{
+  uint64_t supers = words_ / SUPER_WORDS;
+  uint64_t blocksPerSuper = SUPER_WORDS / BLOCK_WORDS;
+  uint64_t superOffset = HEADER_BYTES + words_ * 8;
+  uint64_t blockOffset = superOffset + (supers + 1) * 8;
+  uint64_t ones = 0;
+  Vector<char> superBuffer;
+  Vector<char> blockBuffer;
+  Vector<uint64_t> samples;
+
+  auto flush = [&](Vector<char>& buffer, uint64_t& offset)
+  {
+    file_.write(buffer.data(), buffer.size(), offset);
+    offset += buffer.size();
+    buffer.clear();
+  };
+
+  for (uint64_t s = 0; s < supers; s++)
+  {
+    uint64_t count = 0;
+    write_uint64(superBuffer, ones);
+
+    for (uint64_t b = s * blocksPerSuper; b < (s + 1) * blocksPerSuper; b++)
+    {
+      write_uint16(blockBuffer, count);
+      count += counts_[b].load(std::memory_order_relaxed);
+    }
+
+    // Superblock of every (k * SAMPLE_RATE)-th 1 bit
+    while (samples.size() * SAMPLE_RATE < ones + count)
+      samples.push_back(s);
+
+    ones += count;
+
+    if (blockBuffer.size() >= (1 << 20))
+    {
+      flush(superBuffer, superOffset);
+      flush(blockBuffer, blockOffset);
+    }
+  }
+
+  write_uint64(superBuffer, ones);
+  flush(superBuffer, superOffset);
+  flush(blockBuffer, blockOffset);
+
+  Vector<char> buffer;
+  for (uint64_t s : samples)
+    write_uint64(buffer, s);
+
+  file_.write(buffer.data(), buffer.size(), blockOffset);
+
+  buffer.clear();
+  buffer.insert(buffer.end(), magic, magic + sizeof(magic));
+  write_uint64(buffer, limit_);
+  write_uint64(buffer, words_);
+  write_uint64(buffer, ones);
+  write_uint64(buffer, samples.size());
+  buffer.resize(HEADER_BYTES);
+  std::fill(buffer.begin() + 40, buffer.end(), 0);
+  file_.write(buffer.data(), buffer.size(), 0);
+
+  return smallPrimes(limit_) + ones;
+}
+
+} // namespace
@@ -0,0 +1,86 @@
+///
+/// @file   PrimeAtlas.hpp
+/// @brief  The prime atlas is a memory mapped bitmap of the primes
+///         <= limit (8 bits per 30 numbers, like the sieve array)
+///         with a rank/select directory. Using the atlas, counting
+///         the primes inside [start, stop] and finding the nth
+///         prime only require a few memory accesses.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef PRIMEATLAS_HPP
+#define PRIMEATLAS_HPP
+
+#include "MappedFile.hpp"
+#include "OutputFile.hpp"
+
+#include <stdint.h>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace primesieve {
+
+class PrimeAtlas
+{
+public:
+  /// Memory maps the atlas file
+  PrimeAtlas(const std::string& filename);
+  uint64_t getLimit() const;
+  uint64_t pi(uint64_t x) const;
+  uint64_t countPrimes(uint64_t start, uint64_t stop) const;
+  bool nthPrime(int64_t n, uint64_t start, uint64_t* prime) const;
+
+  /// The atlas used by count_primes() and nth_prime()
+  static std::shared_ptr<const PrimeAtlas> get();
+  static void load(const std::string& filename);
+
+private:
+  uint64_t word(uint64_t i) const;
+  uint64_t superCount(uint64_t i) const;
+  uint64_t blockCount(uint64_t i) const;
+  uint64_t sample(uint64_t i) const;
+  uint64_t rank(uint64_t pos) const;
+  uint64_t select(uint64_t k) const;
+  uint64_t kthPrime(uint64_t k) const;
+  MappedFile file_;
+  uint64_t limit_ = 0;
+  uint64_t words_ = 0;
+  uint64_t ones_ = 0;
+  uint64_t samples_ = 0;
+  uint64_t piLimit_ = 0;
+  const uint8_t* bitmap_ = nullptr;
+  const uint8_t* supers_ = nullptr;
+  const uint8_t* blocks_ = nullptr;
+  const uint8_t* samplesArray_ = nullptr;
+};
+
+/// Writes the atlas file, the sieve arrays of the
+/// segments can be added by multiple threads
+/// simultaneously in any order.
+///
+class PrimeAtlasWriter
+{
+public:
+  PrimeAtlasWriter(const std::string& filename, uint64_t limit);
+  void addSegment(uint64_t low, const uint64_t* sieve, std::size_t size);
+  uint64_t finish();
+
+private:
+  void addCount(uint64_t byte, const uint8_t* bytes, std::size_t size);
+  OutputFile file_;
+  uint64_t limit_;
+  uint64_t words_;
+  /// Number of 1 bits of each block of 512 bits
+  std::vector<std::atomic<uint16_t>> counts_;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,161 @@
+///
+/// @file   PrimeCountIndex.cpp
+/// @brief  The prime count index stores pi(x) at checkpoints
+///         x = k * stride. The index file is built using
+///         primesieve --build-index (ParallelSieve::buildCountIndex())
+///         and memory mapped by load_count_index().
+///
+///         File format (all integers are 64-bit little-endian):
+///         8 bytes magic "PSINDEX1", stride, number of
+///         checkpoints n, followed by pi(k * stride) for
+///         k = 0 ... n - 1.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "PrimeCountIndex.hpp"
+#include "MappedFile.hpp"
+#include "OutputFile.hpp"
+
+#include <primesieve/pmath.hpp>
+#include <primesieve/primesieve_error.hpp>
+#include <primesieve/util.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace {
+
+const char magic[8] = { 'P', 'S', 'I', 'N', 'D', 'E', 'X', '1' };
+const std::size_t HEADER_BYTES = 24;
+
+std::mutex indexMutex;
+std::shared_ptr<const primesieve::PrimeCountIndex> countIndex;
+
+uint64_t read_uint64(const uint8_t* p)
+{
+  uint64_t n;
+  std::memcpy(&n, p, sizeof(n));
+  return primesieve::to_littleendian(n);
+}
+
+void write_uint64(primesieve::Vector<char>& buffer, uint64_t n)
+{
+  n = primesieve::to_littleendian(n);
+  const char* p = (const char*) &n;
+  buffer.insert(buffer.end(), p, p + sizeof(n));
+}
+
+} // namespace
+
+namespace primesieve {
+
+PrimeCountIndex::PrimeCountIndex(const std::string& filename) :
+  file_(filename)
+{
+  const uint8_t* data = file_.data();
+  std::size_t bytes = file_.size();
+
+  if (bytes < HEADER_BYTES ||
+      std::memcmp(data, magic, sizeof(magic)) != 0)
+    throw primesieve_error("invalid prime count index file " + filename);
+
+  stride_ = read_uint64(data + 8);
+  size_ = read_uint64(data + 16);
+
+  if (stride_ == 0 ||
+      size_ == 0 ||
+      size_ - 1 > (~0ull) / stride_ ||
+      (bytes - HEADER_BYTES) / 8 != size_ ||
+      (bytes - HEADER_BYTES) % 8 != 0)
+    throw primesieve_error("invalid prime count index file " + filename);
+}
+
+uint64_t PrimeCountIndex::getStride() const
+{
+  return stride_;
+}
+
+/// Largest checkpoint of the index
+uint64_t PrimeCountIndex::getLimit() const
+{
+  return (size_ - 1) * stride_;
+}
+
+/// pi(k * stride)
+uint64_t PrimeCountIndex::pi(uint64_t k) const
+{
+  ASSERT(k < size_);
+  return read_uint64(file_.data() + HEADER_BYTES + k * 8);
+}
+
+/// Returns the checkpoint nearest to n
+/// and stores pi(checkpoint) in *pi.
+///
+uint64_t PrimeCountIndex::nearest(uint64_t n, uint64_t* pi) const
+{
+  uint64_t k = n / stride_;
+
+  if (n % stride_ > stride_ / 2)
+    k++;
+
+  k = std::min(k, size_ - 1);
+  *pi = this->pi(k);
+  return k * stride_;
+}
+
+/// The default stride is a power of 2 so that the index has
+/// about 1024 checkpoints, at most 2^32 and at least 2^20.
+///
+uint64_t PrimeCountIndex::defaultStride(uint64_t stop)
+{
+  uint64_t stride = floorPow2(stop / 1024);
+  return inBetween(1ull << 20, stride, 1ull << 32);
+}
+
+void PrimeCountIndex::write(const std::string& filename,
+                            uint64_t stride,
+                            const Vector<uint64_t>& pi)
+{
+  Vector<char> buffer;
+  buffer.insert(buffer.end(), magic, magic + sizeof(magic));
+  write_uint64(buffer, stride);
+  write_uint64(buffer, pi.size());
+
+  for (uint64_t n : pi)
+    write_uint64(buffer, n);
+
+  OutputFile file(filename);
+  file.write(buffer.data(), buffer.size());
+}
+
+std::shared_ptr<const PrimeCountIndex> PrimeCountIndex::get()
+{
+  std::lock_guard<std::mutex> lock(indexMutex);
+  return countIndex;
+}
+
+/// Load the index used by count_primes() and nth_prime(),
+/// an empty filename unloads the current index.
+///
+void PrimeCountIndex::load(const std::string& filename)
+{
+  std::shared_ptr<const PrimeCountIndex> index;
+
+  if (!filename.empty())
+    index = std::make_shared<const PrimeCountIndex>(filename);
+
+  std::lock_guard<std::mutex> lock(indexMutex);
+  countIndex = index;
+}
+
+} // namespace
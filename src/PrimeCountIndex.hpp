@@ -0,0 +1,56 @@
+///
+/// @file   PrimeCountIndex.hpp
+/// @brief  The prime count index stores pi(x) at checkpoints
+///         x = k * stride. Using the index, counting the primes
+///         inside [start, stop] only requires sieving the numbers
+///         between start, stop and their nearest checkpoints.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef PRIMECOUNTINDEX_HPP
+#define PRIMECOUNTINDEX_HPP
+
+#include "MappedFile.hpp"
+
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace primesieve {
+
+class PrimeCountIndex
+{
+public:
+  /// Memory maps the index file
+  PrimeCountIndex(const std::string& filename);
+  uint64_t getStride() const;
+  uint64_t getLimit() const;
+  uint64_t nearest(uint64_t n, uint64_t* pi) const;
+
+  static uint64_t defaultStride(uint64_t stop);
+  static void write(const std::string& filename,
+                    uint64_t stride,
+                    const Vector<uint64_t>& pi);
+
+  /// The index used by count_primes() and nth_prime()
+  static std::shared_ptr<const PrimeCountIndex> get();
+  static void load(const std::string& filename);
+
+private:
+  uint64_t pi(uint64_t k) const;
+  MappedFile file_;
+  uint64_t stride_ = 0;
+  /// Number of checkpoints
+  uint64_t size_ = 0;
+};
+
+} // namespace
+
+#endif
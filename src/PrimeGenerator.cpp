@@ -111,10 +111,16 @@ const primesieve::Array<uint8_t, 720> primePi =
 
 namespace primesieve {
 
+/// @maxSize: Maximum number of primes returned by fillNextPrimes()
 PrimeGenerator::PrimeGenerator(uint64_t start,
-                               uint64_t stop) :
-  Erat(start, stop)
-{ }
+                               uint64_t stop,
+                               std::size_t maxSize) :
+  Erat(start, stop),
+  maxSize_(maxSize)
+{
+  // fillNextPrimes() requires space for 64 more primes
+  ASSERT(maxSize_ >= 128);
+}
 
 uint64_t PrimeGenerator::maxCachedPrime()
 {
@@ -197,10 +203,15 @@ void PrimeGenerator::initPrevPrimes(Vector<uint64_t>& primes,
 }
 
 /// Used by iterator::next_prime()
-void PrimeGenerator::initNextPrimes(Vector<uint64_t>& primes,
+template <typename T>
+void PrimeGenerator::initNextPrimes(Vector<T>& primes,
                                     std::size_t* size)
 {
-  auto resize = [](Vector<uint64_t>& primes,
+  // 32-bit primes require stop < 2^32
+  ASSERT(sizeof(T) >= sizeof(uint64_t) ||
+         stop_ <= std::numeric_limits<uint32_t>::max());
+
+  auto resize = [](Vector<T>& primes,
                    std::size_t size)
   {
     if (size > primes.size())
@@ -211,9 +222,7 @@ void PrimeGenerator::initNextPrimes(Vector<uint64_t>& primes,
     }
   };
 
-  // A buffer of 1024 primes provides good
-  // performance with little memory usage.
-  std::size_t maxSize = 1 << 10;
+  std::size_t maxSize = maxSize_;
 
   if (start_ <= maxCachedPrime())
   {
@@ -309,7 +318,8 @@ bool PrimeGenerator::sievePrevPrimes(Vector<uint64_t>& primes,
 }
 
 /// Used by iterator::next_prime()
-bool PrimeGenerator::sieveNextPrimes(Vector<uint64_t>& primes,
+template <typename T>
+bool PrimeGenerator::sieveNextPrimes(Vector<T>& primes,
                                      std::size_t* size)
 {
   if (!isInit_)
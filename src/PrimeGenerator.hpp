@@ -6,7 +6,7 @@
 ///         returns the primes. When there are no more primes left in
 ///         the vector PrimeGenerator generates new primes.
 ///
-/// Copyright (C) 2025 Kim Walisch, <kim.walisch@gmail.com>
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
 ///
 /// This file is distributed under the BSD License. See the COPYING
 /// file in the top level directory.
@@ -42,10 +42,14 @@ namespace primesieve {
 class PrimeGenerator : public Erat
 {
 public:
-  PrimeGenerator(uint64_t start, uint64_t stop);
+  PrimeGenerator(uint64_t start, uint64_t stop, std::size_t maxSize);
   static uint64_t maxCachedPrime();
 
-  ALWAYS_INLINE void fillNextPrimes(Vector<uint64_t>& primes, std::size_t* size)
+  /// T must be uint64_t or uint32_t,
+  /// uint32_t requires stop < 2^32.
+  ///
+  template <typename T>
+  ALWAYS_INLINE void fillNextPrimes(Vector<T>& primes, std::size_t* size)
   {
     #if defined(ENABLE_AVX512_VBMI2)
       fillNextPrimes_x86_avx512(primes, size);
@@ -80,7 +84,8 @@ public:
 private:
 
 #if defined(ENABLE_PRIMEGENERATOR_DEFAULT)
-  void fillNextPrimes_default(Vector<uint64_t>& primes, std::size_t* size);
+  template <typename T>
+  void fillNextPrimes_default(Vector<T>& primes, std::size_t* size);
   void fillPrevPrimes_default(Vector<uint64_t>& primes, std::size_t* size);
 #endif
 
@@ -92,6 +97,11 @@ private:
   #endif
   void fillNextPrimes_x86_avx512(Vector<uint64_t>& primes, std::size_t* size);
 
+  #if defined(ENABLE_MULTIARCH_AVX512_VBMI2)
+    __attribute__ ((target ("avx512f,avx512vbmi,avx512vbmi2")))
+  #endif
+  void fillNextPrimes_x86_avx512(Vector<uint32_t>& primes, std::size_t* size);
+
   #if defined(ENABLE_MULTIARCH_AVX512_VBMI2)
     __attribute__ ((target ("avx512f,avx512vbmi,avx512vbmi2")))
   #endif
@@ -100,6 +110,7 @@ private:
 #endif
 
   bool isInit_ = false;
+  std::size_t maxSize_;
   uint64_t low_ = 0;
   uint64_t prime_ = 0;
   uint64_t sieveIdx_ = ~0ull;
@@ -110,9 +121,9 @@ private:
   void initErat();
   void sieveSegment();
   void initPrevPrimes(Vector<uint64_t>&, std::size_t*);
-  void initNextPrimes(Vector<uint64_t>&, std::size_t*);
+  template <typename T> void initNextPrimes(Vector<T>&, std::size_t*);
   bool sievePrevPrimes(Vector<uint64_t>&, std::size_t*);
-  bool sieveNextPrimes(Vector<uint64_t>&, std::size_t*);
+  template <typename T> bool sieveNextPrimes(Vector<T>&, std::size_t*);
 };
 
 } // namespace
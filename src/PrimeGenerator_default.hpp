@@ -31,7 +31,11 @@ namespace primesieve {
 /// this reason iterator::next_prime() runs up to 2x faster
 /// than iterator::prev_prime().
 ///
-void PrimeGenerator::fillNextPrimes_default(Vector<uint64_t>& primes, std::size_t* size)
+/// T = uint32_t is used if stop < 2^32, this
+/// halves the memory traffic of the primes vector.
+///
+template <typename T>
+void PrimeGenerator::fillNextPrimes_default(Vector<T>& primes, std::size_t* size)
 {
   *size = 0;
 
@@ -63,10 +67,10 @@ void PrimeGenerator::fillNextPrimes_default(Vector<uint64_t>& primes, std::size_
 
       do
       {
-        primes[j+0] = nextPrime(bits, low); bits &= bits - 1;
-        primes[j+1] = nextPrime(bits, low); bits &= bits - 1;
-        primes[j+2] = nextPrime(bits, low); bits &= bits - 1;
-        primes[j+3] = nextPrime(bits, low); bits &= bits - 1;
+        primes[j+0] = (T) nextPrime(bits, low); bits &= bits - 1;
+        primes[j+1] = (T) nextPrime(bits, low); bits &= bits - 1;
+        primes[j+2] = (T) nextPrime(bits, low); bits &= bits - 1;
+        primes[j+3] = (T) nextPrime(bits, low); bits &= bits - 1;
         j += 4;
       }
       while (j < i);
@@ -137,6 +141,9 @@ void PrimeGenerator::fillPrevPrimes_default(Vector<uint64_t>& primes, std::size_
   }
 }
 
+template void PrimeGenerator::fillNextPrimes_default<uint64_t>(Vector<uint64_t>&, std::size_t*);
+template void PrimeGenerator::fillNextPrimes_default<uint32_t>(Vector<uint32_t>&, std::size_t*);
+
 } // namespace
 
 #endif
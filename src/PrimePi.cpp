@@ -0,0 +1,715 @@
+///
+/// @file   PrimePi.cpp
+/// @brief  Count the primes <= x using the Lagarias-Miller-Odlyzko
+///         (LMO) algorithm [1]. Counting the primes <= x by sieving
+///         uses O(x) operations, LMO uses O(x^(2/3)) operations.
+///
+///         pi(x) = phi(x, a) + a - 1 - P2(x, a), with y = alpha * x^(1/3),
+///         a = pi(y) and phi(x, a) = S1 + S2, the contributions of
+///         the ordinary and the special leaves [1].
+///
+///         The special leaves S2 are computed using a segmented
+///         sieve of [1, x / y[, after sieving the first b primes
+///         phi(x / n, b) is the number of unsieved numbers
+///         <= x / n. The segments are divided into chunks that are
+///         processed in parallel, each chunk counts its numbers
+///         starting from 0 and the missing phi(low - 1, b) values
+///         of the previous chunks are added when the chunks are
+///         combined (in ascending order).
+///
+///         P2(x, a) = sum pi(x / p) - pi(p) + 1 for y < p <= sqrt(x)
+///         is computed by sieving ]sqrt(x), x / y] in parallel chunks.
+///
+///         All sums are computed modulo 2^64 (using uint64_t), some
+///         partial sums may exceed 2^64 but pi(x) < 2^64.
+///
+///         [1] J. C. Lagarias, V. S. Miller and A. M. Odlyzko,
+///             "Computing pi(x): The Meissel-Lehmer method",
+///             Mathematics of Computation, 44 (1985), 537-560.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "PrimePi.hpp"
+#include "ThreadPool.hpp"
+
+#include <primesieve.hpp>
+#include <primesieve/macros.hpp>
+#include <primesieve/pmath.hpp>
+#include <primesieve/popcnt.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+
+using namespace primesieve;
+
+namespace {
+
+/// The ordinary leaves use phi(x, c) with the
+/// first c = 6 primes 2, 3, 5, 7, 11, 13.
+const int c = 6;
+const uint64_t primorial = 30030;
+const uint64_t phiPrimorial = 5760;
+
+/// Below this limit counting primes using
+/// LMO is not faster than sieving.
+const uint64_t minLMO = (uint64_t) 1e7;
+
+/// Integer cube root of x
+uint64_t icbrt(uint64_t x)
+{
+  uint64_t r = (uint64_t) std::cbrt((double) x);
+
+  // Fix rounding errors, without overflowing
+  while (r > 0 && r > x / r / r)
+    r--;
+  while ((r + 1) <= x / (r + 1) / (r + 1))
+    r++;
+
+  return r;
+}
+
+/// phi(n, c) for n < primorial, the number
+/// of integers <= n coprime to the first c primes.
+///
+Vector<uint16_t> phiTinyTable()
+{
+  Vector<uint16_t> table(primorial);
+  uint16_t count = 0;
+
+  for (uint64_t n = 0; n < primorial; n++)
+  {
+    if (n % 2 && n % 3 && n % 5 && n % 7 && n % 11 && n % 13)
+      count++;
+    table[n] = count;
+  }
+
+  ASSERT(count == phiPrimorial);
+  return table;
+}
+
+uint64_t phiTiny(uint64_t x, const Vector<uint16_t>& table)
+{
+  return (x / primorial) * phiPrimorial + table[x % primorial];
+}
+
+/// Store mu(n) * lpf(n) for n <= y: 0 if n is not square-free,
+/// mu(n) is the Moebius function and lpf(n) is the least prime
+/// factor of n. mu(1) * lpf(1) = INT32_MAX.
+///
+Vector<int32_t> muLpfTable(uint64_t y, const Vector<uint32_t>& primes)
+{
+  Vector<int32_t> muLpf(y + 1);
+  std::fill(muLpf.begin(), muLpf.end(), 1);
+  Vector<uint32_t> lpf(y + 1);
+  std::fill(lpf.begin(), lpf.end(), 0);
+
+  for (std::size_t i = 1; i < primes.size(); i++)
+  {
+    uint64_t p = primes[i];
+
+    for (uint64_t n = p; n <= y; n += p)
+    {
+      muLpf[n] = -muLpf[n];
+      if (lpf[n] == 0)
+        lpf[n] = (uint32_t) p;
+    }
+
+    for (uint64_t n = p * p; n <= y; n += p * p)
+      muLpf[n] = 0;
+  }
+
+  muLpf[1] = std::numeric_limits<int32_t>::max();
+
+  for (uint64_t n = 2; n <= y; n++)
+    muLpf[n] *= (int32_t) lpf[n];
+
+  return muLpf;
+}
+
+/// Sieve of Eratosthenes for the numbers inside [low, high[
+/// that counts the numbers that are not crossed off, i.e. the
+/// numbers coprime to the primes that have been sieved. Only
+/// odd numbers are stored, 1 bit per odd number. The counters
+/// array stores the number of unsieved numbers of each block,
+/// hence counting the unsieved numbers <= n (with ascending n)
+/// only requires counting the bits of a single block.
+///
+class PhiSieve
+{
+public:
+  PhiSieve(uint64_t segmentBits) :
+    sieve_(segmentBits / 64)
+  {
+    blockBits_ = std::max<uint64_t>(64, floorPow2(isqrt(segmentBits)));
+    counters_.resize(ceilDiv(segmentBits, blockBits_));
+  }
+
+  /// Initialize the sieve for [low, high[
+  /// and cross off the first c primes.
+  ///
+  void init(uint64_t low,
+            uint64_t high,
+            const Vector<uint32_t>& primes)
+  {
+    ASSERT(low % 2 == 0);
+    low_ = low;
+    high_ = high;
+    bits_ = (high - low) / 2;
+    ASSERT(bits_ <= sieve_.size() * 64);
+
+    uint64_t words = ceilDiv(bits_, 64);
+    std::fill_n(sieve_.data(), words, ~0ull);
+    if (bits_ % 64)
+      sieve_[words - 1] = (1ull << (bits_ % 64)) - 1;
+
+    // The even numbers are not stored
+    for (int i = 2; i <= c; i++)
+    {
+      uint64_t next = firstMultiple(primes[i]);
+      for (uint64_t prime = primes[i]; next < high; next += prime * 2)
+      {
+        uint64_t bit = (next - low) / 2;
+        sieve_[bit / 64] &= ~(1ull << (bit % 64));
+      }
+    }
+
+    total_ = 0;
+    uint64_t blocks = ceilDiv(bits_, blockBits_);
+
+    for (uint64_t i = 0; i < blocks; i++)
+    {
+      uint64_t start = i * blockBits_ / 64;
+      uint64_t stop = std::min((i + 1) * blockBits_, bits_);
+      stop = ceilDiv(stop, 64);
+      uint64_t count = 0;
+      for (uint64_t w = start; w < stop; w++)
+        count += popcnt64(sieve_[w]);
+      counters_[i] = (uint32_t) count;
+      total_ += count;
+    }
+  }
+
+  /// First odd multiple of prime >= low
+  uint64_t firstMultiple(uint64_t prime) const
+  {
+    uint64_t next = ceilDiv(low_, prime) * prime;
+    next += prime * (~next & 1);
+    return next;
+  }
+
+  /// Cross off the odd multiples of prime,
+  /// @next: The next multiple to cross off.
+  ///
+  void crossOff(uint64_t prime, uint64_t& next)
+  {
+    for (; next < high_; next += prime * 2)
+    {
+      uint64_t bit = (next - low_) / 2;
+      uint64_t mask = 1ull << (bit % 64);
+      uint64_t& word = sieve_[bit / 64];
+
+      if (word & mask)
+      {
+        word &= ~mask;
+        counters_[bit / blockBits_]--;
+        total_--;
+      }
+    }
+  }
+
+  void resetCount()
+  {
+    block_ = 0;
+    blockSum_ = 0;
+  }
+
+  /// Count the unsieved numbers inside [low, n], the
+  /// calls must use ascending n after resetCount().
+  ///
+  uint64_t count(uint64_t n)
+  {
+    ASSERT(n >= low_ && n < high_);
+    uint64_t bits = (n - low_ + 1) / 2;
+    uint64_t block = bits / blockBits_;
+
+    for (; block_ < block; block_++)
+      blockSum_ += counters_[block_];
+
+    uint64_t count = blockSum_;
+    uint64_t w = block * blockBits_ / 64;
+    uint64_t end = bits / 64;
+
+    for (; w < end; w++)
+      count += popcnt64(sieve_[w]);
+    if (bits % 64)
+      count += popcnt64(sieve_[end] & ((1ull << (bits % 64)) - 1));
+
+    return count;
+  }
+
+  /// Number of unsieved numbers inside [low, high[
+  uint64_t total() const
+  {
+    return total_;
+  }
+
+private:
+  uint64_t low_ = 0;
+  uint64_t high_ = 0;
+  uint64_t bits_ = 0;
+  uint64_t total_ = 0;
+  uint64_t blockBits_ = 0;
+  uint64_t block_ = 0;
+  uint64_t blockSum_ = 0;
+  Vector<uint64_t> sieve_;
+  Vector<uint32_t> counters_;
+};
+
+struct LMO
+{
+  uint64_t x;
+  uint64_t y;
+  uint64_t z;
+  /// pi(y)
+  uint64_t a;
+  /// pi(sqrt(y))
+  uint64_t piSqrty;
+  /// 1-indexed, primes[1] = 2
+  Vector<uint32_t> primes;
+  Vector<int32_t> muLpf;
+};
+
+/// The special leaves of a chunk of segments. For each b the
+/// chunk's leaves miss mu(m) * phi(low - 1, b - 1) where
+/// phi(low - 1, b - 1) is the count of the previous chunks.
+///
+struct S2Chunk
+{
+  uint64_t low = 0;
+  uint64_t high = 0;
+  uint64_t s2 = 0;
+  /// Sum of mu(m) of the chunk's leaves of each b
+  Vector<int64_t> muSum;
+  /// Number of unsieved numbers of the chunk for each b
+  Vector<uint64_t> phi;
+};
+
+/// Largest prime index l with primes[l] <= n
+uint64_t primePi(const Vector<uint32_t>& primes, uint64_t n)
+{
+  return std::upper_bound(primes.begin() + 1, primes.end(), n) - primes.begin() - 1;
+}
+
+/// Compute the special leaves with x / n inside [low, high[
+void S2Segments(const LMO& lmo,
+                PhiSieve& sieve,
+                S2Chunk& chunk,
+                uint64_t segmentSize)
+{
+  const uint64_t x = lmo.x;
+  const uint64_t y = lmo.y;
+  const Vector<uint32_t>& primes = lmo.primes;
+  const Vector<int32_t>& muLpf = lmo.muLpf;
+  uint64_t s2 = 0;
+
+  // Indexes <= c are unused
+  Vector<uint64_t> next(c + 1);
+  chunk.muSum.resize(c + 1);
+  chunk.phi.resize(c + 1);
+  std::fill(chunk.muSum.begin(), chunk.muSum.end(), 0);
+  std::fill(chunk.phi.begin(), chunk.phi.end(), 0);
+
+  for (uint64_t low = chunk.low; low < chunk.high; low += segmentSize)
+  {
+    uint64_t high = std::min(low + segmentSize, chunk.high);
+    sieve.init(low, high, primes);
+    uint64_t b = c + 1;
+
+    // For c + 1 <= b <= pi(sqrt(y)) the special
+    // leaves are n = primes[b] * m with mu(m) != 0,
+    // lpf(m) > primes[b] and low <= x / n < high.
+    for (uint64_t end = std::min(lmo.piSqrty, lmo.a - 1); b <= end; b++)
+    {
+      uint64_t prime = primes[b];
+      uint64_t xp = x / prime;
+      uint64_t maxM = std::min(xp / std::max<uint64_t>(low, 1), y);
+
+      // There are no leaves for b and larger b
+      // in this segment and the next segments.
+      if (prime >= maxM)
+        goto nextSegment;
+
+      uint64_t minM = std::max(xp / high, y / prime);
+
+      if (b >= next.size())
+      {
+        next.push_back(sieve.firstMultiple(prime));
+        chunk.muSum.push_back(0);
+        chunk.phi.push_back(0);
+      }
+
+      sieve.resetCount();
+
+      for (uint64_t m = maxM; m > minM; m--)
+      {
+        int32_t ml = muLpf[m];
+
+        if ((uint64_t) std::abs((int64_t) ml) > prime)
+        {
+          uint64_t phi = chunk.phi[b] + sieve.count(xp / m);
+
+          if (ml > 0)
+          {
+            s2 -= phi;
+            chunk.muSum[b]++;
+          }
+          else
+          {
+            s2 += phi;
+            chunk.muSum[b]--;
+          }
+        }
+      }
+
+      chunk.phi[b] += sieve.total();
+      sieve.crossOff(prime, next[b]);
+    }
+
+    // For pi(sqrt(y)) < b < pi(y) the special leaves
+    // are n = primes[b] * primes[l] with l > b and
+    // low <= x / n < high, mu(primes[l]) = -1.
+    for (; b < lmo.a; b++)
+    {
+      uint64_t prime = primes[b];
+      uint64_t xp = x / prime;
+      uint64_t maxM = std::min(xp / std::max<uint64_t>(low, 1), y);
+
+      if (prime >= maxM)
+        goto nextSegment;
+
+      uint64_t minM = std::max(xp / high, prime);
+      uint64_t l = primePi(primes, maxM);
+
+      if (b >= next.size())
+      {
+        next.push_back(sieve.firstMultiple(prime));
+        chunk.muSum.push_back(0);
+        chunk.phi.push_back(0);
+      }
+
+      sieve.resetCount();
+
+      for (; primes[l] > minM; l--)
+      {
+        s2 += chunk.phi[b] + sieve.count(xp / primes[l]);
+        chunk.muSum[b]--;
+      }
+
+      chunk.phi[b] += sieve.total();
+      sieve.crossOff(prime, next[b]);
+    }
+
+    nextSegment:;
+  }
+
+  chunk.s2 = s2;
+}
+
+/// Compute the special leaves S2 using a segmented sieve of
+/// [0, z[. Each round processes one chunk per thread, the
+/// chunks are combined in ascending order.
+///
+uint64_t S2(const LMO& lmo, int threads)
+{
+  uint64_t z = lmo.z;
+  uint64_t segmentBits = inBetween(1 << 12, floorPow2(isqrt(z)), 1 << 19);
+  uint64_t segmentSize = segmentBits * 2;
+  uint64_t segments = ceilDiv(z, segmentSize);
+  uint64_t chunkSegments = 1;
+  threads = (int) inBetween(1, threads, segments);
+
+  Vector<uint64_t> phi(lmo.a + 1);
+  std::fill(phi.begin(), phi.end(), 0);
+  Vector<S2Chunk> chunks(threads);
+  uint64_t s2 = 0;
+  uint64_t low = 0;
+
+  while (low < z)
+  {
+    auto t1 = std::chrono::steady_clock::now();
+
+    for (auto& chunk : chunks)
+    {
+      chunk.low = low;
+      chunk.high = std::min(z, low + chunkSegments * segmentSize);
+      chunk.s2 = 0;
+      chunk.muSum.clear();
+      chunk.phi.clear();
+      low = chunk.high;
+    }
+
+    INDETERMINATE RelaxedAtomic<int> chunkIds(0);
+
+    auto task = [&]()
+    {
+      S2Chunk& chunk = chunks[chunkIds++];
+      if (chunk.low < chunk.high)
+      {
+        PhiSieve sieve(segmentBits);
+        S2Segments(lmo, sieve, chunk, segmentSize);
+      }
+    };
+
+    if (threads == 1)
+      task();
+    else
+      runParallel(threads, task);
+
+    for (auto& chunk : chunks)
+    {
+      s2 += chunk.s2;
+      for (std::size_t b = 0; b < chunk.muSum.size(); b++)
+      {
+        s2 -= phi[b] * (uint64_t) chunk.muSum[b];
+        phi[b] += chunk.phi[b];
+      }
+    }
+
+    // Increase the chunk size while the
+    // rounds take less than 0.1 seconds.
+    auto t2 = std::chrono::steady_clock::now();
+    std::chrono::duration<double> seconds = t2 - t1;
+    if (seconds.count() < 0.1)
+      chunkSegments *= 2;
+  }
+
+  return s2;
+}
+
+/// The ordinary leaves: sum mu(n) * phi(x / n, c)
+/// for n <= y with lpf(n) > primes[c].
+///
+uint64_t S1(const LMO& lmo)
+{
+  Vector<uint16_t> table = phiTinyTable();
+  uint64_t pc = lmo.primes[c];
+  uint64_t s1 = 0;
+
+  for (uint64_t n = 1; n <= lmo.y; n++)
+  {
+    int32_t ml = lmo.muLpf[n];
+
+    if ((uint64_t) std::abs((int64_t) ml) > pc)
+    {
+      uint64_t phi = phiTiny(lmo.x / n, table);
+      if (ml > 0)
+        s1 += phi;
+      else
+        s1 -= phi;
+    }
+  }
+
+  return s1;
+}
+
+struct P2Chunk
+{
+  /// Primes y < p <= sqrt(x) inside ]pLow, pHigh]
+  uint64_t pLow;
+  uint64_t pHigh;
+  /// Sum of pi(x / p) - pi(x / (pHigh + 1))
+  uint64_t sum;
+  /// Number of primes p
+  uint64_t primes;
+  /// Number of primes inside ]x / (pHigh + 1), x / (pLow + 1)]
+  uint64_t count;
+};
+
+/// For each prime p inside ]pLow, pHigh] count the primes
+/// inside ]x / (pHigh + 1), x / p]. The primes p are
+/// iterated in descending order, hence x / p is ascending.
+///
+void p2Chunk(uint64_t x, P2Chunk& chunk)
+{
+  uint64_t low = x / (chunk.pHigh + 1);
+  uint64_t high = x / (chunk.pLow + 1);
+  primesieve::iterator rit(chunk.pHigh, chunk.pLow);
+  primesieve::iterator it(low + 1, high);
+  uint64_t prime = it.next_prime();
+  uint64_t count = 0;
+  chunk.sum = 0;
+  chunk.primes = 0;
+
+  for (uint64_t p = rit.prev_prime(); p > chunk.pLow; p = rit.prev_prime())
+  {
+    uint64_t xp = x / p;
+    for (; prime <= xp; prime = it.next_prime())
+      count++;
+
+    chunk.sum += count;
+    chunk.primes++;
+  }
+
+  for (; prime <= high; prime = it.next_prime())
+    count++;
+
+  chunk.count = count;
+}
+
+/// P2(x, a) = sum pi(x / p) - pi(p) + 1 for y < p <= sqrt(x).
+/// The primes p are split into chunks of about the same
+/// sieving distance of x / p.
+///
+uint64_t P2(const LMO& lmo, int threads)
+{
+  uint64_t x = lmo.x;
+  uint64_t y = lmo.y;
+  uint64_t sqrtx = isqrt(x);
+
+  if (y >= sqrtx)
+    return 0;
+
+  uint64_t dist = x / (y + 1) - x / (sqrtx + 1);
+  uint64_t chunkDist = std::max<uint64_t>(dist / (threads * 8), (uint64_t) 1e8);
+  Vector<P2Chunk> chunks;
+
+  for (uint64_t pHigh = sqrtx; pHigh > y;)
+  {
+    uint64_t low = x / (pHigh + 1);
+    uint64_t pLow = x / (low + chunkDist);
+    pLow = inBetween(y, pLow, pHigh - 1);
+    chunks.push_back(P2Chunk{pLow, pHigh, 0, 0, 0});
+    pHigh = pLow;
+  }
+
+  INDETERMINATE RelaxedAtomic<std::size_t> chunkIds(0);
+
+  auto task = [&]()
+  {
+    std::size_t i;
+    while ((i = chunkIds++) < chunks.size())
+      p2Chunk(x, chunks[i]);
+  };
+
+  threads = (int) inBetween(1, threads, chunks.size());
+
+  if (threads == 1)
+    task();
+  else
+    runParallel(threads, task);
+
+  // pi(x / p) = pi(x / (pHigh + 1)) + chunk count
+  uint64_t pix = count_primes(0, x / (sqrtx + 1));
+  uint64_t primes = 0;
+  uint64_t p2 = 0;
+
+  for (const auto& chunk : chunks)
+  {
+    p2 += chunk.sum + chunk.primes * pix;
+    pix += chunk.count;
+    primes += chunk.primes;
+  }
+
+  // Subtract sum pi(p) - 1 = sum of a + i for 0 <= i < primes
+  uint64_t k = primes;
+  uint64_t triangle = (k % 2 == 0) ? (k / 2) * (k - 1) : k * ((k - 1) / 2);
+  p2 -= k * lmo.a + triangle;
+
+  return p2;
+}
+
+/// The alpha tuning factor balances the computation of the
+/// special leaves (faster for large alpha) and of P2 (faster
+/// for small alpha). y = alpha * x^(1/3) must be < sqrt(x).
+///
+double getAlpha(uint64_t x)
+{
+  double logx = std::log((double) x);
+  double alpha = 0.004 * logx * logx;
+  return inBetween(1.0, alpha, 30.0);
+}
+
+} // namespace
+
+namespace primesieve {
+
+uint64_t primePiLMO(uint64_t x, int threads)
+{
+  return primePiLMO(x, getAlpha(x), threads);
+}
+
+/// Count the primes <= x using the LMO algorithm
+uint64_t primePiLMO(uint64_t x, double alpha, int threads)
+{
+  if (x < minLMO)
+    return count_primes(0, x);
+
+  LMO lmo;
+  lmo.x = x;
+  uint64_t cbrtx = icbrt(x);
+  uint64_t sqrtx = isqrt(x);
+  lmo.y = (uint64_t) (cbrtx * std::max(alpha, 1.0));
+  lmo.y = inBetween(cbrtx, lmo.y, sqrtx - 1);
+  // Limit the memory usage of the muLpf array
+  lmo.y = std::min<uint64_t>(lmo.y, 1 << 26);
+  lmo.z = x / lmo.y + 1;
+
+  lmo.primes.push_back(0);
+  generate_primes(lmo.y, &lmo.primes);
+  lmo.a = lmo.primes.size() - 1;
+  lmo.piSqrty = primePi(lmo.primes, isqrt(lmo.y));
+  lmo.muLpf = muLpfTable(lmo.y, lmo.primes);
+
+  uint64_t s1 = S1(lmo);
+  uint64_t s2 = S2(lmo, threads);
+  uint64_t p2 = P2(lmo, threads);
+  uint64_t phi = s1 + s2;
+
+  return phi + lmo.a - 1 - p2;
+}
+
+/// Cost of counting the primes inside [start, stop] as
+/// pi(stop) - pi(start - 1) using LMO, in units of the cost of
+/// sieving a number. Sieving [start, stop] costs stop - start.
+/// Returns infinity if LMO is not used for stop < minLMO.
+///
+double primePiLMOCost(uint64_t start, uint64_t stop)
+{
+  if (stop < minLMO)
+    return std::numeric_limits<double>::infinity();
+
+  auto cost = [](uint64_t x)
+  {
+    // Counting the primes <= minLMO is fast
+    if (x < minLMO)
+      return (double) x;
+
+    // LMO's cost relative to sieving
+    double c = 25;
+    return c * std::pow((double) x, 2.0 / 3.0);
+  };
+
+  return cost(stop) + ((start > 1) ? cost(start - 1) : 0);
+}
+
+/// Counting the primes inside [start, stop] as pi(stop) -
+/// pi(start - 1) using LMO is faster than sieving if
+/// stop^(2/3) (+ start^(2/3)) is much smaller than
+/// stop - start.
+///
+bool isPrimePiLMOFaster(uint64_t start, uint64_t stop)
+{
+  return primePiLMOCost(start, stop) < (double) (stop - start);
+}
+
+} // namespace
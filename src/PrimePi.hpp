@@ -0,0 +1,27 @@
+///
+/// @file   PrimePi.hpp
+/// @brief  Count the primes <= x using the combinatorial
+///         Lagarias-Miller-Odlyzko algorithm in O(x^(2/3))
+///         operations instead of sieving in O(x) operations.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef PRIMEPI_HPP
+#define PRIMEPI_HPP
+
+#include <stdint.h>
+
+namespace primesieve {
+
+uint64_t primePiLMO(uint64_t x, int threads);
+uint64_t primePiLMO(uint64_t x, double alpha, int threads);
+double primePiLMOCost(uint64_t start, uint64_t stop);
+bool isPrimePiLMOFaster(uint64_t start, uint64_t stop);
+
+} // namespace
+
+#endif
@@ -13,18 +13,28 @@
 #include "PrimeSieveClass.hpp"
 #include "ParallelSieve.hpp"
 #include "CountPrintPrimes.hpp"
+#include "OutputFile.hpp"
+#include "PrintFormat.hpp"
 
 #include <primesieve/forward.hpp>
 #include <primesieve/macros.hpp>
 #include <primesieve/pmath.hpp>
+#include <primesieve/primesieve_error.hpp>
 #include <primesieve/Vector.hpp>
 
 #include <stdint.h>
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 #include <string>
 
+#if defined(_WIN32)
+  #include <fcntl.h>
+  #include <io.h>
+#endif
+
 namespace {
 
 struct SmallPrime
@@ -61,6 +71,11 @@ PrimeSieve::PrimeSieve()
 PrimeSieve::PrimeSieve(ParallelSieve* parent) :
   flags_(parent->flags_),
   sieveSize_(parent->sieveSize_),
+  printFormat_(parent->printFormat_),
+  outputFile_(parent->outputFile_),
+  histogram_(parent->histogram_),
+  histogramStart_(parent->histogramStart_),
+  histogramWidth_(parent->histogramWidth_),
   parent_(parent)
 { }
 
@@ -70,6 +85,7 @@ void PrimeSieve::reset()
   percent_ = -1.0;
   seconds_ = 0.0;
   sievedDistance_ = 0;
+  prevPrime_ = 0;
 }
 
 bool PrimeSieve::isFlag(int flag) const
@@ -156,6 +172,16 @@ int PrimeSieve::getSieveSize() const
   return sieveSize_;
 }
 
+int PrimeSieve::getPrintFormat() const
+{
+  return printFormat_;
+}
+
+uint64_t PrimeSieve::getPrevPrime() const
+{
+  return prevPrime_;
+}
+
 double PrimeSieve::getSeconds() const
 {
   return seconds_;
@@ -171,6 +197,74 @@ void PrimeSieve::addFlags(int flags)
   flags_ |= flags;
 }
 
+void PrimeSieve::setPrintBuffer(Vector<char>* printBuffer)
+{
+  printBuffer_ = printBuffer;
+}
+
+Vector<char>* PrimeSieve::getPrintBuffer() const
+{
+  return printBuffer_;
+}
+
+void PrimeSieve::setOutputFile(OutputFile* outputFile)
+{
+  outputFile_ = outputFile;
+}
+
+/// Print to the output file or to stdout
+void PrimeSieve::write(const char* data, std::size_t size)
+{
+  if (outputFile_)
+    outputFile_->write(data, size);
+  else
+    std::cout.write(data, size);
+}
+
+void PrimeSieve::setSievingPrimes(const SharedSievingPrimes* sievingPrimes)
+{
+  sievingPrimes_ = sievingPrimes;
+}
+
+const SharedSievingPrimes* PrimeSieve::getSievingPrimes() const
+{
+  return sievingPrimes_;
+}
+
+/// Count the primes and prime k-tuplets per bucket instead of
+/// counting them in total, bucket i is [start + i * width,
+/// start + (i + 1) * width - 1]. A prime k-tuplet is counted
+/// if all its primes are inside the same bucket.
+///
+void PrimeSieve::setHistogram(Vector<counts_t>* histogram,
+                              uint64_t start,
+                              uint64_t width)
+{
+  ASSERT(!histogram || width > 0);
+  histogram_ = histogram;
+  histogramStart_ = start;
+  histogramWidth_ = width;
+}
+
+Vector<counts_t>* PrimeSieve::getHistogram() const
+{
+  return histogram_;
+}
+
+/// Index of the histogram bucket that contains n
+uint64_t PrimeSieve::getBucket(uint64_t n) const
+{
+  ASSERT(n >= histogramStart_);
+  return (n - histogramStart_) / histogramWidth_;
+}
+
+/// Last number of the histogram bucket
+uint64_t PrimeSieve::getBucketStop(uint64_t bucket) const
+{
+  uint64_t low = histogramStart_ + bucket * histogramWidth_;
+  return checkedAdd(low, histogramWidth_ - 1);
+}
+
 void PrimeSieve::setStart(uint64_t start)
 {
   start_ = start;
@@ -187,6 +281,39 @@ void PrimeSieve::setSieveSize(int sieveSize)
   sieveSize_ = inBetween(16, sieveSize, 8192);
 }
 
+void PrimeSieve::setPrintFormat(int printFormat)
+{
+  if (printFormat < TEXT_FORMAT ||
+      printFormat > GAPS_FORMAT)
+    throw primesieve_error("invalid print format " + std::to_string(printFormat));
+
+  printFormat_ = printFormat;
+}
+
+void PrimeSieve::setPrevPrime(uint64_t prevPrime)
+{
+  prevPrime_ = prevPrime;
+}
+
+/// The binary formats are only supported for printing primes.
+/// On Windows stdout is switched to binary mode as otherwise
+/// each 0x0A byte would be converted to "\r\n".
+///
+void PrimeSieve::checkPrintFormat() const
+{
+  if (printFormat_ == TEXT_FORMAT || !isPrint())
+    return;
+  if (isPrintkTuplets())
+    throw primesieve_error("binary print formats are only supported for primes, not for prime k-tuplets");
+  if (printFormat_ == UINT32_FORMAT && stop_ > 0xffffffffull)
+    throw primesieve_error("UINT32_FORMAT requires stop < 2^32");
+
+#if defined(_WIN32)
+  std::cout.flush();
+  _setmode(_fileno(stdout), _O_BINARY);
+#endif
+}
+
 void PrimeSieve::setStatus(double percent)
 {
   if (!parent_)
@@ -257,9 +384,44 @@ void PrimeSieve::processSmallPrimes()
     if (p.first >= start_ && p.last <= stop_)
     {
       if (isCount(p.index))
-        counts_[p.index]++;
+      {
+        if (!histogram_)
+          counts_[p.index]++;
+        else if (getBucket(p.first) == getBucket(p.last))
+          (*histogram_)[getBucket(p.first)][p.index]++;
+      }
+
       if (isPrint(p.index))
-        std::cout << p.str << '\n';
+      {
+        if (printFormat_ != TEXT_FORMAT)
+        {
+          char bytes[MAX_PRIME_BYTES];
+          char* end;
+
+          switch (printFormat_)
+          {
+            case UINT32_FORMAT: end = write_prime_uint32(bytes, p.first); break;
+            case UINT64_FORMAT: end = write_prime_uint64(bytes, p.first); break;
+            default: end = write_prime_gap(bytes, p.first, prevPrime_); break;
+          }
+
+          if (printBuffer_)
+            printBuffer_->insert(printBuffer_->end(), bytes, end);
+          else
+            write(bytes, end - bytes);
+        }
+        else if (printBuffer_)
+        {
+          const char* str = p.str;
+          printBuffer_->insert(printBuffer_->end(), str, str + std::strlen(str));
+          printBuffer_->push_back('\n');
+        }
+        else
+        {
+          std::string str = std::string(p.str) + '\n';
+          write(str.data(), str.size());
+        }
+      }
     }
   }
 }
@@ -295,6 +457,9 @@ void PrimeSieve::sieve()
   if (start_ > stop_)
     return;
 
+  if (!parent_)
+    checkPrintFormat();
+
   setStatus(0);
   auto t1 = std::chrono::steady_clock::now();
 
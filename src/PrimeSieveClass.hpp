@@ -13,17 +13,21 @@
 #ifndef PRIMESIEVE_CLASS_HPP
 #define PRIMESIEVE_CLASS_HPP
 
+#include <primesieve.hpp>
 #include <primesieve/config.hpp>
 #include <primesieve/macros.hpp>
 #include <primesieve/Vector.hpp>
 
 #include <stdint.h>
 #include <chrono>
+#include <cstddef>
 
 namespace primesieve {
 
 using counts_t = Array<uint64_t, 6>;
+class OutputFile;
 class ParallelSieve;
+class SharedSievingPrimes;
 
 enum
 {
@@ -53,14 +57,28 @@ public:
   uint64_t getStop() const;
   uint64_t getDistance() const;
   int getSieveSize() const;
+  int getPrintFormat() const;
+  uint64_t getPrevPrime() const;
   double getSeconds() const;
   // Setters
   void setStart(uint64_t);
   void setStop(uint64_t);
   void updateStatus(uint64_t);
   void setSieveSize(int);
+  void setPrintFormat(int);
+  void setPrevPrime(uint64_t);
   void setFlags(int);
   void addFlags(int);
+  void setPrintBuffer(Vector<char>*);
+  Vector<char>* getPrintBuffer() const;
+  void setOutputFile(OutputFile*);
+  void write(const char*, std::size_t);
+  void setSievingPrimes(const SharedSievingPrimes*);
+  const SharedSievingPrimes* getSievingPrimes() const;
+  void setHistogram(Vector<counts_t>*, uint64_t, uint64_t);
+  Vector<counts_t>* getHistogram() const;
+  uint64_t getBucket(uint64_t) const;
+  uint64_t getBucketStop(uint64_t) const;
   // Bool is*
   bool isCount(int) const;
   bool isCountPrimes() const;
@@ -87,6 +105,7 @@ public:
 
 protected:
   void reset();
+  void checkPrintFormat() const;
   void setStatus(double);
 
   /// Sieve primes >= start_
@@ -108,6 +127,28 @@ private:
   int flags_ = COUNT_PRIMES;
   /// Sieve size in KiB
   int sieveSize_ = 0;
+  /// PrintFormat used for printing primes
+  int printFormat_ = TEXT_FORMAT;
+  /// Previous printed prime of the GAPS_FORMAT,
+  /// 0 if no prime has been printed yet.
+  uint64_t prevPrime_ = 0;
+  /// Used for ordered multi-threaded printing, if not
+  /// nullptr primes are appended to this buffer
+  /// instead of being printed to stdout.
+  Vector<char>* printBuffer_ = nullptr;
+  /// If not nullptr primes are printed to
+  /// this file instead of stdout.
+  OutputFile* outputFile_ = nullptr;
+  /// Used by ParallelSieve, if not nullptr the sieving
+  /// primes are read from this shared array instead
+  /// of being generated for each sieve() call.
+  const SharedSievingPrimes* sievingPrimes_ = nullptr;
+  /// If not nullptr the primes and prime k-tuplets are
+  /// counted per bucket of histogramWidth_ numbers, bucket i
+  /// starts at histogramStart_ + i * histogramWidth_.
+  Vector<counts_t>* histogram_ = nullptr;
+  uint64_t histogramStart_ = 0;
+  uint64_t histogramWidth_ = 0;
   /// Status updates must be synchronized by main thread
   ParallelSieve* parent_ = nullptr;
   MAYBE_UNUSED char pad1_[config::MAX_CACHE_LINE_SIZE];
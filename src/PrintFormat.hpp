@@ -0,0 +1,248 @@
+///
+/// @file   PrintFormat.hpp
+/// @brief  Formats used for printing primes. Each function writes
+///         a prime to the char pointer p and returns the new end.
+///         The caller must ensure that p has room for at least
+///         MAX_PRIME_BYTES bytes.
+///
+///         TEXT_FORMAT: Each prime is written as decimal text
+///         followed by '\n', see DecimalPrinter.
+///
+///         UINT32_FORMAT: Each prime is written as a 4 byte
+///         little-endian unsigned integer, requires stop < 2^32.
+///
+///         UINT64_FORMAT: Each prime is written as an 8 byte
+///         little-endian unsigned integer.
+///
+///         GAPS_FORMAT: Each prime is written as (prime - prev) / 2
+///         using a LEB128 varint, i.e. 7 bits per byte with the
+///         high bit set if more bytes follow. Prime gaps < 256
+///         take up a single byte. The varint 0 is an escape code
+///         that is followed by the varint of the absolute prime.
+///         The escape code is only used for the first prime of
+///         the output and for the odd gap 3 - 2. Each chunk
+///         printed by a thread starts with an absolute prime,
+///         the ordered writer replaces it by the gap to the
+///         last prime of the previous chunk. Hence the output
+///         does not depend on the number of threads.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef PRINTFORMAT_HPP
+#define PRINTFORMAT_HPP
+
+#include <primesieve/macros.hpp>
+#include <primesieve/util.hpp>
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+
+namespace primesieve {
+
+/// DecimalPrinter copies 16 prefix bytes per prime, hence
+/// it requires more than the 20 digits + '\n' of a prime.
+///
+constexpr std::size_t MAX_PRIME_BYTES = 32;
+
+ALWAYS_INLINE char* write_prime_uint32(char* p, uint64_t prime)
+{
+  for (int i = 0; i < 4; i++)
+    p[i] = (char) (prime >> (i * 8));
+
+  return p + 4;
+}
+
+ALWAYS_INLINE char* write_prime_uint64(char* p, uint64_t prime)
+{
+  for (int i = 0; i < 8; i++)
+    p[i] = (char) (prime >> (i * 8));
+
+  return p + 8;
+}
+
+/// Write n as LEB128 varint
+ALWAYS_INLINE char* write_varint(char* p, uint64_t n)
+{
+  for (; n >= 0x80; n >>= 7)
+    *p++ = (char) (n | 0x80);
+
+  *p++ = (char) n;
+  return p;
+}
+
+/// @prev: Previous prime or 0 if this
+///        is the first prime of the output.
+///
+ALWAYS_INLINE char* write_prime_gap(char* p,
+                                    uint64_t prime,
+                                    uint64_t& prev)
+{
+  uint64_t gap = prime - prev;
+
+  if_unlikely(prev == 0 || (gap & 1))
+  {
+    *p++ = 0;
+    p = write_varint(p, prime);
+  }
+  else
+    p = write_varint(p, gap / 2);
+
+  prev = prime;
+  return p;
+}
+
+/// GAPS_FORMAT data printed by a single sieve() call starts
+/// with an absolute prime. If the data is printed directly
+/// after the prime prev, its first prime is rewritten as the
+/// gap to prev. Writes the new first prime to p and returns
+/// the number of bytes of data that it replaces.
+///
+inline std::size_t rewrite_first_gap(const char* data,
+                                     std::size_t size,
+                                     char*& p,
+                                     uint64_t prev)
+{
+  ASSERT(size >= 2 && data[0] == 0);
+  uint64_t prime = 0;
+  std::size_t i = 1;
+
+  for (int shift = 0; i < size; shift += 7)
+  {
+    uint64_t byte = (unsigned char) data[i++];
+    prime |= (byte & 0x7f) << shift;
+    if (byte < 0x80)
+      break;
+  }
+
+  p = write_prime_gap(p, prime, prev);
+  return i;
+}
+
+/// Pairs of decimal digits: "00", "01", ..., "99"
+constexpr char digitPairs[] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+/// Number of decimal digits of n
+inline int count_digits(uint64_t n)
+{
+  int digits = 1;
+  for (; n >= 10; n /= 10)
+    digits++;
+  return digits;
+}
+
+/// Write the lowest ndigits decimal digits
+/// of n (with leading zeros) to p.
+///
+ALWAYS_INLINE void write_digits(char* p, uint64_t n, int ndigits)
+{
+  for (; ndigits >= 2; ndigits -= 2)
+  {
+    std::memcpy(&p[ndigits - 2], &digitPairs[(n % 100) * 2], 2);
+    n /= 100;
+  }
+
+  if (ndigits)
+    p[0] = (char) ('0' + n % 10);
+}
+
+/// Convert n < 10^8 into 8 ASCII digits (with leading zeros)
+/// packed into a uint64_t, the first digit is in the lowest
+/// byte. All digits are computed in parallel using SWAR
+/// (SIMD within a register) arithmetic: n is split into
+/// 2 x 4 digits, then into 4 x 2 digits, then into 8 x 1
+/// digit, each split uses a multiplication by the inverse of
+/// 10^k instead of a division. There are no table lookups.
+///
+ALWAYS_INLINE uint64_t encode_8_digits(uint32_t n)
+{
+  uint64_t high4 = n / 10000;
+  uint64_t low4 = n % 10000;
+  uint64_t x = high4 | (low4 << 32);
+
+  // x / 100, 10486 / 2^20 ~ 1 / 100
+  uint64_t top = ((x * 10486) >> 20) & 0x0000007F0000007Full;
+  uint64_t bottom = x - 100 * top;
+  x = (bottom << 16) | top;
+
+  // x / 10, 103 / 2^10 ~ 1 / 10
+  top = ((x * 103) >> 10) & 0x000F000F000F000Full;
+  bottom = x - 10 * top;
+  x = (bottom << 8) | top;
+
+  return x | 0x3030303030303030ull;
+}
+
+/// Converting each prime to decimal text using std::to_chars() is
+/// slow. But the primes of a segment share their high digits:
+/// prime = high * 10^8 + low. The high digits are only converted
+/// when they change (once per 10^8 numbers), for each prime we
+/// copy the high digits and convert the 8 low digits using
+/// encode_8_digits().
+///
+class DecimalPrinter
+{
+public:
+  ALWAYS_INLINE char* write(char* p, uint64_t prime)
+  {
+    uint64_t low = prime - base_;
+
+    // Also true if prime < base_
+    if_unlikely(low >= LOW_LIMIT)
+    {
+      init(prime);
+      low = prime - base_;
+    }
+
+    if_unlikely(prefixSize_ == 0)
+    {
+      int digits = count_digits(low);
+      write_digits(p, low, digits);
+      p += digits;
+    }
+    else
+    {
+      // Copy a fixed size of 16 bytes,
+      // this is faster than prefixSize_ bytes.
+      std::memcpy(p, prefix_, sizeof(prefix_));
+      p += prefixSize_;
+
+      uint64_t digits = encode_8_digits((uint32_t) low);
+      digits = to_littleendian(digits);
+      std::memcpy(p, &digits, sizeof(digits));
+      p += 8;
+    }
+
+    *p++ = '\n';
+    return p;
+  }
+
+private:
+  static constexpr uint64_t LOW_LIMIT = 100000000;
+
+  void init(uint64_t prime)
+  {
+    uint64_t high = prime / LOW_LIMIT;
+    base_ = high * LOW_LIMIT;
+    prefixSize_ = (high > 0) ? count_digits(high) : 0;
+    write_digits(prefix_, high, prefixSize_);
+  }
+
+  uint64_t base_ = 0;
+  /// 2^64 / 10^8 has 12 digits
+  char prefix_[16] = { };
+  int prefixSize_ = 0;
+};
+
+} // namespace
+
+#endif
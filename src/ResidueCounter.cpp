@@ -0,0 +1,249 @@
+///
+/// @file   ResidueCounter.cpp
+/// @brief  Count the primes inside [start, stop] in each residue
+///         class modulo q using a single sieving pass. The bit
+///         with index b of the sieve word i of a segment corresponds
+///         to the number low + i * 240 + bitValues[b], hence its
+///         residue is (low % q + i * 240 % q + bitValues[b] % q) % q.
+///
+///         If the 64 bits of a sieve word belong to only few distinct
+///         residue classes (e.g. q = 3, 4, 10, 12, 30) the 1 bits
+///         of each residue class are counted using popcount() on
+///         the masked sieve words, the primes are not extracted.
+///         The residues of the sieve words repeat after
+///         q / gcd(q, 240) words. Otherwise the primes are extracted
+///         from the sieve words and their residues are computed
+///         incrementally without any division.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "ResidueCounter.hpp"
+
+#include <primesieve/forward.hpp>
+#include <primesieve/ctz.hpp>
+#include <primesieve/macros.hpp>
+#include <primesieve/popcnt.hpp>
+#include <primesieve/primesieve_error.hpp>
+#include <primesieve/util.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+/// Use the masked popcount() algorithm if the bits of a
+/// sieve word belong to at most maxGroups residue classes.
+/// Counting the primes of a sieve word then costs at most
+/// maxGroups popcount() instructions, this is faster than
+/// extracting the primes (about 8 - 12 primes per word
+/// for numbers < 10^12).
+///
+const std::size_t maxGroups = 10;
+
+/// Each thread counts the primes in its own array of q
+/// counters. For large q the number of threads is reduced
+/// so that these arrays use at most maxLocalBytes.
+///
+const uint64_t maxLocalBytes = 1ull << 30;
+
+uint64_t gcd(uint64_t a, uint64_t b)
+{
+  while (b != 0)
+  {
+    uint64_t r = a % b;
+    a = b;
+    b = r;
+  }
+
+  return a;
+}
+
+} // namespace
+
+namespace primesieve {
+
+ResidueCounter::ResidueCounter(uint64_t start,
+                               uint64_t stop,
+                               uint64_t q) :
+  start_(start),
+  stop_(stop),
+  q_(q)
+{
+  if (q == 0)
+    throw primesieve_error("modulus q must be > 0");
+  if (q > MAX_MODULUS)
+    throw primesieve_error("modulus q must be <= 2^24");
+
+  period_ = q / gcd(q, 240);
+  bitResidues_.resize(64);
+
+  for (std::size_t bit = 0; bit < 64; bit++)
+  {
+    uint64_t residue = bitValues[bit] % q;
+    bitResidues_[bit] = residue;
+
+    auto group = std::find_if(groups_.begin(), groups_.end(),
+      [&](const Group& g) { return g.residue == residue; });
+
+    if (group != groups_.end())
+      group->mask |= 1ull << bit;
+    else
+      groups_.push_back(Group{1ull << bit, residue});
+  }
+
+  if (groups_.size() > maxGroups)
+    groups_.clear();
+}
+
+/// (a + b) % q with a < q and b < q, a + b may overflow
+uint64_t ResidueCounter::addMod(uint64_t a, uint64_t b) const
+{
+  return (a >= q_ - b) ? a - (q_ - b) : a + b;
+}
+
+/// Maximum number of threads whose
+/// counts use at most maxLocalBytes.
+///
+int ResidueCounter::getMaxThreads() const
+{
+  uint64_t threads = maxLocalBytes / (q_ * sizeof(uint64_t));
+  return (int) std::max<uint64_t>(threads, 1);
+}
+
+/// Must be called once by each thread before it adds its
+/// first segment, the counts of the threads are added up
+/// by getCounts() and getPrimeCount().
+///
+ResidueCounter::Local* ResidueCounter::addThread()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  locals_.emplace_back(new Local);
+  Local* local = locals_.back().get();
+  local->counter = this;
+  local->sums.resize(period_ * groups_.size());
+  local->counts.resize(q_);
+  std::fill(local->counts.begin(), local->counts.end(), 0);
+  return local;
+}
+
+/// Count the primes of the segment's sieve array
+/// in the thread's Local object, low % 30 == 0.
+///
+void ResidueCounter::addSegment(Local& local,
+                                uint64_t low,
+                                const uint64_t* sieve,
+                                std::size_t size)
+{
+  ASSERT(low % 30 == 0);
+
+  if (!groups_.empty())
+    addMasked(local, low, sieve, size);
+  else
+    addPrimes(local, low, sieve, size);
+}
+
+/// Count the 1 bits of each group using popcount(), all 1 bits
+/// of a group are in the same residue class. The sums[j][g]
+/// of the sieve words i with i % period = j are in the
+/// same residue class.
+///
+void ResidueCounter::addMasked(Local& local,
+                               uint64_t low,
+                               const uint64_t* sieve,
+                               std::size_t size)
+{
+  std::size_t groups = groups_.size();
+  std::size_t period = (std::size_t) period_;
+  const Group* group = groups_.data();
+  uint64_t* sums = local.sums.data();
+  std::fill_n(sums, period * groups, 0);
+
+  for (std::size_t i = 0, j = 0; i < size; i++)
+  {
+    uint64_t bits = to_littleendian(sieve[i]);
+    uint64_t* sum = &sums[j * groups];
+
+    for (std::size_t g = 0; g < groups; g++)
+      sum[g] += popcnt64(bits & group[g].mask);
+
+    j = (j + 1 < period) ? j + 1 : 0;
+  }
+
+  uint64_t* counts = local.counts.data();
+  uint64_t step = 240 % q_;
+  uint64_t wordResidue = low % q_;
+
+  for (std::size_t j = 0; j < period; j++)
+  {
+    for (std::size_t g = 0; g < groups; g++)
+      counts[addMod(wordResidue, group[g].residue)] += sums[j * groups + g];
+
+    wordResidue = addMod(wordResidue, step);
+  }
+}
+
+/// Extract the primes from the sieve
+/// array and count them by residue class.
+///
+void ResidueCounter::addPrimes(Local& local,
+                               uint64_t low,
+                               const uint64_t* sieve,
+                               std::size_t size)
+{
+  const uint64_t* bitResidues = bitResidues_.data();
+  uint64_t* counts = local.counts.data();
+  uint64_t step = 240 % q_;
+  uint64_t wordResidue = low % q_;
+
+  for (std::size_t i = 0; i < size; i++)
+  {
+    uint64_t bits = to_littleendian(sieve[i]);
+
+    for (; bits != 0; bits &= bits - 1)
+      counts[addMod(wordResidue, bitResidues[ctz64(bits)])]++;
+
+    wordResidue = addMod(wordResidue, step);
+  }
+}
+
+/// Number of primes inside [start, stop]
+uint64_t ResidueCounter::getPrimeCount() const
+{
+  uint64_t count = 0;
+
+  for (uint64_t prime : { 2, 3, 5 })
+    count += (start_ <= prime && prime <= stop_);
+
+  for (const auto& local : locals_)
+    for (uint64_t c : local->counts)
+      count += c;
+
+  return count;
+}
+
+/// counts[r] = number of primes p inside [start, stop]
+/// with p % q = r, counts must have q elements.
+///
+void ResidueCounter::getCounts(uint64_t* counts) const
+{
+  std::fill_n(counts, q_, 0);
+
+  for (const auto& local : locals_)
+    for (uint64_t r = 0; r < q_; r++)
+      counts[r] += local->counts[r];
+
+  // The primes < 7 are not part of the sieve array
+  for (uint64_t prime : { 2, 3, 5 })
+    if (start_ <= prime && prime <= stop_)
+      counts[prime % q_]++;
+}
+
+} // namespace
@@ -0,0 +1,86 @@
+///
+/// @file   ResidueCounter.hpp
+/// @brief  Count the primes inside [start, stop] in each residue
+///         class modulo q using a single sieving pass.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef RESIDUECOUNTER_HPP
+#define RESIDUECOUNTER_HPP
+
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace primesieve {
+
+/// The segments can be added by multiple threads
+/// simultaneously in any order. Each thread counts the
+/// primes of its segments in its own Local object.
+/// Throws a primesieve_error if q = 0 or q > 2^24.
+///
+class ResidueCounter
+{
+public:
+  static constexpr uint64_t MAX_MODULUS = 1ull << 24;
+
+  /// Scratch buffer and counts of a thread, they are reused
+  /// for all segments of the thread and are added up only
+  /// once all segments have been counted.
+  struct Local
+  {
+    ResidueCounter* counter;
+    /// Popcounts of the groups of the masked algorithm
+    Vector<uint64_t> sums;
+    /// Number of primes >= 7 of each residue class
+    Vector<uint64_t> counts;
+  };
+
+  ResidueCounter(uint64_t start, uint64_t stop, uint64_t q);
+  int getMaxThreads() const;
+  Local* addThread();
+  void addSegment(Local& local, uint64_t low, const uint64_t* sieve, std::size_t size);
+  uint64_t getPrimeCount() const;
+  void getCounts(uint64_t* counts) const;
+
+private:
+  struct Group
+  {
+    /// The bits of a sieve word whose numbers
+    /// are congruent modulo q.
+    uint64_t mask;
+    /// bitValues[bit] % q of the bits of mask
+    uint64_t residue;
+  };
+
+  void addMasked(Local& local, uint64_t low, const uint64_t* sieve, std::size_t size);
+  void addPrimes(Local& local, uint64_t low, const uint64_t* sieve, std::size_t size);
+  uint64_t addMod(uint64_t a, uint64_t b) const;
+  uint64_t start_;
+  uint64_t stop_;
+  uint64_t q_;
+  /// Number of words after which the residues
+  /// of the sieve words repeat: q / gcd(q, 240).
+  uint64_t period_;
+  /// If not empty the primes are counted using popcount()
+  /// on the masked sieve words, else the primes are
+  /// extracted from the sieve words.
+  Vector<Group> groups_;
+  /// bitValues[bit] % q
+  Vector<uint64_t> bitResidues_;
+  /// One Local object per thread
+  std::vector<std::unique_ptr<Local>> locals_;
+  std::mutex mutex_;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,87 @@
+///
+/// @file   SegmentSieve.cpp
+/// @brief  SegmentSieve passes the sieve array of each sieved
+///         segment to a user callback. This is used to implement
+///         primesieve::for_each_segment(), it allows users to run
+///         their own bitset algorithms (e.g. popcount or pattern
+///         matching) directly on the sieve array.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "SegmentSieve.hpp"
+#include "Erat.hpp"
+#include "SharedSievingPrimes.hpp"
+#include "SievingPrimes.hpp"
+
+#include <primesieve/macros.hpp>
+#include <primesieve/pmath.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+
+namespace primesieve {
+
+/// @start: Must be >= 7, the primes < 7 are not part
+///         of the sieve array.
+/// @sharedPrimes: The sieving primes <= sqrt(stop) shared
+///         by all threads, or nullptr.
+///
+SegmentSieve::SegmentSieve(uint64_t start,
+                           uint64_t stop,
+                           uint64_t sieveSize,
+                           const SharedSievingPrimes* sharedPrimes) :
+  sharedPrimes_(sharedPrimes),
+  sieveSize_(sieveSize)
+{
+  ASSERT(start >= 7);
+  ASSERT(start <= stop);
+  Erat::init(start, stop, sieveSize, memoryPool_);
+}
+
+/// Call callback(ctx, segmentLow, sieve, size) for each
+/// sieved segment in ascending order.
+///
+void SegmentSieve::sieve(void* ctx,
+                         void (*callback)(void*, uint64_t, const uint64_t*, std::size_t))
+{
+  if (sharedPrimes_)
+  {
+    ASSERT(sharedPrimes_->getMaxPrime() >= isqrt(stop_));
+    SharedSievingPrimes::Reader sievingPrimes(*sharedPrimes_);
+    sieve(sievingPrimes, ctx, callback);
+  }
+  else
+  {
+    INDETERMINATE SievingPrimes sievingPrimes(this, sieveSize_, memoryPool_);
+    sieve(sievingPrimes, ctx, callback);
+  }
+}
+
+template <typename T>
+void SegmentSieve::sieve(T& sievingPrimes,
+                         void* ctx,
+                         void (*callback)(void*, uint64_t, const uint64_t*, std::size_t))
+{
+  uint64_t prime = sievingPrimes.next();
+
+  while (hasNextSegment())
+  {
+    // sieveSegment() moves segmentLow_
+    // to the next segment.
+    uint64_t low = segmentLow_;
+    uint64_t sqrtHigh = isqrt(segmentHigh_);
+
+    for (; prime <= sqrtHigh; prime = sievingPrimes.next())
+      addSievingPrime(prime);
+
+    sieveSegment();
+    callback(ctx, low, sieve_.data(), sieve_.size());
+  }
+}
+
+} // namespace
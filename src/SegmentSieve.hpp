@@ -0,0 +1,45 @@
+///
+/// @file  SegmentSieve.hpp
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef SEGMENTSIEVE_HPP
+#define SEGMENTSIEVE_HPP
+
+#include "Erat.hpp"
+#include "MemoryPool.hpp"
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace primesieve {
+
+class SharedSievingPrimes;
+
+/// SegmentSieve passes the sieve array of each sieved
+/// segment to a user callback, without converting
+/// the 1 bits of the sieve array into primes.
+///
+class SegmentSieve : public Erat
+{
+public:
+  SegmentSieve(uint64_t start,
+               uint64_t stop,
+               uint64_t sieveSize,
+               const SharedSievingPrimes* sharedPrimes);
+  NOINLINE void sieve(void* ctx, void (*callback)(void*, uint64_t, const uint64_t*, std::size_t));
+private:
+  const SharedSievingPrimes* sharedPrimes_;
+  uint64_t sieveSize_;
+  MemoryPool memoryPool_;
+  template <typename T>
+  void sieve(T& sievingPrimes, void* ctx, void (*callback)(void*, uint64_t, const uint64_t*, std::size_t));
+};
+
+} // namespace
+
+#endif
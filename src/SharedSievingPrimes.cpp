@@ -0,0 +1,111 @@
+///
+/// @file   SharedSievingPrimes.cpp
+/// @brief  The sieving primes <= sqrt(stop) generated once and
+///         shared read-only by all threads of ParallelSieve.
+///         Otherwise each thread regenerates all sieving primes
+///         for each chunk it sieves, near 10^19 that is a sieving
+///         distance of about 3.16 * 10^9 per chunk.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "SharedSievingPrimes.hpp"
+#include "PreSieve.hpp"
+
+#include <primesieve/iterator.hpp>
+#include <primesieve/macros.hpp>
+#include <primesieve/pmath.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace primesieve {
+
+/// Split the sieving primes inside
+/// [PreSieve::getMaxPrime() + 2, sqrt(stop)]
+/// into parts, the parts are generated using fill().
+///
+void SharedSievingPrimes::init(uint64_t stop,
+                               std::size_t parts)
+{
+  ASSERT(parts > 0);
+  start_ = PreSieve::getMaxPrime() + 2;
+  maxPrime_ = isqrt(stop);
+  parts_.clear();
+  parts_.resize(parts);
+}
+
+/// Generate the sieving primes of the ith part,
+/// different parts may be filled concurrently.
+///
+void SharedSievingPrimes::fill(std::size_t part)
+{
+  ASSERT(part < parts_.size());
+
+  if (start_ > maxPrime_)
+    return;
+
+  uint64_t dist = maxPrime_ - start_ + 1;
+  uint64_t partDist = ((dist - 1) / parts_.size()) + 1;
+  uint64_t low = start_ + partDist * part;
+  uint64_t high = std::min(low + partDist - 1, maxPrime_);
+
+  if (low > high)
+    return;
+
+  Part& p = parts_[part];
+  primesieve::iterator it(low, high);
+  uint64_t prime = it.next_prime();
+
+  if (prime > high)
+    return;
+
+  p.first = prime;
+  uint64_t prev = prime;
+  p.gaps.reserve((std::size_t) (partDist / std::max(std::log(high), 1.0) * 1.2));
+
+  // maxPrime_ <= sqrt(2^64) < 2^32
+  for (prime = it.next_prime(); prime <= high; prime = it.next_prime())
+  {
+    uint64_t gap = (prime - prev) / 2;
+    ASSERT(gap <= 255);
+    p.gaps.push_back((uint8_t) gap);
+    prev = prime;
+  }
+}
+
+SharedSievingPrimes::Reader::Reader(const SharedSievingPrimes& sievingPrimes) :
+  sievingPrimes_(&sievingPrimes)
+{ }
+
+/// Returns the first prime of the next non-empty part
+uint64_t SharedSievingPrimes::Reader::nextPart()
+{
+  ASSERT(sievingPrimes_ != nullptr);
+  const auto& parts = sievingPrimes_->parts_;
+
+  for (; part_ < parts.size(); part_++)
+  {
+    if (parts[part_].first)
+    {
+      prime_ = parts[part_].first;
+      gaps_ = parts[part_].gaps.data();
+      size_ = parts[part_].gaps.size();
+      i_ = 0;
+      part_++;
+      return prime_;
+    }
+  }
+
+  size_ = 0;
+  i_ = 0;
+  return ~0ull;
+}
+
+} // namespace
@@ -0,0 +1,83 @@
+///
+/// @file   SharedSievingPrimes.hpp
+/// @brief  The sieving primes <= sqrt(stop) generated once and
+///         shared read-only by all threads of ParallelSieve.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef SHAREDSIEVINGPRIMES_HPP
+#define SHAREDSIEVINGPRIMES_HPP
+
+#include <primesieve/macros.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace primesieve {
+
+/// The sieving primes are stored as gaps between consecutive
+/// primes divided by 2, the maximum prime gap below 2^32 is
+/// 336, hence each gap fits into a single byte. The interval
+/// is split into parts that can be generated in parallel, each
+/// part stores its first prime followed by the gaps.
+///
+class SharedSievingPrimes
+{
+public:
+  void init(uint64_t stop, std::size_t parts);
+  void fill(std::size_t part);
+  uint64_t getMaxPrime() const { return maxPrime_; }
+  std::size_t getParts() const { return parts_.size(); }
+
+  /// Iterates over the sieving primes, returns ~0ull once
+  /// all sieving primes have been read. Each thread uses
+  /// its own Reader object.
+  ///
+  class Reader
+  {
+  public:
+    Reader() = default;
+    Reader(const SharedSievingPrimes& sievingPrimes);
+    uint64_t next();
+  private:
+    uint64_t prime_ = 0;
+    const uint8_t* gaps_ = nullptr;
+    std::size_t i_ = 0;
+    std::size_t size_ = 0;
+    std::size_t part_ = 0;
+    const SharedSievingPrimes* sievingPrimes_ = nullptr;
+    NOINLINE uint64_t nextPart();
+  };
+
+private:
+  struct Part
+  {
+    /// First prime of the part, 0 if the part is empty
+    uint64_t first = 0;
+    Vector<uint8_t> gaps;
+  };
+
+  uint64_t start_ = 0;
+  uint64_t maxPrime_ = 0;
+  Vector<Part> parts_;
+};
+
+inline uint64_t SharedSievingPrimes::Reader::next()
+{
+  if (i_ < size_)
+  {
+    prime_ += gaps_[i_++] * 2;
+    return prime_;
+  }
+
+  return nextPart();
+}
+
+} // namespace
+
+#endif
@@ -41,6 +41,9 @@ void SievingPrimes::init(Erat* erat,
   ASSERT(start % 2 == 1);
   tinyIdx_ = start;
   low_ = segmentLow_;
+  sieveIdx_ = ~0ull;
+  i_ = 0;
+  size_ = 0;
 
   if (start * start <= stop)
     tinySieve();
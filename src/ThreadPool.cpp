@@ -0,0 +1,180 @@
+///
+/// @file   ThreadPool.cpp
+/// @brief  Process-wide pool of worker threads used by
+///         ParallelSieve. Creating new threads for each
+///         count_primes() call adds significant latency
+///         for medium sized intervals.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include "ThreadPool.hpp"
+#include "NumaInfo.hpp"
+
+#include <primesieve.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace {
+
+/// Set to true in the pool's worker threads
+thread_local bool isWorker = false;
+
+/// NUMA node of the pool's worker threads
+thread_local std::size_t numaNode = 0;
+
+/// Set once the pool has been destroyed at exit. Unlike
+/// the pool this flag is constant initialized and has no
+/// destructor, hence it stays valid until the process ends.
+std::atomic<bool> isDestroyed(false);
+
+} // namespace
+
+namespace primesieve {
+
+ThreadPool::ThreadPool() :
+  numThreads_((std::size_t) get_num_threads())
+{ }
+
+/// The pool is constructed on first use and destroyed at exit,
+/// its destructor stops and joins all worker threads. Static
+/// destructors that run after the pool's destructor (e.g. of
+/// objects constructed before the pool) may still call
+/// primesieve functions. Hence ParallelSieve checks
+/// isDestroyed() and then runs single-threaded, submitting
+/// tasks after the pool has been destroyed throws a
+/// primesieve_error.
+///
+ThreadPool& ThreadPool::get()
+{
+  static ThreadPool threadPool;
+  return threadPool;
+}
+
+/// Returns true if the pool has been destroyed at exit
+bool ThreadPool::isDestroyed()
+{
+  return ::isDestroyed.load(std::memory_order_acquire);
+}
+
+/// Returns true if the current thread is a worker thread
+/// of the pool. ParallelSieve runs single-threaded inside
+/// worker threads, waiting for tasks submitted from a
+/// worker thread could deadlock the pool.
+///
+bool ThreadPool::isWorkerThread()
+{
+  return isWorker;
+}
+
+/// Returns the NUMA node the current worker thread is pinned
+/// to, or 0 if there is only a single NUMA node.
+///
+std::size_t ThreadPool::getNumaNode()
+{
+  return numaNode;
+}
+
+ThreadPool::~ThreadPool()
+{
+  ::isDestroyed.store(true, std::memory_order_release);
+  setNumThreads(0);
+}
+
+/// Called by set_num_threads(). If the pool shrinks the
+/// surplus threads are joined, if the pool grows the new
+/// threads are created when the next task is submitted.
+///
+void ThreadPool::setNumThreads(int threads)
+{
+  std::lock_guard<std::mutex> resizeLock(resizeMutex_);
+  std::size_t size = (std::size_t) std::max(0, threads);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    numThreads_ = size;
+  }
+
+  if (size < threads_.size())
+  {
+    // Wake up all threads, threads
+    // with id >= size exit.
+    cond_.notify_all();
+
+    for (std::size_t i = size; i < threads_.size(); i++)
+      threads_[i].join();
+
+    threads_.resize(size);
+  }
+}
+
+/// Ensure the pool has at least threads threads
+void ThreadPool::reserve(int threads)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  numThreads_ = std::max(numThreads_, (std::size_t) threads);
+}
+
+void ThreadPool::startThreads()
+{
+  std::lock_guard<std::mutex> resizeLock(resizeMutex_);
+  std::size_t size;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size = numThreads_;
+  }
+
+  threads_.reserve(size);
+
+  for (std::size_t i = threads_.size(); i < size; i++)
+    threads_.emplace_back(&ThreadPool::worker, this, i);
+}
+
+void ThreadPool::worker(std::size_t id)
+{
+  isWorker = true;
+
+  // Each thread allocates its own memory (sieve array &
+  // MemoryPool buckets) which the Linux kernel allocates
+  // on the NUMA node the thread is running on.
+  const NumaInfo& numaInfo = NumaInfo::get();
+
+  if (numaInfo.nodes() > 1)
+  {
+    std::size_t node = numaInfo.getNode(id);
+    if (numaInfo.pinThread(node))
+      numaNode = node;
+  }
+
+  while (true)
+  {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [&]() { return id >= numThreads_ || !tasks_.empty(); });
+
+      if (id >= numThreads_)
+        return;
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    // Exceptions are stored in the task's future
+    task();
+  }
+}
+
+} // namespace
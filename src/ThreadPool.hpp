@@ -0,0 +1,152 @@
+///
+/// @file   ThreadPool.hpp
+/// @brief  Process-wide pool of worker threads used by
+///         ParallelSieve. Creating new threads for each
+///         count_primes() call adds significant latency
+///         for medium sized intervals.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <primesieve/config.hpp>
+#include <primesieve/macros.hpp>
+#include <primesieve/primesieve_error.hpp>
+#include <primesieve/Vector.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace primesieve {
+
+/// The thread pool is started lazily, its threads are only
+/// created once the first task is submitted. By default the
+/// number of threads is get_num_threads(), the pool is resized
+/// when set_num_threads() is called and it grows if a
+/// ParallelSieve object uses more threads. At exit the pool's
+/// destructor joins all threads, see ThreadPool::get(). On
+/// computers with multiple
+/// NUMA nodes the threads are pinned to the nodes in
+/// round-robin order.
+///
+class ThreadPool
+{
+public:
+  static ThreadPool& get();
+  static bool isWorkerThread();
+  static std::size_t getNumaNode();
+  static bool isDestroyed();
+  ~ThreadPool();
+  void setNumThreads(int threads);
+  void reserve(int threads);
+
+  /// Execute task() asynchronously using a thread of the pool.
+  /// If task() throws an exception, the exception is
+  /// rethrown by the returned future's get() method.
+  ///
+  template <typename F>
+  auto submit(F task) -> std::future<decltype(task())>
+  {
+    using R = decltype(task());
+    auto ptask = std::make_shared<std::packaged_task<R()>>(std::move(task));
+    std::future<R> future = ptask->get_future();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace_back([ptask]() { (*ptask)(); });
+    }
+
+    startThreads();
+    cond_.notify_one();
+    return future;
+  }
+
+private:
+  ThreadPool();
+  void startThreads();
+  void worker(std::size_t id);
+
+  /// Number of threads the pool should have
+  std::size_t numThreads_ = 0;
+  Vector<std::thread> threads_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  /// Serializes starting & joining threads
+  std::mutex resizeMutex_;
+};
+
+template <typename T>
+class RelaxedAtomic
+{
+public:
+  RelaxedAtomic(T n) : atomic_(n) { }
+  // Postfix Increment
+  T operator++(int)
+  {
+    return atomic_.fetch_add(1, std::memory_order_relaxed);
+  }
+private:
+  // Use padding to avoid CPU false sharing
+  MAYBE_UNUSED char pad1[config::MAX_CACHE_LINE_SIZE];
+  std::atomic<T> atomic_;
+  MAYBE_UNUSED char pad2[config::MAX_CACHE_LINE_SIZE];
+};
+
+/// Submit threads copies of task() to the thread pool
+template <typename F>
+auto submitTasks(int threads, F& task) -> Vector<std::future<decltype(task())>>
+{
+  if (ThreadPool::isDestroyed())
+    throw primesieve_error("thread pool used after it was destroyed at exit");
+
+  ThreadPool& threadPool = ThreadPool::get();
+  threadPool.reserve(threads);
+  Vector<std::future<decltype(task())>> futures;
+  futures.reserve(threads);
+
+  for (int t = 0; t < threads; t++)
+    futures.emplace_back(threadPool.submit(task));
+
+  return futures;
+}
+
+/// The tasks reference local variables of the calling
+/// function. Hence, even if a task throws an exception,
+/// we must wait until all tasks have finished before we
+/// may return from the calling function.
+///
+template <typename T>
+void waitAll(Vector<std::future<T>>& futures)
+{
+  for (auto& f : futures)
+    f.wait();
+}
+
+/// Execute task() in parallel using threads threads
+template <typename F>
+void runParallel(int threads, F& task)
+{
+  auto futures = submitTasks(threads, task);
+  waitAll(futures);
+
+  for (auto& f : futures)
+    f.get();
+}
+
+} // namespace
+
+#endif
@@ -4,7 +4,7 @@
 ///         Contains the implementations of the functions declared
 ///         in the primesieve.h header file.
 ///
-/// Copyright (C) 2021 Kim Walisch, <kim.walisch@gmail.com>
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
 ///
 /// This file is distributed under the BSD License. See the COPYING
 /// file in the top level directory.
@@ -15,11 +15,13 @@
 #include <primesieve/malloc_vector.hpp>
 
 #include <stdint.h>
+#include <algorithm>
 #include <cstdlib>
 #include <cstddef>
 #include <cerrno>
 #include <exception>
 #include <iostream>
+#include <vector>
 
 using std::size_t;
 using namespace primesieve;
@@ -224,6 +226,164 @@ uint64_t primesieve_count_sextuplets(uint64_t start, uint64_t stop)
   }
 }
 
+void primesieve_count_primes_batch(const uint64_t* starts,
+                                   const uint64_t* stops,
+                                   size_t n,
+                                   uint64_t* counts)
+{
+  try
+  {
+    count_primes_batch(starts, stops, n, counts);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_count_primes_batch: " << e.what() << std::endl;
+    errno = EDOM;
+    std::fill_n(counts, n, PRIMESIEVE_ERROR);
+  }
+}
+
+uint64_t* primesieve_count_primes_histogram(uint64_t start,
+                                            uint64_t stop,
+                                            uint64_t width,
+                                            size_t* size)
+{
+  try
+  {
+    std::vector<uint64_t> counts = count_primes_histogram(start, stop, width);
+    malloc_vector<uint64_t> histogram;
+    histogram.reserve(counts.size());
+    for (uint64_t count : counts)
+      histogram.push_back(count);
+    if (size)
+      *size = histogram.size();
+    return histogram.release();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_count_primes_histogram: " << e.what() << std::endl;
+    errno = EDOM;
+    if (size)
+      *size = 0;
+    return nullptr;
+  }
+}
+
+uint64_t* primesieve_count_twins_histogram(uint64_t start,
+                                           uint64_t stop,
+                                           uint64_t width,
+                                           size_t* size)
+{
+  try
+  {
+    std::vector<uint64_t> counts = count_twins_histogram(start, stop, width);
+    malloc_vector<uint64_t> histogram;
+    histogram.reserve(counts.size());
+    for (uint64_t count : counts)
+      histogram.push_back(count);
+    if (size)
+      *size = histogram.size();
+    return histogram.release();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_count_twins_histogram: " << e.what() << std::endl;
+    errno = EDOM;
+    if (size)
+      *size = 0;
+    return nullptr;
+  }
+}
+
+void primesieve_count_gaps(uint64_t start,
+                           uint64_t stop,
+                           primesieve_gaps* gaps)
+{
+  gaps->counts = nullptr;
+  gaps->first = nullptr;
+  gaps->size = 0;
+  gaps->record_primes = nullptr;
+  gaps->record_gaps = nullptr;
+  gaps->records = 0;
+
+  try
+  {
+    prime_gaps res = count_gaps(start, stop);
+    malloc_vector<uint64_t> counts;
+    malloc_vector<uint64_t> first;
+    malloc_vector<uint64_t> recordPrimes;
+    malloc_vector<uint64_t> recordGaps;
+    counts.reserve(res.counts.size());
+    first.reserve(res.first.size());
+    recordPrimes.reserve(res.records.size());
+    recordGaps.reserve(res.records.size());
+
+    for (std::size_t i = 0; i < res.counts.size(); i++)
+    {
+      counts.push_back(res.counts[i]);
+      first.push_back(res.first[i]);
+    }
+
+    for (const auto& record : res.records)
+    {
+      recordPrimes.push_back(record.first);
+      recordGaps.push_back(record.second);
+    }
+
+    gaps->size = counts.size();
+    gaps->records = recordPrimes.size();
+    gaps->counts = counts.release();
+    gaps->first = first.release();
+    gaps->record_primes = recordPrimes.release();
+    gaps->record_gaps = recordGaps.release();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_count_gaps: " << e.what() << std::endl;
+    errno = EDOM;
+  }
+}
+
+void primesieve_free_gaps(primesieve_gaps* gaps)
+{
+  free(gaps->counts);
+  free(gaps->first);
+  free(gaps->record_primes);
+  free(gaps->record_gaps);
+  gaps->counts = nullptr;
+  gaps->first = nullptr;
+  gaps->size = 0;
+  gaps->record_primes = nullptr;
+  gaps->record_gaps = nullptr;
+  gaps->records = 0;
+}
+
+uint64_t* primesieve_count_primes_mod(uint64_t start,
+                                      uint64_t stop,
+                                      uint64_t q,
+                                      size_t* size)
+{
+  try
+  {
+    std::vector<uint64_t> counts = count_primes_mod(start, stop, q);
+    malloc_vector<uint64_t> residues;
+    residues.reserve(counts.size());
+    for (uint64_t count : counts)
+      residues.push_back(count);
+    if (size)
+      *size = residues.size();
+    return residues.release();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_count_primes_mod: " << e.what() << std::endl;
+    errno = EDOM;
+    if (size)
+      *size = 0;
+    return nullptr;
+  }
+}
+
 void primesieve_print_primes(uint64_t start, uint64_t stop)
 {
   try
@@ -237,6 +397,98 @@ void primesieve_print_primes(uint64_t start, uint64_t stop)
   }
 }
 
+void primesieve_print_primes_format(uint64_t start, uint64_t stop, int format)
+{
+  try
+  {
+    print_primes(start, stop, (PrintFormat) format);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_print_primes_format: " << e.what() << std::endl;
+    errno = EDOM;
+  }
+}
+
+uint64_t* primesieve_decode_primes(const void* data, size_t bytes, int format, size_t* size)
+{
+  try
+  {
+    malloc_vector<uint64_t> primes;
+    decode_primes(data, bytes, (PrintFormat) format, &primes);
+    if (size)
+      *size = primes.size();
+
+    return primes.release();
+  }
+  catch (const std::exception& e)
+  {
+    if (size)
+      *size = 0;
+
+    std::cerr << "primesieve_decode_primes: " << e.what() << std::endl;
+    errno = EDOM;
+    return nullptr;
+  }
+}
+
+void primesieve_for_each_prime(uint64_t start,
+                               uint64_t stop,
+                               int order,
+                               void (*callback)(uint64_t, void*),
+                               void* ctx)
+{
+  try
+  {
+    for_each_prime(start, stop, [&](uint64_t prime) {
+      callback(prime, ctx);
+    }, (ForEachOrder) order);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_for_each_prime: " << e.what() << std::endl;
+    errno = EDOM;
+  }
+}
+
+void primesieve_for_each_prime_block(uint64_t start,
+                                     uint64_t stop,
+                                     int order,
+                                     void (*callback)(const uint64_t*, size_t, void*),
+                                     void* ctx)
+{
+  try
+  {
+    for_each_prime_block(start, stop, [&](const uint64_t* primes, size_t size) {
+      callback(primes, size, ctx);
+    }, (ForEachOrder) order);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_for_each_prime_block: " << e.what() << std::endl;
+    errno = EDOM;
+  }
+}
+
+void primesieve_for_each_segment(uint64_t start,
+                                 uint64_t stop,
+                                 int order,
+                                 void (*callback)(uint64_t, const uint64_t*, size_t, void*),
+                                 void* ctx)
+{
+  try
+  {
+    for_each_segment(start, stop, [&](uint64_t low, const uint64_t* sieve, size_t size) {
+      callback(low, sieve, size, ctx);
+    }, (ForEachOrder) order);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_for_each_segment: " << e.what() << std::endl;
+    errno = EDOM;
+  }
+}
+
 void primesieve_print_twins(uint64_t start, uint64_t stop)
 {
   try
@@ -322,6 +574,64 @@ void primesieve_set_num_threads(int num_threads)
   set_num_threads(num_threads);
 }
 
+void primesieve_build_count_index(const char* filename, uint64_t stop, uint64_t stride)
+{
+  try
+  {
+    if (!filename)
+      throw primesieve_error("filename is NULL");
+
+    build_count_index(filename, stop, stride);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_build_count_index: " << e.what() << std::endl;
+    errno = EDOM;
+  }
+}
+
+void primesieve_load_count_index(const char* filename)
+{
+  try
+  {
+    load_count_index(filename ? filename : "");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_load_count_index: " << e.what() << std::endl;
+    errno = EDOM;
+  }
+}
+
+void primesieve_build_prime_atlas(const char* filename, uint64_t stop)
+{
+  try
+  {
+    if (!filename)
+      throw primesieve_error("filename is NULL");
+
+    build_prime_atlas(filename, stop);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_build_prime_atlas: " << e.what() << std::endl;
+    errno = EDOM;
+  }
+}
+
+void primesieve_load_prime_atlas(const char* filename)
+{
+  try
+  {
+    load_prime_atlas(filename ? filename : "");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_load_prime_atlas: " << e.what() << std::endl;
+    errno = EDOM;
+  }
+}
+
 uint64_t primesieve_get_max_stop(void)
 {
   return get_max_stop();
@@ -11,18 +11,29 @@
 ///
 
 #include "CpuInfo.hpp"
+#include "GapCounter.hpp"
+#include "ResidueCounter.hpp"
+#include "PrimeGenerator.hpp"
 #include "PrimeSieveClass.hpp"
 #include "ParallelSieve.hpp"
+#include "PrimeAtlas.hpp"
+#include "PrimeCountIndex.hpp"
+#include "RiemannR.hpp"
+#include "ThreadPool.hpp"
 
 #include <primesieve.hpp>
 #include <primesieve/config.hpp>
 #include <primesieve/macros.hpp>
 #include <primesieve/pmath.hpp>
+#include <primesieve/primesieve_error.hpp>
+#include <primesieve/Vector.hpp>
 
 #include <stdint.h>
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 #include <string>
+#include <vector>
 
 using std::size_t;
 
@@ -32,6 +43,29 @@ int sieve_size = 0;
 
 int num_threads = 0;
 
+/// Count the primes (i = 0) or prime k-tuplets
+/// inside [start, stop] per bucket of width numbers.
+///
+std::vector<uint64_t> count_histogram(uint64_t start,
+                                      uint64_t stop,
+                                      uint64_t width,
+                                      int i)
+{
+  INDETERMINATE primesieve::ParallelSieve ps;
+  primesieve::Vector<primesieve::counts_t> histogram;
+  ps.setStart(start);
+  ps.setStop(stop);
+  ps.setFlags(primesieve::COUNT_PRIMES << i);
+  ps.countHistogram(width, histogram);
+
+  std::vector<uint64_t> counts;
+  counts.reserve(histogram.size());
+  for (const auto& c : histogram)
+    counts.push_back(c[i]);
+
+  return counts;
+}
+
 }
 
 namespace primesieve {
@@ -84,39 +118,287 @@ uint64_t count_sextuplets(uint64_t start, uint64_t stop)
   return ps.getCount(5);
 }
 
+void count_primes_batch(const uint64_t* starts,
+                        const uint64_t* stops,
+                        size_t n,
+                        uint64_t* counts)
+{
+  INDETERMINATE ParallelSieve ps;
+  ps.countPrimesBatch(starts, stops, n, counts);
+}
+
+std::vector<uint64_t> count_primes_histogram(uint64_t start,
+                                             uint64_t stop,
+                                             uint64_t width)
+{
+  return count_histogram(start, stop, width, 0);
+}
+
+std::vector<uint64_t> count_twins_histogram(uint64_t start,
+                                            uint64_t stop,
+                                            uint64_t width)
+{
+  return count_histogram(start, stop, width, 1);
+}
+
+prime_gaps count_gaps(uint64_t start, uint64_t stop)
+{
+  INDETERMINATE ParallelSieve ps;
+  GapCounter counter(start, stop);
+  ps.setStart(start);
+  ps.setStop(stop);
+  ps.countGaps(counter);
+
+  prime_gaps gaps;
+  const auto& counts = counter.getGaps();
+  gaps.counts.reserve(counts.size());
+  gaps.first.reserve(counts.size());
+
+  for (const auto& gap : counts)
+  {
+    gaps.counts.push_back(gap.count);
+    gaps.first.push_back(gap.first);
+  }
+
+  for (const auto& record : counter.getRecords())
+    gaps.records.emplace_back(record.prime, record.gap);
+
+  return gaps;
+}
+
+std::vector<uint64_t> count_primes_mod(uint64_t start,
+                                       uint64_t stop,
+                                       uint64_t q)
+{
+  INDETERMINATE ParallelSieve ps;
+  ResidueCounter counter(start, stop, q);
+  ps.setStart(start);
+  ps.setStop(stop);
+  ps.countPrimesMod(counter);
+
+  std::vector<uint64_t> counts(q);
+  counter.getCounts(counts.data());
+  return counts;
+}
+
+bool store_primes_parallel(uint64_t start,
+                           uint64_t stop,
+                           std::size_t prime_bytes,
+                           void* primes,
+                           void (*reserve)(void*, std::size_t),
+                           void* (*append)(void*, std::size_t))
+{
+  INDETERMINATE ParallelSieve ps;
+  ps.setStart(start);
+  ps.setStop(stop);
+  return ps.storePrimes(prime_bytes, primes, reserve, append);
+}
+
+uint64_t store_primes32(uint64_t start,
+                        uint64_t stop,
+                        uint64_t n,
+                        void* primes,
+                        void (*insert)(void*, const uint32_t*, size_t))
+{
+  if (start > stop || n == 0)
+    return 0;
+
+  ASSERT(stop <= std::numeric_limits<uint32_t>::max());
+
+  // A buffer of 4096 primes fits into the L1 cache
+  PrimeGenerator primeGenerator(start, stop, 1 << 12);
+  Vector<uint32_t> buffer;
+  uint64_t count = 0;
+
+  while (count < n)
+  {
+    size_t size;
+    primeGenerator.fillNextPrimes(buffer, &size);
+    if (size == 0)
+      break;
+
+    size = (size_t) std::min((uint64_t) size, n - count);
+    insert(primes, buffer.data(), size);
+    count += size;
+  }
+
+  return count;
+}
+
+uint64_t store_n_primes_stop(uint64_t n, uint64_t start)
+{
+  // PrimePi(2^64)
+  uint64_t max_n = 425656284035217743ull;
+  if (n == 0 || n > max_n)
+    return 0;
+
+  INDETERMINATE ParallelSieve ps;
+  uint64_t nApprox = checkedAdd(primePiApprox(start), n);
+  nApprox = std::min(nApprox, max_n);
+  uint64_t stopApprox = std::max(nthPrimeApprox(nApprox), start);
+  ps.setStart(start);
+  ps.setStop(stopApprox);
+
+  if (ps.idealNumThreads() == 1)
+    return 0;
+
+  // nthPrime(n, start) returns the nth prime > start
+  if (start > 0)
+    start--;
+
+  return ps.nthPrime(n, start);
+}
+
 void print_primes(uint64_t start, uint64_t stop)
 {
-  INDETERMINATE PrimeSieve ps;
+  INDETERMINATE ParallelSieve ps;
+  ps.sieve(start, stop, PRINT_PRIMES);
+}
+
+void print_primes(uint64_t start, uint64_t stop, PrintFormat format)
+{
+  INDETERMINATE ParallelSieve ps;
+  ps.setPrintFormat(format);
   ps.sieve(start, stop, PRINT_PRIMES);
 }
 
+void for_each_prime_block(uint64_t start,
+                          uint64_t stop,
+                          ForEachOrder order,
+                          void* ctx,
+                          void (*callback)(void*, const uint64_t*, size_t))
+{
+  INDETERMINATE ParallelSieve ps;
+  ps.setStart(start);
+  ps.setStop(stop);
+  ps.forEachPrime(order == ORDERED, ctx, callback);
+}
+
+void for_each_segment(uint64_t start,
+                      uint64_t stop,
+                      ForEachOrder order,
+                      void* ctx,
+                      void (*callback)(void*, uint64_t, const uint64_t*, size_t))
+{
+  INDETERMINATE ParallelSieve ps;
+  ps.setStart(start);
+  ps.setStop(stop);
+  ps.forEachSegment(order == ORDERED, ctx, callback);
+}
+
+/// Decodes the primes printed using one of the binary
+/// formats, see PrintFormat.hpp for the format details.
+///
+void decode_primes(const void* data,
+                   size_t bytes,
+                   PrintFormat format,
+                   void* primes,
+                   void (*insert)(void*, const uint64_t*, size_t))
+{
+  const uint8_t* p = (const uint8_t*) data;
+  const uint8_t* end = p + bytes;
+  Array<uint64_t, 1 << 10> buffer;
+  size_t size = 0;
+
+  auto read_varint = [&]() {
+    uint64_t n = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7)
+    {
+      uint64_t byte = *p++;
+      n |= (byte & 0x7f) << shift;
+      if (byte < 0x80)
+        return n;
+    }
+    throw primesieve_error("decode_primes(): invalid or truncated GAPS_FORMAT varint");
+  };
+
+  switch (format)
+  {
+    case UINT32_FORMAT:
+    case UINT64_FORMAT:
+    {
+      size_t primeBytes = (format == UINT32_FORMAT) ? 4 : 8;
+      if (bytes % primeBytes != 0)
+        throw primesieve_error("decode_primes(): data size is not a multiple of " + std::to_string(primeBytes) + " bytes");
+
+      for (; p < end; p += primeBytes)
+      {
+        uint64_t prime = 0;
+        for (size_t i = 0; i < primeBytes; i++)
+          prime |= (uint64_t) p[i] << (i * 8);
+
+        buffer[size++] = prime;
+        if (size == buffer.size())
+        {
+          insert(primes, buffer.data(), size);
+          size = 0;
+        }
+      }
+      break;
+    }
+    case GAPS_FORMAT:
+    {
+      uint64_t prime = 0;
+
+      while (p < end)
+      {
+        uint64_t gap = read_varint();
+
+        if (gap == 0)
+          prime = read_varint();
+        else
+        {
+          if (prime == 0)
+            throw primesieve_error("decode_primes(): GAPS_FORMAT data does not start with an absolute prime");
+          if (gap > (std::numeric_limits<uint64_t>::max() - prime) / 2)
+            throw primesieve_error("decode_primes(): GAPS_FORMAT prime > 2^64");
+          prime += gap * 2;
+        }
+
+        buffer[size++] = prime;
+        if (size == buffer.size())
+        {
+          insert(primes, buffer.data(), size);
+          size = 0;
+        }
+      }
+      break;
+    }
+    default:
+      throw primesieve_error("decode_primes(): only the binary formats can be decoded");
+  }
+
+  if (size > 0)
+    insert(primes, buffer.data(), size);
+}
+
 void print_twins(uint64_t start, uint64_t stop)
 {
-  INDETERMINATE PrimeSieve ps;
+  INDETERMINATE ParallelSieve ps;
   ps.sieve(start, stop, PRINT_TWINS);
 }
 
 void print_triplets(uint64_t start, uint64_t stop)
 {
-  INDETERMINATE PrimeSieve ps;
+  INDETERMINATE ParallelSieve ps;
   ps.sieve(start, stop, PRINT_TRIPLETS);
 }
 
 void print_quadruplets(uint64_t start, uint64_t stop)
 {
-  INDETERMINATE PrimeSieve ps;
+  INDETERMINATE ParallelSieve ps;
   ps.sieve(start, stop, PRINT_QUADRUPLETS);
 }
 
 void print_quintuplets(uint64_t start, uint64_t stop)
 {
-  INDETERMINATE PrimeSieve ps;
+  INDETERMINATE ParallelSieve ps;
   ps.sieve(start, stop, PRINT_QUINTUPLETS);
 }
 
 void print_sextuplets(uint64_t start, uint64_t stop)
 {
-  INDETERMINATE PrimeSieve ps;
+  INDETERMINATE ParallelSieve ps;
   ps.sieve(start, stop, PRINT_SEXTUPLETS);
 }
 
@@ -131,6 +413,35 @@ int get_num_threads()
 void set_num_threads(int threads)
 {
   num_threads = inBetween(1, threads, ParallelSieve::getMaxThreads());
+
+  if (!ThreadPool::isDestroyed())
+    ThreadPool::get().setNumThreads(num_threads);
+}
+
+void build_count_index(const std::string& filename,
+                       uint64_t stop,
+                       uint64_t stride)
+{
+  INDETERMINATE ParallelSieve ps;
+  ps.setStop(stop);
+  ps.buildCountIndex(filename, stride);
+}
+
+void load_count_index(const std::string& filename)
+{
+  PrimeCountIndex::load(filename);
+}
+
+void build_prime_atlas(const std::string& filename, uint64_t stop)
+{
+  INDETERMINATE ParallelSieve ps;
+  ps.setStop(stop);
+  ps.buildAtlas(filename);
+}
+
+void load_prime_atlas(const std::string& filename)
+{
+  PrimeAtlas::load(filename);
 }
 
 uint64_t get_max_stop()
@@ -279,6 +279,33 @@ void CmdOptions::optionDistance(Option& opt)
   numbers.push_back(start + val);
 }
 
+/// Bucket width of the histogram
+void CmdOptions::optionHistogram(Option& opt)
+{
+  histogramWidth = getVal<uint64_t>(opt);
+
+  if (histogramWidth == 0)
+    throw primesieve_error("option --histogram requires a bucket width > 0");
+}
+
+/// Print format of the primes
+void CmdOptions::optionFormat(Option& opt)
+{
+  std::transform(opt.val.begin(), opt.val.end(), opt.val.begin(),
+                 [](unsigned char c){ return std::tolower(c); });
+
+  if (opt.val == "text")
+    format = TEXT_FORMAT;
+  else if (opt.val == "u32" || opt.val == "uint32")
+    format = UINT32_FORMAT;
+  else if (opt.val == "u64" || opt.val == "uint64")
+    format = UINT64_FORMAT;
+  else if (opt.val == "gaps")
+    format = GAPS_FORMAT;
+  else
+    throw primesieve_error("invalid option '" + opt.opt + "=" + opt.val + "'");
+}
+
 void CmdOptions::optionStressTest(Option& opt)
 {
   setMainOption(OPTION_STRESS_TEST, opt.str);
@@ -330,18 +357,27 @@ CmdOptions parseOptions(int argc, char** argv)
   /// primesieve command-line options
   const std::map<std::string, std::pair<OptionID, IsParam>> optionMap =
   {
+    { "--atlas",            std::make_pair(OPTION_ATLAS, REQUIRED_PARAM) },
+    { "--build-atlas",      std::make_pair(OPTION_BUILD_ATLAS, REQUIRED_PARAM) },
+    { "--build-index",      std::make_pair(OPTION_BUILD_INDEX, REQUIRED_PARAM) },
     { "-c",                 std::make_pair(OPTION_COUNT, OPTIONAL_PARAM) },
     { "--count",            std::make_pair(OPTION_COUNT, OPTIONAL_PARAM) },
     { "--cpu-info",         std::make_pair(OPTION_CPU_INFO, NO_PARAM) },
+    { "--gaps",             std::make_pair(OPTION_GAPS, NO_PARAM) },
     { "-h",                 std::make_pair(OPTION_HELP, NO_PARAM) },
     { "--help",             std::make_pair(OPTION_HELP, NO_PARAM) },
+    { "--histogram",        std::make_pair(OPTION_HISTOGRAM, REQUIRED_PARAM) },
+    { "--index",            std::make_pair(OPTION_INDEX, REQUIRED_PARAM) },
     { "-n",                 std::make_pair(OPTION_NTH_PRIME, NO_PARAM) },
     { "--nthprime",         std::make_pair(OPTION_NTH_PRIME, NO_PARAM) },
     { "--nth-prime",        std::make_pair(OPTION_NTH_PRIME, NO_PARAM) },
     { "--no-status",        std::make_pair(OPTION_NO_STATUS, NO_PARAM) },
     { "--number",           std::make_pair(OPTION_NUMBER, REQUIRED_PARAM) },
+    { "-o",                 std::make_pair(OPTION_OUTPUT, REQUIRED_PARAM) },
+    { "--output",           std::make_pair(OPTION_OUTPUT, REQUIRED_PARAM) },
     { "-d",                 std::make_pair(OPTION_DISTANCE, REQUIRED_PARAM) },
     { "--dist",             std::make_pair(OPTION_DISTANCE, REQUIRED_PARAM) },
+    { "--format",           std::make_pair(OPTION_FORMAT, REQUIRED_PARAM) },
     { "-p",                 std::make_pair(OPTION_PRINT, OPTIONAL_PARAM) },
     { "--print",            std::make_pair(OPTION_PRINT, OPTIONAL_PARAM) },
     { "-q",                 std::make_pair(OPTION_QUIET, NO_PARAM) },
@@ -373,6 +409,7 @@ CmdOptions parseOptions(int argc, char** argv)
     {
       case OPTION_COUNT:       opts.optionCount(opt); break;
       case OPTION_DISTANCE:    opts.optionDistance(opt); break;
+      case OPTION_FORMAT:      opts.optionFormat(opt); break;
       case OPTION_PRINT:       opts.optionPrint(opt); break;
       case OPTION_STRESS_TEST: opts.optionStressTest(opt); break;
       case OPTION_TIMEOUT:     opts.optionTimeout(opt); break;
@@ -382,6 +419,14 @@ CmdOptions parseOptions(int argc, char** argv)
       case OPTION_NO_STATUS:   opts.status = false; break;
       case OPTION_TIME:        opts.time = true; break;
       case OPTION_NUMBER:      opts.numbers.push_back(getVal<uint64_t>(opt)); break;
+      case OPTION_OUTPUT:      opts.outputFile = opt.val; break;
+      case OPTION_INDEX:       opts.indexFile = opt.val; break;
+      case OPTION_HISTOGRAM:   opts.optionHistogram(opt); break;
+      case OPTION_BUILD_INDEX: opts.indexFile = opt.val;
+                               opts.setMainOption(optionID, opt.str); break;
+      case OPTION_ATLAS:       opts.atlasFile = opt.val; break;
+      case OPTION_BUILD_ATLAS: opts.atlasFile = opt.val;
+                               opts.setMainOption(optionID, opt.str); break;
       default:                 opts.setMainOption(optionID, opt.str);
     }
   }
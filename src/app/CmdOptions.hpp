@@ -1,7 +1,7 @@
 ///
 /// @file  CmdOptions.hpp
 ///
-/// Copyright (C) 2025 Kim Walisch, <kim.walisch@gmail.com>
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
 ///
 /// This file is distributed under the BSD License. See the COPYING
 /// file in the top level directory.
@@ -17,13 +17,21 @@
 
 enum OptionID
 {
+  OPTION_ATLAS,
+  OPTION_BUILD_ATLAS,
+  OPTION_BUILD_INDEX,
   OPTION_COUNT,
   OPTION_CPU_INFO,
+  OPTION_GAPS,
   OPTION_HELP,
+  OPTION_HISTOGRAM,
+  OPTION_INDEX,
   OPTION_NTH_PRIME,
   OPTION_NO_STATUS,
   OPTION_NUMBER,
+  OPTION_OUTPUT,
   OPTION_DISTANCE,
+  OPTION_FORMAT,
   OPTION_PRINT,
   OPTION_QUIET,
   OPTION_R,
@@ -53,11 +61,16 @@ struct CmdOptions
 {
   primesieve::Vector<uint64_t> numbers;
   std::string stressTestMode;
+  std::string outputFile;
+  std::string indexFile;
+  std::string atlasFile;
   std::string optionStr;
   int option = -1;
   int flags = 0;
+  int format = 0;
   int sieveSize = 0;
   int threads = 0;
+  uint64_t histogramWidth = 0;
   // Stress test timeout in seconds.
   // The default timeout is 24 hours (same as stress-ng).
   int64_t timeout = 24 * 3600;
@@ -69,6 +82,8 @@ struct CmdOptions
   void optionPrint(Option& opt);
   void optionCount(Option& opt);
   void optionDistance(Option& opt);
+  void optionFormat(Option& opt);
+  void optionHistogram(Option& opt);
   void optionStressTest(Option& opt);
   void optionTimeout(Option& opt);
 };
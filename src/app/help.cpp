@@ -21,17 +21,40 @@ void help(int exitCode)
                "(< 2^64) using the segmented sieve of Eratosthenes.\n"
                "\n"
                "Options:\n"
+               "      --atlas=FILE           Use the prime atlas FILE to count primes and\n"
+               "                             find the nth prime, the primes <= atlas limit\n"
+               "                             are looked up instead of sieved.\n"
+               "      --build-atlas=FILE     Build a prime atlas file, a bitmap of the primes\n"
+               "                             <= STOP (STOP / 30 bytes) with a rank/select\n"
+               "                             directory. Use the atlas with --atlas=FILE.\n"
+               "      --build-index=FILE     Build a prime count index file that stores\n"
+               "                             PrimePi(x) at checkpoints <= STOP, use the index\n"
+               "                             with --index=FILE.\n"
                "  -c, --count[=NUM+]         Count primes and/or prime k-tuplets, NUM <= 6.\n"
                "                             Count primes: -c or --count (default option),\n"
                "                             count twin primes: -c2 or --count=2,\n"
                "                             count prime triplets: -c3 or --count=3, ...\n"
                "      --cpu-info             Print CPU information (cache sizes).\n"
                "  -d, --dist=DIST            Sieve the interval [START, START + DIST].\n"
+               "      --format=FORMAT        Print format of -p: text (default), u32, u64\n"
+               "                             or gaps. u32 and u64 are little-endian binary\n"
+               "                             integers, gaps are LEB128 varints of the\n"
+               "                             prime gaps / 2 (0 escapes an absolute prime).\n"
+               "      --gaps                 Prime gap analysis, prints the number of gaps\n"
+               "                             and the first occurrence of each gap size\n"
+               "                             followed by the maximal gaps.\n"
                "  -h, --help                 Print this help menu.\n"
+               "      --histogram=WIDTH      Count primes and/or prime k-tuplets per bucket of\n"
+               "                             WIDTH numbers, prints one line per bucket.\n"
+               "      --index=FILE           Use the prime count index FILE to count primes\n"
+               "                             and find the nth prime, only the numbers between\n"
+               "                             START, STOP and their nearest checkpoints are sieved.\n"
                "  -n, --nth-prime            Find the nth prime.\n"
                "                             primesieve 100 -n: finds the 100th prime,\n"
                "                             primesieve 2 100 -n: finds the 2nd prime > 100.\n"
                "      --no-status            Turn off the progressing status.\n"
+               "  -o, --output=FILE          Print the primes to FILE instead of stdout. The\n"
+               "                             threads write their chunks to FILE in parallel.\n"
                "  -p, --print[=NUM]          Print primes or prime k-tuplets, NUM <= 6.\n"
                "                             Print primes: -p or --print,\n"
                "                             print twin primes: -p2 or --print=2,\n"
@@ -24,13 +24,18 @@
 #include "CmdOptions.hpp"
 
 #include <CpuInfo.hpp>
+#include <GapCounter.hpp>
 #include <ParallelSieve.hpp>
+#include <primesieve.hpp>
 #include <RiemannR.hpp>
 #include <primesieve/macros.hpp>
+#include <primesieve/pmath.hpp>
 #include <primesieve/primesieve_error.hpp>
 #include <primesieve/Vector.hpp>
 
 #include <stdint.h>
+#include <algorithm>
+#include <cstddef>
 #include <exception>
 #include <iostream>
 #include <iomanip>
@@ -67,15 +72,39 @@ bool has_avx512_vbmi2();
 
 #endif
 
+#if defined(ENABLE_MULTIARCH_AVX512_VPOPCNT)
+
+namespace primesieve {
+
+bool has_avx512_vpopcnt();
+
+} // namespace
+
+#endif
+
+#if defined(ENABLE_MULTIARCH_AVX2)
+
+namespace primesieve {
+
+bool has_avx2();
+
+} // namespace
+
+#endif
+
 void help(int exitCode);
 void version();
 void stressTest(const CmdOptions& opts);
 void test();
 
 using primesieve::Array;
+using primesieve::checkedAdd;
+using primesieve::counts_t;
+using primesieve::GapCounter;
 using primesieve::ParallelSieve;
 using primesieve::primesieve_error;
 using primesieve::PRINT_STATUS;
+using primesieve::Vector;
 
 namespace {
 
@@ -90,6 +119,45 @@ void printSeconds(double sec)
   std::cout << "Seconds: " << std::fixed << std::setprecision(3) << sec << std::endl;
 }
 
+/// Print one line per bucket: the first and last number
+/// of the bucket followed by the selected counts.
+///
+void printHistogram(const ParallelSieve& ps,
+                    const Vector<counts_t>& histogram,
+                    uint64_t width)
+{
+  for (std::size_t j = 0; j < histogram.size(); j++)
+  {
+    uint64_t low = ps.getStart() + j * width;
+    uint64_t high = checkedAdd(low, width - 1);
+    std::cout << low << " " << std::min(high, ps.getStop());
+
+    for (int i = 0; i < 6; i++)
+      if (ps.isCount(i))
+        std::cout << " " << histogram[j][i];
+
+    std::cout << '\n';
+  }
+
+  std::cout << std::flush;
+}
+
+/// Print the idle time of each thread, a large idle
+/// time indicates that the threads were not balanced.
+///
+void printIdleSeconds(const ParallelSieve& ps)
+{
+  const auto& idle = ps.getIdleSeconds();
+
+  if (idle.empty())
+    return;
+
+  std::cout << "Idle seconds:";
+  for (double sec : idle)
+    std::cout << " " << std::fixed << std::setprecision(3) << sec;
+  std::cout << std::endl;
+}
+
 /// Count & print primes and prime k-tuplets
 void sieve(const CmdOptions& opts)
 {
@@ -106,8 +174,28 @@ void sieve(const CmdOptions& opts)
     ps.setSieveSize(opts.sieveSize);
   if (opts.threads)
     ps.setNumThreads(opts.threads);
-  if (ps.isPrint())
-    ps.setNumThreads(1);
+
+  if (opts.format != primesieve::TEXT_FORMAT)
+  {
+    if (!ps.isPrintPrimes())
+      throw primesieve_error("option --format is only supported for printing primes (-p)");
+
+    // The binary output must not be mixed
+    // with any other text output on stdout.
+    if (opts.outputFile.empty() &&
+        (ps.isCountPrimes() || ps.isCountkTuplets() || opts.time))
+      throw primesieve_error("option --format cannot be combined with --count or --time");
+
+    ps.setPrintFormat(opts.format);
+  }
+
+  if (!opts.outputFile.empty())
+  {
+    if (!ps.isPrint())
+      throw primesieve_error("option --output requires --print");
+
+    ps.setOutputFilename(opts.outputFile);
+  }
 
   if (opts.numbers.size() < 2)
     ps.setStop(opts.numbers[0]);
@@ -117,10 +205,18 @@ void sieve(const CmdOptions& opts)
     ps.setStop(opts.numbers[1]);
   }
 
+  if (opts.histogramWidth && ps.isPrint())
+    throw primesieve_error("option --histogram cannot be combined with --print");
+
   if (!opts.quiet)
     printSettings(ps);
 
-  ps.sieve();
+  Vector<counts_t> histogram;
+
+  if (opts.histogramWidth)
+    ps.countHistogram(opts.histogramWidth, histogram);
+  else
+    ps.sieve();
 
   const Array<std::string, 6> labels =
   {
@@ -133,7 +229,16 @@ void sieve(const CmdOptions& opts)
   };
 
   if (opts.time)
+  {
     printSeconds(ps.getSeconds());
+    printIdleSeconds(ps);
+  }
+
+  if (opts.histogramWidth)
+  {
+    printHistogram(ps, histogram, opts.histogramWidth);
+    return;
+  }
 
   // Did we count primes & k-tuplets simultaneously?
   int cnt = 0;
@@ -153,6 +258,119 @@ void sieve(const CmdOptions& opts)
   }
 }
 
+/// primesieve STOP --build-index=FILE
+void buildIndex(const CmdOptions& opts)
+{
+  if (opts.numbers.size() != 1)
+    throw primesieve_error("option --build-index requires a single STOP number");
+
+  INDETERMINATE ParallelSieve ps;
+  ps.setStop(opts.numbers[0]);
+
+  if (opts.status)
+    ps.addFlags(PRINT_STATUS);
+  if (opts.sieveSize)
+    ps.setSieveSize(opts.sieveSize);
+  if (opts.threads)
+    ps.setNumThreads(opts.threads);
+
+  if (!opts.quiet)
+    printSettings(ps);
+
+  ps.buildCountIndex(opts.indexFile, 0);
+
+  if (opts.time)
+    printSeconds(ps.getSeconds());
+
+  if (!opts.quiet)
+  {
+    std::cout << "Index: " << opts.indexFile << std::endl;
+    std::cout << "Index limit: " << ps.getStop() << std::endl;
+  }
+
+  std::cout << "Primes: " << ps.getCount(0) << std::endl;
+}
+
+/// primesieve STOP --build-atlas=FILE
+void buildAtlas(const CmdOptions& opts)
+{
+  if (opts.numbers.size() != 1)
+    throw primesieve_error("option --build-atlas requires a single STOP number");
+
+  INDETERMINATE ParallelSieve ps;
+  ps.setStop(opts.numbers[0]);
+
+  if (opts.sieveSize)
+    ps.setSieveSize(opts.sieveSize);
+  if (opts.threads)
+    ps.setNumThreads(opts.threads);
+
+  if (!opts.quiet)
+    printSettings(ps);
+
+  ps.buildAtlas(opts.atlasFile);
+
+  if (opts.time)
+    printSeconds(ps.getSeconds());
+
+  if (!opts.quiet)
+    std::cout << "Atlas: " << opts.atlasFile << std::endl;
+
+  std::cout << "Primes: " << ps.getCount(0) << std::endl;
+}
+
+/// primesieve START STOP --gaps
+/// Prints one line per gap size: the gap, its count and the
+/// smaller prime of its first occurrence. Followed by one line
+/// per maximal gap: the smaller prime and the gap.
+///
+void gaps(const CmdOptions& opts)
+{
+  if (opts.numbers.empty())
+    throw primesieve_error("missing STOP number");
+
+  INDETERMINATE ParallelSieve ps;
+
+  if (opts.sieveSize)
+    ps.setSieveSize(opts.sieveSize);
+  if (opts.threads)
+    ps.setNumThreads(opts.threads);
+
+  if (opts.numbers.size() < 2)
+    ps.setStop(opts.numbers[0]);
+  else
+  {
+    ps.setStart(opts.numbers[0]);
+    ps.setStop(opts.numbers[1]);
+  }
+
+  if (!opts.quiet)
+    printSettings(ps);
+
+  GapCounter counter(ps.getStart(), ps.getStop());
+  ps.countGaps(counter);
+
+  if (opts.time)
+    printSeconds(ps.getSeconds());
+  if (!opts.quiet)
+    std::cout << "Primes: " << counter.getPrimeCount() << std::endl;
+
+  std::cout << "Gap Count First" << std::endl;
+
+  const auto& gaps = counter.getGaps();
+
+  for (std::size_t gap = 0; gap < gaps.size(); gap++)
+    if (gaps[gap].count)
+      std::cout << gap << " " << gaps[gap].count << " " << gaps[gap].first << '\n';
+
+  std::cout << "Maximal gaps: Prime Gap" << std::endl;
+
+  for (const auto& record : counter.getRecords())
+    std::cout << record.prime << " " << record.gap << '\n';
+
+  std::cout << std::flush;
+}
+
 void nthPrime(const CmdOptions& opts)
 {
   if (opts.numbers.empty())
@@ -276,6 +494,20 @@ void cpuInfo()
       std::cout << "Has AVX512 VBMI2: no" << std::endl;
   #endif
 
+  #if defined(ENABLE_MULTIARCH_AVX512_VPOPCNT)
+    if (primesieve::has_avx512_vpopcnt())
+      std::cout << "Has AVX512 VPOPCNTDQ: yes" << std::endl;
+    else
+      std::cout << "Has AVX512 VPOPCNTDQ: no" << std::endl;
+  #endif
+
+  #if defined(ENABLE_MULTIARCH_AVX2)
+    if (primesieve::has_avx2())
+      std::cout << "Has AVX2: yes" << std::endl;
+    else
+      std::cout << "Has AVX2: no" << std::endl;
+  #endif
+
   if (cpu.hasL1Cache())
     std::cout << "L1 cache size: " << (cpu.l1CacheBytes() >> 10) << " KiB" << std::endl;
 
@@ -333,9 +565,20 @@ int main(int argc, char* argv[])
   {
     CmdOptions opts = parseOptions(argc, argv);
 
+    // Must be loaded before creating the ParallelSieve object
+    if (!opts.indexFile.empty() &&
+        opts.option != OPTION_BUILD_INDEX)
+      primesieve::load_count_index(opts.indexFile);
+    if (!opts.atlasFile.empty() &&
+        opts.option != OPTION_BUILD_ATLAS)
+      primesieve::load_prime_atlas(opts.atlasFile);
+
     switch (opts.option)
     {
+      case OPTION_BUILD_ATLAS: buildAtlas(opts); break;
+      case OPTION_BUILD_INDEX: buildIndex(opts); break;
       case OPTION_CPU_INFO:    cpuInfo(); break;
+      case OPTION_GAPS:        gaps(opts); break;
       case OPTION_HELP:        help(/* exitCode */ 0); break;
       case OPTION_NTH_PRIME:   nthPrime(opts); break;
       case OPTION_R:           RiemannR(opts); break;
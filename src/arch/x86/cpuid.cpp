@@ -19,13 +19,15 @@
 // https://en.wikipedia.org/wiki/CPUID
 
 // %ebx bit flags
+#define bit_AVX2     (1 << 5)
 #define bit_AVX512F  (1 << 16)
 #define bit_AVX512BW (1 << 30)
 
 // %ecx bit flags
-#define bit_AVX512VBMI  (1 << 1)
-#define bit_AVX512VBMI2 (1 << 6)
-#define bit_POPCNT      (1 << 23)
+#define bit_AVX512VBMI      (1 << 1)
+#define bit_AVX512VBMI2     (1 << 6)
+#define bit_AVX512VPOPCNTDQ (1 << 14)
+#define bit_POPCNT          (1 << 23)
 
 // xgetbv bit flags
 #define XSTATE_SSE (1 << 1)
@@ -165,4 +167,66 @@ bool has_avx512_vbmi2()
   return cached;
 }
 
+bool has_avx512_vpopcnt()
+{
+  static const bool cached = []() -> bool
+  {
+    int abcd[4];
+    run_cpuid(1, 0, abcd);
+    int osxsave_mask = (1 << 27);
+
+    // Ensure OS supports extended processor state management
+    if ((abcd[2] & osxsave_mask) != osxsave_mask)
+      return false;
+
+    uint64_t ymm_mask = XSTATE_SSE | XSTATE_YMM;
+    uint64_t zmm_mask = XSTATE_SSE | XSTATE_YMM | XSTATE_ZMM;
+    uint64_t xcr0 = get_xcr0();
+
+    // Check AVX OS support
+    if ((xcr0 & ymm_mask) != ymm_mask)
+      return false;
+
+    // Check AVX512 OS support
+    if ((xcr0 & zmm_mask) != zmm_mask)
+      return false;
+
+    run_cpuid(7, 0, abcd);
+
+    // popcount_x86_avx512() requires AVX512F & AVX512VPOPCNTDQ
+    return ((abcd[1] & bit_AVX512F) == bit_AVX512F &&
+            (abcd[2] & bit_AVX512VPOPCNTDQ) == bit_AVX512VPOPCNTDQ);
+  }();
+
+  return cached;
+}
+
+bool has_avx2()
+{
+  static const bool cached = []() -> bool
+  {
+    int abcd[4];
+    run_cpuid(1, 0, abcd);
+    int osxsave_mask = (1 << 27);
+
+    // Ensure OS supports extended processor state management
+    if ((abcd[2] & osxsave_mask) != osxsave_mask)
+      return false;
+
+    uint64_t ymm_mask = XSTATE_SSE | XSTATE_YMM;
+    uint64_t xcr0 = get_xcr0();
+
+    // Check AVX OS support
+    if ((xcr0 & ymm_mask) != ymm_mask)
+      return false;
+
+    run_cpuid(7, 0, abcd);
+
+    // popcount_x86_avx2() requires AVX2
+    return (abcd[1] & bit_AVX2) == bit_AVX2;
+  }();
+
+  return cached;
+}
+
 } // namespace
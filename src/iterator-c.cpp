@@ -2,13 +2,14 @@
 /// @file   iterator-c.cpp
 /// @brief  C port of primesieve::iterator.
 ///
-/// Copyright (C) 2025 Kim Walisch, <kim.walisch@gmail.com>
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
 ///
 /// This file is distributed under the BSD License. See the COPYING
 /// file in the top level directory.
 ///
 
 #include "IteratorHelper.hpp"
+#include "IteratorPrefetcher.hpp"
 #include "PrimeGenerator.hpp"
 
 #include <primesieve.h>
@@ -67,6 +68,8 @@ void primesieve_jump_to(primesieve_iterator* it,
   if (it->memory)
   {
     auto& iterData = getIterData(it);
+    // Stop the helper thread before modifying iterData
+    iterData.prefetcher.reset();
     iterData.stop = start;
     iterData.dist = 0;
     iterData.include_start_number = true;
@@ -93,6 +96,7 @@ void primesieve_skipto(primesieve_iterator* it,
     it->memory = new IteratorData(it->start);
 
   auto& iterData = getIterData(it);
+  iterData.prefetcher.reset();
   iterData.stop = start;
   iterData.dist = 0;
   iterData.include_start_number = false;
@@ -105,6 +109,46 @@ void primesieve_clear(primesieve_iterator* it)
   primesieve_jump_to(it, 0, std::numeric_limits<uint64_t>::max());
 }
 
+void primesieve_set_block_size(primesieve_iterator* it, size_t block_size)
+{
+  try
+  {
+    if (!it->memory)
+      it->memory = new IteratorData(it->start);
+
+    getIterData(it).setBlockSize(block_size);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_iterator: " << e.what() << std::endl;
+    it->is_error = true;
+    errno = EDOM;
+  }
+}
+
+void primesieve_enable_prefetch(primesieve_iterator* it, int enable)
+{
+  try
+  {
+    if (!it->memory)
+      it->memory = new IteratorData(it->start);
+
+    auto& iterData = getIterData(it);
+    iterData.isPrefetch = (enable != 0);
+
+    // The iterator continues from the current
+    // primes without the helper thread.
+    if (!enable)
+      iterData.deletePrefetcher(it->primes, it->size);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "primesieve_iterator: " << e.what() << std::endl;
+    it->is_error = true;
+    errno = EDOM;
+  }
+}
+
 /// C destructor
 void primesieve_free_iterator(primesieve_iterator* it)
 {
@@ -125,6 +169,18 @@ void primesieve_generate_next_primes(primesieve_iterator* it)
     auto& iterData = getIterData(it);
     auto& primes = iterData.primes;
 
+    // The next primes are generated by the
+    // prefetcher's helper thread.
+    if (iterData.isPrefetch)
+    {
+      if (!iterData.prefetcher)
+        iterData.prefetcher.reset(new IteratorPrefetcher(iterData, it->start, it->stop_hint));
+
+      it->primes = iterData.prefetcher->next(&it->size);
+      it->i = 0;
+      return;
+    }
+
     while (true)
     {
       if (!iterData.primeGenerator)
@@ -175,6 +231,16 @@ void primesieve_generate_prev_primes(primesieve_iterator* it)
     auto& iterData = getIterData(it);
     auto& primes = iterData.primes;
 
+    // prev_prime() does not use prefetching, the
+    // helper thread is stopped and the user's
+    // current primes are copied into primes.
+    if_unlikely(iterData.prefetcher)
+    {
+      iterData.deletePrefetcher(it->primes, it->size);
+      it->start = primes.front();
+      ASSERT(!iterData.include_start_number);
+    }
+
     // Special case if generate_next_primes() has
     // been used before generate_prev_primes().
     if_unlikely(iterData.primeGenerator)
@@ -1,19 +1,21 @@
 ///
 /// @file  iterator.cpp
 ///
-/// Copyright (C) 2025 Kim Walisch, <kim.walisch@gmail.com>
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
 ///
 /// This file is distributed under the BSD License. See the COPYING
 /// file in the top level directory.
 ///
 
 #include "IteratorHelper.hpp"
+#include "IteratorPrefetcher.hpp"
 #include "PrimeGenerator.hpp"
 
 #include <primesieve/iterator.hpp>
 #include <primesieve/macros.hpp>
 
 #include <stdint.h>
+#include <cstddef>
 #include <limits>
 
 namespace {
@@ -104,6 +106,8 @@ void iterator::jump_to(uint64_t start,
   if (memory_)
   {
     auto& iterData = *(IteratorData*) memory_;
+    // Stop the helper thread before modifying iterData
+    iterData.prefetcher.reset();
     iterData.stop = start;
     iterData.dist = 0;
     iterData.include_start_number = true;
@@ -117,6 +121,29 @@ void iterator::clear() noexcept
   jump_to(0);
 }
 
+void iterator::set_block_size(std::size_t block_size)
+{
+  if (!memory_)
+    memory_ = new IteratorData(start_);
+
+  auto& iterData = *(IteratorData*) memory_;
+  iterData.setBlockSize(block_size);
+}
+
+void iterator::enable_prefetch(bool enable)
+{
+  if (!memory_)
+    memory_ = new IteratorData(start_);
+
+  auto& iterData = *(IteratorData*) memory_;
+  iterData.isPrefetch = enable;
+
+  // The iterator continues from the current
+  // primes without the helper thread.
+  if (!enable)
+    iterData.deletePrefetcher(primes_, size_);
+}
+
 iterator::~iterator()
 {
   freeAllMemory(this);
@@ -130,6 +157,18 @@ void iterator::generate_next_primes()
   auto& iterData = *(IteratorData*) memory_;
   auto& primes = iterData.primes;
 
+  // The next primes are generated by the
+  // prefetcher's helper thread.
+  if (iterData.isPrefetch)
+  {
+    if (!iterData.prefetcher)
+      iterData.prefetcher.reset(new IteratorPrefetcher(iterData, start_, stop_hint_));
+
+    primes_ = iterData.prefetcher->next(&size_);
+    i_ = 0;
+    return;
+  }
+
   while (true)
   {
     if (!iterData.primeGenerator)
@@ -163,6 +202,16 @@ void iterator::generate_prev_primes()
   auto& iterData = *(IteratorData*) memory_;
   auto& primes = iterData.primes;
 
+  // prev_prime() does not use prefetching, the
+  // helper thread is stopped and the user's
+  // current primes are copied into primes.
+  if_unlikely(iterData.prefetcher)
+  {
+    iterData.deletePrefetcher(primes_, size_);
+    start_ = primes.front();
+    ASSERT(!iterData.include_start_number);
+  }
+
   // Special case if generate_next_primes() has
   // been used before generate_prev_primes().
   if_unlikely(iterData.primeGenerator)
@@ -1,6 +1,15 @@
 ///
 /// @file   popcount.cpp
 /// @brief  Quickly count the number of 1 bits in an array.
+///         popcount() is called for each sieved segment, hence
+///         we use SIMD algorithms if the CPU supports them:
+///
+///         x86:  AVX512 VPOPCNTDQ > AVX2 Harley-Seal > POPCNT
+///         ARM:  SVE CNT > NEON CNT
+///
+///         If the user compiles without e.g. -mavx512vpopcntdq
+///         we dispatch at runtime to the fastest algorithm
+///         supported by the CPU.
 ///
 /// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
 ///
@@ -9,123 +18,93 @@
 ///
 
 #include <primesieve/forward.hpp>
-#include <primesieve/popcnt.hpp>
 #include <primesieve/Vector.hpp>
 
 #include <stdint.h>
 
-/// For CPU architectures that have a POPCNT instruction, we use
-/// that to count the number of 1 bits in the sieve array as
-/// this will generally provide the best performance. For CPU
-/// architectures without POPCNT we use the portable Harley-Seal
-/// popcount algorithm further down.
-///
-#if defined(__POPCNT__) /* x86 GCC/Clang */ || \
-    defined(ENABLE_MULTIARCH_x86_POPCNT) || \
-   (defined(__ARM_NEON) || defined(__aarch64__))
+#if defined(__ARM_FEATURE_SVE) && \
+    __has_include(<arm_sve.h>)
+  #include "popcount_arm_sve.hpp"
+  #define popcount_fastest popcount_arm_sve
 
-namespace primesieve {
+#elif defined(__AVX512F__) && \
+      defined(__AVX512VPOPCNTDQ__) && \
+      __has_include(<immintrin.h>)
+  #include "popcount_x86_avx512.hpp"
+  #define popcount_fastest popcount_x86_avx512
 
-uint64_t popcount(const Vector<uint64_t>& vect)
-{
-  const uint64_t* array = vect.data();
-  uint64_t size = vect.size();
-  uint64_t limit = size - size % 4;
-  uint64_t cnt = 0;
-  uint64_t i;
-
-  for(i = 0; i < limit; i += 4)
-  {
-    cnt += popcnt64(array[i + 0]);
-    cnt += popcnt64(array[i + 1]);
-    cnt += popcnt64(array[i + 2]);
-    cnt += popcnt64(array[i + 3]);
-  }
-  for(; i < size; i++)
-    cnt += popcnt64(array[i]);
-
-  return cnt;
-}
+#elif defined(ENABLE_MULTIARCH_ARM_SVE)
+  #include <primesieve/cpu_supports_arm_sve.hpp>
+  #include "popcount_arm_sve.hpp"
 
-} // namespace
+#elif defined(ENABLE_MULTIARCH_AVX512_VPOPCNT)
+  #include <primesieve/cpu_supports_avx512_vpopcnt.hpp>
+  #include "popcount_x86_avx512.hpp"
+#endif
 
-#else
+// Algorithms that run on any CPU of the architecture
+#if !defined(popcount_fastest)
 
-/// The "Harley-Seal popcount" algorithm that we use is a pure
-/// integer algorithm that does not use the POPCNT instruction
-/// present on many CPU architectures.
-///
-/// 1) This algorithm is portable (unlike POPCNT on x64)
-///    and very fast, its speed is very close to POPCNT.
-/// 2) Recent compilers can autovectorize this loop (e.g
-///    using AVX512 on x64 CPUs) in which case this algorithm
-///    will even outperform the POPCNT instruction.
+#if defined(__AVX2__) && \
+    __has_include(<immintrin.h>)
+  #include "popcount_x86_avx2.hpp"
+  #define popcount_fallback popcount_x86_avx2
+
+#elif (defined(__ARM_NEON) || defined(__aarch64__)) && \
+      __has_include(<arm_neon.h>)
+  #include "popcount_arm_neon.hpp"
+  #define popcount_fallback popcount_arm_neon
+
+#elif defined(ENABLE_MULTIARCH_AVX2)
+  #include <primesieve/cpu_supports_avx2.hpp>
+  #include "popcount_x86_avx2.hpp"
+  #include "popcount_default.hpp"
+  #define popcount_fallback popcount_dispatch_avx2
 
 namespace {
 
-/// Carry-save adder (CSA).
-/// @see Chapter 5 in "Hacker's Delight".
-///
-void CSA(uint64_t& h, uint64_t& l, uint64_t a, uint64_t b, uint64_t c)
+uint64_t popcount_dispatch_avx2(const uint64_t* array, uint64_t size)
 {
-  uint64_t u = a ^ b;
-  h = (a & b) | (u & c);
-  l = u ^ c;
+  if (cpu_supports_avx2)
+    return popcount_x86_avx2(array, size);
+  else
+    return popcount_default(array, size);
 }
 
 } // namespace
 
+#else
+  #include "popcount_default.hpp"
+  #define popcount_fallback popcount_default
+#endif
+
+#endif
+
 namespace primesieve {
 
-/// Harley-Seal popcount (4th iteration).
-/// The Harley-Seal popcount algorithm is one of the fastest algorithms
-/// for counting 1 bits in an array using only integer operations.
-/// This implementation uses only 5.69 instructions per 64-bit word.
-/// @see Chapter 5 in "Hacker's Delight" 2nd edition.
-///
+/// Runtime dispatch to the fastest popcount() algorithm
+uint64_t popcount(const uint64_t* array, uint64_t size)
+{
+#if defined(popcount_fastest)
+  return popcount_fastest(array, size);
+#elif defined(ENABLE_MULTIARCH_AVX512_VPOPCNT)
+  if (cpu_supports_avx512_vpopcnt)
+    return popcount_x86_avx512(array, size);
+  else
+    return popcount_fallback(array, size);
+#elif defined(ENABLE_MULTIARCH_ARM_SVE)
+  if (cpu_supports_sve)
+    return popcount_arm_sve(array, size);
+  else
+    return popcount_fallback(array, size);
+#else
+  return popcount_fallback(array, size);
+#endif
+}
+
 uint64_t popcount(const Vector<uint64_t>& vect)
 {
-  const uint64_t* array = vect.data();
-  uint64_t size = vect.size();
-  uint64_t limit = size - size % 16;
-  uint64_t total = 0;
-  uint64_t ones = 0, twos = 0, fours = 0, eights = 0, sixteens = 0;
-  uint64_t twosA, twosB, foursA, foursB, eightsA, eightsB;
-  uint64_t i;
-
-  for(i = 0; i < limit; i += 16)
-  {
-    CSA(twosA, ones, ones, array[i + 0], array[i + 1]);
-    CSA(twosB, ones, ones, array[i + 2], array[i + 3]);
-    CSA(foursA, twos, twos, twosA, twosB);
-    CSA(twosA, ones, ones, array[i + 4], array[i + 5]);
-    CSA(twosB, ones, ones, array[i + 6], array[i + 7]);
-    CSA(foursB, twos, twos, twosA, twosB);
-    CSA(eightsA,fours, fours, foursA, foursB);
-    CSA(twosA, ones, ones, array[i + 8], array[i + 9]);
-    CSA(twosB, ones, ones, array[i + 10], array[i + 11]);
-    CSA(foursA, twos, twos, twosA, twosB);
-    CSA(twosA, ones, ones, array[i + 12], array[i + 13]);
-    CSA(twosB, ones, ones, array[i + 14], array[i + 15]);
-    CSA(foursB, twos, twos, twosA, twosB);
-    CSA(eightsB, fours, fours, foursA, foursB);
-    CSA(sixteens, eights, eights, eightsA, eightsB);
-
-    total += popcnt64(sixteens);
-  }
-
-  total *= 16;
-  total += 8 * popcnt64(eights);
-  total += 4 * popcnt64(fours);
-  total += 2 * popcnt64(twos);
-  total += 1 * popcnt64(ones);
-
-  for(; i < size; i++)
-    total += popcnt64(array[i]);
-
-  return total;
+  return popcount(vect.data(), vect.size());
 }
 
 } // namespace
-
-#endif
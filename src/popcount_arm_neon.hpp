@@ -0,0 +1,49 @@
+///
+/// @file  popcount_arm_neon.hpp
+/// @brief Count the 1 bits of an array using the ARM NEON
+///        CNT instruction, 16 bytes per instruction.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef POPCOUNT_ARM_NEON_HPP
+#define POPCOUNT_ARM_NEON_HPP
+
+#include <primesieve/popcnt.hpp>
+
+#include <arm_neon.h>
+#include <stdint.h>
+
+namespace {
+
+uint64_t popcount_arm_neon(const uint64_t* array, uint64_t size)
+{
+  uint64x2_t sum = vdupq_n_u64(0);
+  uint64_t i = 0;
+
+  for (; i + 8 <= size; i += 8)
+  {
+    uint8x16_t cnt0 = vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(&array[i + 0])));
+    uint8x16_t cnt1 = vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(&array[i + 2])));
+    uint8x16_t cnt2 = vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(&array[i + 4])));
+    uint8x16_t cnt3 = vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(&array[i + 6])));
+
+    // Each byte is <= 32, no overflow
+    uint8x16_t cnt = vaddq_u8(vaddq_u8(cnt0, cnt1), vaddq_u8(cnt2, cnt3));
+    sum = vpadalq_u32(sum, vpaddlq_u16(vpaddlq_u8(cnt)));
+  }
+
+  uint64_t total = vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1);
+
+  for (; i < size; i++)
+    total += popcnt64(array[i]);
+
+  return total;
+}
+
+} // namespace
+
+#endif
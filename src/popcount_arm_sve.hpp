@@ -0,0 +1,39 @@
+///
+/// @file  popcount_arm_sve.hpp
+/// @brief Count the 1 bits of an array using the ARM SVE
+///        CNT instruction, the last partial vector is
+///        handled using a predicate.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef POPCOUNT_ARM_SVE_HPP
+#define POPCOUNT_ARM_SVE_HPP
+
+#include <arm_sve.h>
+#include <stdint.h>
+
+namespace {
+
+#if defined(ENABLE_MULTIARCH_ARM_SVE)
+  __attribute__ ((target ("+sve")))
+#endif
+uint64_t popcount_arm_sve(const uint64_t* array, uint64_t size)
+{
+  svuint64_t sum = svdup_u64(0);
+
+  for (uint64_t i = 0; i < size; i += svcntd())
+  {
+    svbool_t pg = svwhilelt_b64(i, size);
+    sum = svadd_u64_m(pg, sum, svcnt_u64_z(pg, svld1_u64(pg, &array[i])));
+  }
+
+  return svaddv_u64(svptrue_b64(), sum);
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,119 @@
+///
+/// @file  popcount_x86_avx2.hpp
+/// @brief Harley-Seal popcount using AVX2 (256-bit) vectors.
+///        The vectors are reduced using carry-save adders and
+///        only every 16th vector is popcounted using a nibble
+///        lookup table (PSHUFB) and PSADBW.
+///        @see Muła, Kurz, Lemire, "Faster Population Counts
+///        Using AVX2 Instructions", 2016.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef POPCOUNT_X86_AVX2_HPP
+#define POPCOUNT_X86_AVX2_HPP
+
+#include <primesieve/popcnt.hpp>
+
+#include <immintrin.h>
+#include <stdint.h>
+
+#if defined(ENABLE_MULTIARCH_AVX2)
+  #define TARGET_AVX2 __attribute__ ((target ("avx2")))
+#else
+  #define TARGET_AVX2
+#endif
+
+namespace {
+
+/// Count the 1 bits of each 64-bit lane
+TARGET_AVX2 ALWAYS_INLINE __m256i popcnt256(__m256i v)
+{
+  const __m256i lookup = _mm256_setr_epi8(
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+  __m256i lo = _mm256_and_si256(v, low_mask);
+  __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+  __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                _mm256_shuffle_epi8(lookup, hi));
+
+  return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+/// Carry-save adder (CSA) of 256-bit vectors
+TARGET_AVX2 ALWAYS_INLINE void CSA256(__m256i& h, __m256i& l, __m256i a, __m256i b, __m256i c)
+{
+  __m256i u = _mm256_xor_si256(a, b);
+  h = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+  l = _mm256_xor_si256(u, c);
+}
+
+TARGET_AVX2 ALWAYS_INLINE __m256i load256(const uint64_t* array)
+{
+  return _mm256_loadu_si256((const __m256i*) array);
+}
+
+TARGET_AVX2
+uint64_t popcount_x86_avx2(const uint64_t* array, uint64_t size)
+{
+  // Number of words per 16 vectors
+  uint64_t limit = size - size % 64;
+  __m256i total = _mm256_setzero_si256();
+  __m256i ones = _mm256_setzero_si256();
+  __m256i twos = _mm256_setzero_si256();
+  __m256i fours = _mm256_setzero_si256();
+  __m256i eights = _mm256_setzero_si256();
+  __m256i sixteens, twosA, twosB, foursA, foursB, eightsA, eightsB;
+  uint64_t i = 0;
+
+  for (; i < limit; i += 64)
+  {
+    CSA256(twosA, ones, ones, load256(&array[i + 0]), load256(&array[i + 4]));
+    CSA256(twosB, ones, ones, load256(&array[i + 8]), load256(&array[i + 12]));
+    CSA256(foursA, twos, twos, twosA, twosB);
+    CSA256(twosA, ones, ones, load256(&array[i + 16]), load256(&array[i + 20]));
+    CSA256(twosB, ones, ones, load256(&array[i + 24]), load256(&array[i + 28]));
+    CSA256(foursB, twos, twos, twosA, twosB);
+    CSA256(eightsA, fours, fours, foursA, foursB);
+    CSA256(twosA, ones, ones, load256(&array[i + 32]), load256(&array[i + 36]));
+    CSA256(twosB, ones, ones, load256(&array[i + 40]), load256(&array[i + 44]));
+    CSA256(foursA, twos, twos, twosA, twosB);
+    CSA256(twosA, ones, ones, load256(&array[i + 48]), load256(&array[i + 52]));
+    CSA256(twosB, ones, ones, load256(&array[i + 56]), load256(&array[i + 60]));
+    CSA256(foursB, twos, twos, twosA, twosB);
+    CSA256(eightsB, fours, fours, foursA, foursB);
+    CSA256(sixteens, eights, eights, eightsA, eightsB);
+
+    total = _mm256_add_epi64(total, popcnt256(sixteens));
+  }
+
+  total = _mm256_slli_epi64(total, 4);
+  total = _mm256_add_epi64(total, _mm256_slli_epi64(popcnt256(eights), 3));
+  total = _mm256_add_epi64(total, _mm256_slli_epi64(popcnt256(fours), 2));
+  total = _mm256_add_epi64(total, _mm256_slli_epi64(popcnt256(twos), 1));
+  total = _mm256_add_epi64(total, popcnt256(ones));
+
+  for (; i + 4 <= size; i += 4)
+    total = _mm256_add_epi64(total, popcnt256(load256(&array[i])));
+
+  uint64_t cnt = (uint64_t) _mm256_extract_epi64(total, 0);
+  cnt += (uint64_t) _mm256_extract_epi64(total, 1);
+  cnt += (uint64_t) _mm256_extract_epi64(total, 2);
+  cnt += (uint64_t) _mm256_extract_epi64(total, 3);
+
+  for (; i < size; i++)
+    cnt += popcnt64(array[i]);
+
+  return cnt;
+}
+
+} // namespace
+
+#undef TARGET_AVX2
+
+#endif
@@ -0,0 +1,56 @@
+///
+/// @file  popcount_x86_avx512.hpp
+/// @brief Count the 1 bits of an array using the AVX512
+///        VPOPCNTDQ instruction, 8 words per instruction.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#ifndef POPCOUNT_X86_AVX512_HPP
+#define POPCOUNT_X86_AVX512_HPP
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <algorithm>
+
+namespace {
+
+#if defined(ENABLE_MULTIARCH_AVX512_VPOPCNT)
+  __attribute__ ((target ("avx512f,avx512vpopcntdq")))
+#endif
+uint64_t popcount_x86_avx512(const uint64_t* array, uint64_t size)
+{
+  __m512i cnt0 = _mm512_setzero_si512();
+  __m512i cnt1 = _mm512_setzero_si512();
+  uint64_t i = 0;
+
+  for (; i + 16 <= size; i += 16)
+  {
+    __m512i vec0 = _mm512_loadu_si512((const __m512i*) &array[i + 0]);
+    __m512i vec1 = _mm512_loadu_si512((const __m512i*) &array[i + 8]);
+    cnt0 = _mm512_add_epi64(cnt0, _mm512_popcnt_epi64(vec0));
+    cnt1 = _mm512_add_epi64(cnt1, _mm512_popcnt_epi64(vec1));
+  }
+
+  for (; i < size; i += 8)
+  {
+    uint64_t n = std::min(size - i, (uint64_t) 8);
+    __mmask8 mask = (__mmask8) (0xff >> (8 - n));
+    __m512i vec = _mm512_maskz_loadu_epi64(mask, &array[i]);
+    cnt0 = _mm512_add_epi64(cnt0, _mm512_popcnt_epi64(vec));
+  }
+
+  uint64_t lanes[8];
+  cnt0 = _mm512_add_epi64(cnt0, cnt1);
+  _mm512_storeu_si512((__m512i*) lanes, cnt0);
+
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         lanes[4] + lanes[5] + lanes[6] + lanes[7];
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,147 @@
+///
+/// @file   chunk_scheduler.cpp
+/// @brief  Test the work-stealing scheduler used for counting
+///         primes in parallel. The chunks must cover the
+///         interval [start, stop] without gaps and overlaps.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <ParallelSieve.hpp>
+#include <ChunkScheduler.hpp>
+#include <primesieve/macros.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Thread 0 processes 1 chunk per round, the other threads
+/// process more chunks per round and hence run out of work
+/// and have to steal chunks from thread 0.
+///
+bool checkCoverage(uint64_t start, uint64_t stop, int threads)
+{
+  ChunkScheduler scheduler(start, stop, threads, 1000, 1000000);
+  std::vector<std::pair<uint64_t, uint64_t>> chunks;
+  std::vector<bool> done(threads, false);
+  int active = threads;
+
+  while (active > 0)
+  {
+    for (int t = 0; t < threads; t++)
+    {
+      for (int i = 0; i <= t && !done[t]; i++)
+      {
+        uint64_t low, high;
+        if (scheduler.next(t, &low, &high))
+          chunks.emplace_back(low, high);
+        else
+        {
+          done[t] = true;
+          active--;
+        }
+      }
+    }
+  }
+
+  std::sort(chunks.begin(), chunks.end());
+  uint64_t low = start;
+
+  for (auto& chunk : chunks)
+  {
+    if (chunk.first != low || chunk.second <= chunk.first)
+      return false;
+    low = chunk.second;
+  }
+
+  return low == stop;
+}
+
+/// Thread 1 counts its own range first and then steals the
+/// range of thread 0 which has not started yet, hence the
+/// chunk that starts below 7 is counted last by a thread
+/// that has already counted other chunks.
+///
+bool checkStealFirst(uint64_t stop, uint64_t minChunk)
+{
+  int flags = COUNT_PRIMES | COUNT_TWINS | COUNT_TRIPLETS;
+  INDETERMINATE ParallelSieve ps;
+  ps.setStart(0);
+  ps.setStop(stop);
+  ps.setFlags(flags);
+  ChunkScheduler scheduler(0, stop, 2, minChunk, minChunk * 10);
+  counts_t counts = ps.countChunks(scheduler, 1, nullptr);
+
+  INDETERMINATE ParallelSieve ps2;
+  ps2.setNumThreads(1);
+  ps2.sieve(0, stop, flags);
+
+  return counts[0] == ps2.getCount(0) &&
+         counts[1] == ps2.getCount(1) &&
+         counts[2] == ps2.getCount(2);
+}
+
+int main()
+{
+  std::cout << "Chunks cover [0, 10^8] using 1 thread";
+  check(checkCoverage(0, (uint64_t) 1e8, 1));
+
+  std::cout << "Chunks cover [10^12, 10^12 + 10^8] using 4 threads";
+  check(checkCoverage((uint64_t) 1e12, (uint64_t) 1e12 + (uint64_t) 1e8, 4));
+
+  std::cout << "Chunks cover [2^64 - 10^8, 2^64 - 1] using 7 threads";
+  check(checkCoverage(~0ull - (uint64_t) 1e8, ~0ull, 7));
+
+  std::cout << "Steal the whole range of thread 0 after counting a chunk";
+  check(checkStealFirst((uint64_t) 1e7, (uint64_t) 1e7));
+
+  std::cout << "Steal half of the range of thread 0 after counting a chunk";
+  check(checkStealFirst((uint64_t) 1e7, (uint64_t) 1e5));
+
+  // Prime k-tuplets must not be split at chunk boundaries
+  int maxThreads = ParallelSieve::getMaxThreads();
+  uint64_t start = (uint64_t) 1e10 - 777;
+  uint64_t stop = start + (uint64_t) 5e8;
+
+  for (int i = 0; i < 6; i++)
+  {
+    int flags = COUNT_PRIMES << i;
+    INDETERMINATE ParallelSieve ps1;
+    ps1.setNumThreads(1);
+    ps1.sieve(start, stop, flags);
+
+    // LMO does not report idle times
+    INDETERMINATE ParallelSieve ps2;
+    ps2.setNumThreads(maxThreads);
+    ps2.setLMO(false);
+    ps2.sieve(start, stop, flags);
+
+    std::cout << "count k-tuplets (k = " << i + 1 << ") in [" << start << ", " << stop << "] = " << ps2.getCount(i);
+    check(ps1.getCount(i) == ps2.getCount(i));
+
+    bool isParallel = ps2.idealNumThreads() > 1;
+    std::cout << "Idle time reported for each thread";
+    check(ps2.getIdleSeconds().empty() == !isParallel);
+  }
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+///
+/// @file   count_chunks.cpp
+/// @brief  Test the continue sieving mode used by ParallelSieve,
+///         adjacent chunks continue sieving where the previous
+///         chunk stopped, other chunks restart sieving.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <CountPrintPrimes.hpp>
+#include <PrimeSieveClass.hpp>
+#include <SharedSievingPrimes.hpp>
+#include <primesieve/macros.hpp>
+
+#include <stdint.h>
+#include <iostream>
+#include <cstdlib>
+#include <cstddef>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Chunk bounds as used by ParallelSieve,
+/// (n % 30) == 2 or n == stop.
+///
+uint64_t align(uint64_t n, uint64_t stop)
+{
+  if (stop - n <= 32)
+    return stop;
+  else
+    return n + 32 - n % 30;
+}
+
+/// Count the chunks [start + i * dist, start + (i + 1) * dist]
+/// in the given order (a permutation of 0..7).
+///
+uint64_t countChunks(uint64_t start,
+                     uint64_t stop,
+                     int flags,
+                     const int* order,
+                     const SharedSievingPrimes* shared)
+{
+  INDETERMINATE PrimeSieve ps;
+  ps.setStart(start);
+  ps.setStop(stop);
+  ps.setFlags(flags);
+  ps.setSievingPrimes(shared);
+  ps.getCounts().fill(0);
+  CountPrintPrimes countPrimes(ps);
+  uint64_t dist = (stop - start) / 8;
+
+  for (int i = 0; i < 8; i++)
+  {
+    uint64_t low = start + dist * order[i];
+    uint64_t high = (order[i] == 7) ? stop : low + dist;
+    uint64_t chunkStart = (low > start) ? align(low, stop) + 1 : low;
+    uint64_t chunkStop = align(high, stop);
+
+    if (chunkStart <= chunkStop)
+      countPrimes.countChunk(chunkStart, chunkStop);
+  }
+
+  uint64_t count = 0;
+  for (int i = 0; i < 6; i++)
+    if (ps.isCount(i))
+      count += ps.getCount(i);
+
+  return count;
+}
+
+int main()
+{
+  const int adjacent[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  const int jumps[8] = { 0, 1, 5, 6, 7, 2, 4, 3 };
+
+  uint64_t start = (uint64_t) 1e12 - 12345;
+  uint64_t stop = start + (uint64_t) 1e8;
+
+  for (int i = 0; i < 6; i++)
+  {
+    int flags = COUNT_PRIMES << i;
+    INDETERMINATE PrimeSieve ps;
+    ps.sieve(start, stop, flags);
+    uint64_t expected = ps.getCount(i);
+
+    std::cout << "Adjacent chunks, k-tuplets (k = " << i + 1 << ") = " << expected;
+    check(countChunks(start, stop, flags, adjacent, nullptr) == expected);
+
+    std::cout << "Non adjacent chunks, k-tuplets (k = " << i + 1 << ") = " << expected;
+    check(countChunks(start, stop, flags, jumps, nullptr) == expected);
+  }
+
+  SharedSievingPrimes sievingPrimes;
+  sievingPrimes.init(stop, 4);
+  for (std::size_t i = 0; i < 4; i++)
+    sievingPrimes.fill(i);
+
+  uint64_t expected = count_primes(start, stop);
+  std::cout << "Shared sieving primes, adjacent chunks = " << expected;
+  check(countChunks(start, stop, COUNT_PRIMES, adjacent, &sievingPrimes) == expected);
+
+  std::cout << "Shared sieving primes, non adjacent chunks = " << expected;
+  check(countChunks(start, stop, COUNT_PRIMES, jumps, &sievingPrimes) == expected);
+
+  start = ~0ull - (uint64_t) 3e7;
+  stop = ~0ull;
+  sievingPrimes.init(stop, 4);
+  for (std::size_t i = 0; i < 4; i++)
+    sievingPrimes.fill(i);
+
+  expected = count_primes(start, stop);
+  std::cout << "Non adjacent chunks near 2^64 = " << expected;
+  check(countChunks(start, stop, COUNT_PRIMES, jumps, &sievingPrimes) == expected);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
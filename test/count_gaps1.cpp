@@ -0,0 +1,127 @@
+///
+/// @file   count_gaps1.cpp
+/// @brief  Check that count_gaps() returns the same gap counts,
+///         first occurrences and maximal gaps as computed from
+///         the primes of generate_primes().
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Compute the prime gaps using generate_primes()
+prime_gaps primesGaps(uint64_t start, uint64_t stop)
+{
+  prime_gaps gaps;
+  std::vector<uint64_t> primes;
+  generate_primes(start, stop, &primes);
+  uint64_t maxGap = 0;
+
+  for (std::size_t i = 1; i < primes.size(); i++)
+  {
+    uint64_t prime = primes[i - 1];
+    uint64_t gap = primes[i] - prime;
+
+    if (gap >= gaps.counts.size())
+    {
+      gaps.counts.resize(gap + 1, 0);
+      gaps.first.resize(gap + 1, 0);
+    }
+
+    gaps.counts[gap]++;
+    if (!gaps.first[gap])
+      gaps.first[gap] = prime;
+    if (gap > maxGap)
+    {
+      gaps.records.emplace_back(prime, gap);
+      maxGap = gap;
+    }
+  }
+
+  return gaps;
+}
+
+void checkGaps(uint64_t start, uint64_t stop)
+{
+  prime_gaps gaps = count_gaps(start, stop);
+  prime_gaps expected = primesGaps(start, stop);
+  std::cout << "count_gaps(" << start << ", " << stop << ")";
+  check(gaps.counts == expected.counts &&
+        gaps.first == expected.first &&
+        gaps.records == expected.records);
+}
+
+int main()
+{
+  // Tiny intervals crossing the primes < 7
+  for (uint64_t start = 0; start < 12; start++)
+    for (uint64_t stop = start; stop < 40; stop++)
+      checkGaps(start, stop);
+
+  std::mt19937_64 rng(42);
+
+  for (int threads : { 1, 3 })
+  {
+    set_num_threads(threads);
+
+    for (int i = 0; i < 20; i++)
+    {
+      uint64_t start = std::uniform_int_distribution<uint64_t>(0, (uint64_t) 1e9)(rng);
+      uint64_t dist = std::uniform_int_distribution<uint64_t>(0, (uint64_t) 1e7)(rng);
+      checkGaps(start, start + dist);
+    }
+
+    uint64_t start = (uint64_t) 1e15;
+    checkGaps(start, start + (uint64_t) 1e8);
+
+    // Near 2^64
+    uint64_t stop = ~0ull;
+    checkGaps(stop - (uint64_t) 1e8, stop);
+  }
+
+  // The maximal gaps <= 10^8
+  std::vector<std::pair<uint64_t, uint64_t>> records =
+  {
+    {2, 1}, {3, 2}, {7, 4}, {23, 6}, {89, 8}, {113, 14}, {523, 18},
+    {887, 20}, {1129, 22}, {1327, 34}, {9551, 36}, {15683, 44},
+    {19609, 52}, {31397, 72}, {155921, 86}, {360653, 96},
+    {370261, 112}, {492113, 114}, {1349533, 118}, {1357201, 132},
+    {2010733, 148}, {4652353, 154}, {17051707, 180}, {20831323, 210},
+    {47326693, 220}
+  };
+
+  prime_gaps gaps = count_gaps(0, (uint64_t) 1e8);
+  uint64_t pairs = 0;
+  for (uint64_t count : gaps.counts)
+    pairs += count;
+
+  std::cout << "Number of prime gaps <= 10^8 = " << pairs;
+  check(pairs == 5761455 - 1);
+  std::cout << "Maximal prime gaps <= 10^8";
+  check(gaps.records == records);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * @file   count_gaps2.c
+ * @brief  Check that primesieve_count_gaps() returns the same
+ *         gap counts, first occurrences and maximal gaps as
+ *         computed from the primes of primesieve_generate_primes().
+ *
+ * Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+ *
+ * This file is distributed under the BSD License. See the COPYING
+ * file in the top level directory.
+ */
+
+#include <primesieve.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+int main(void)
+{
+  uint64_t start = 1000000000;
+  uint64_t stop = 1030000000;
+  uint64_t counts[1000] = { 0 };
+  uint64_t first[1000] = { 0 };
+  uint64_t maxGap = 0;
+  size_t records = 0;
+  size_t size;
+  size_t i;
+  primesieve_gaps gaps;
+  uint64_t* primes = (uint64_t*) primesieve_generate_primes(start, stop, &size, UINT64_PRIMES);
+
+  primesieve_count_gaps(start, stop, &gaps);
+
+  for (i = 1; i < size; i++)
+  {
+    uint64_t gap = primes[i] - primes[i - 1];
+
+    if (counts[gap]++ == 0)
+      first[gap] = primes[i - 1];
+
+    if (gap > maxGap)
+    {
+      printf("Maximal gap %" PRIu64 " after %" PRIu64, gap, primes[i - 1]);
+      check(records < gaps.records &&
+            gaps.record_gaps[records] == gap &&
+            gaps.record_primes[records] == primes[i - 1]);
+      maxGap = gap;
+      records++;
+    }
+  }
+
+  printf("primesieve_count_gaps().size = %zu", gaps.size);
+  check(gaps.size == maxGap + 1);
+  printf("primesieve_count_gaps().records = %zu", gaps.records);
+  check(gaps.records == records);
+
+  for (i = 0; i < gaps.size; i++)
+  {
+    printf("Gap %zu: count = %" PRIu64 ", first = %" PRIu64, i, gaps.counts[i], gaps.first[i]);
+    check(gaps.counts[i] == counts[i] &&
+          gaps.first[i] == first[i]);
+  }
+
+  primesieve_free(primes);
+  primesieve_free_gaps(&gaps);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
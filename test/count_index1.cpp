@@ -0,0 +1,115 @@
+///
+/// @file   count_index1.cpp
+/// @brief  Build a prime count index and check that count_primes()
+///         and nth_prime() return the same results with and
+///         without the index.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+int main()
+{
+  const std::string filename = "count_index1.idx";
+  uint64_t limit = 1000000000;
+  uint64_t stride = 1 << 20;
+
+  build_count_index(filename, limit, stride);
+
+  std::vector<std::pair<uint64_t, uint64_t>> ranges =
+  {
+    { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 100 },
+    { 0, stride }, { 1, stride }, { 2, stride },
+    { stride, stride * 2 }, { stride + 1, stride * 2 - 1 },
+    { 0, limit }, { 12345, limit - 12345 },
+    { limit - 1000, limit + 1000 }, { 0, limit * 2 }
+  };
+
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<uint64_t> dist(0, limit + stride * 4);
+
+  for (int i = 0; i < 50; i++)
+  {
+    uint64_t a = dist(rng);
+    uint64_t b = dist(rng);
+    ranges.emplace_back(std::min(a, b), std::max(a, b));
+  }
+
+  std::vector<uint64_t> expected;
+  for (const auto& r : ranges)
+    expected.push_back(count_primes(r.first, r.second));
+
+  std::vector<uint64_t> nthPrimes;
+  for (int64_t n = 1; n < 50000000; n = n * 3 + 1)
+    nthPrimes.push_back(nth_prime(n));
+
+  load_count_index(filename);
+
+  for (std::size_t i = 0; i < ranges.size(); i++)
+  {
+    uint64_t count = count_primes(ranges[i].first, ranges[i].second);
+    std::cout << "count_primes(" << ranges[i].first << ", " << ranges[i].second << ") = " << count;
+    check(count == expected[i]);
+  }
+
+  std::size_t i = 0;
+  for (int64_t n = 1; n < 50000000; n = n * 3 + 1, i++)
+  {
+    uint64_t prime = nth_prime(n);
+    std::cout << "nth_prime(" << n << ") = " << prime;
+    check(prime == nthPrimes[i]);
+  }
+
+  // Unload the index
+  load_count_index("");
+  uint64_t count = count_primes(0, limit);
+  std::cout << "count_primes(0, 10^9) without index = " << count;
+  check(count == expected[9]);
+
+  // Truncated index file
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << "PSINDEX1";
+  }
+
+  try
+  {
+    load_count_index(filename);
+    std::cout << "load_count_index() of truncated file";
+    check(false);
+  }
+  catch (const primesieve_error& e)
+  {
+    std::cout << "Expected exception: " << e.what();
+    check(true);
+  }
+
+  std::remove(filename.c_str());
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+/*
+ * @file   count_index2.c
+ * @brief  Build a prime count index using the C API and check
+ *         that primesieve_count_primes() returns the same
+ *         results with and without the index.
+ *
+ * Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+ *
+ * This file is distributed under the BSD License. See the COPYING
+ * file in the top level directory.
+ */
+
+#include <primesieve.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+int main(void)
+{
+  const char* filename = "count_index2.idx";
+  uint64_t start = 123456789;
+  uint64_t stop = 876543210;
+  uint64_t expected = primesieve_count_primes(start, stop);
+  uint64_t count;
+
+  primesieve_build_count_index(filename, 1000000000, 0);
+  primesieve_load_count_index(filename);
+
+  count = primesieve_count_primes(start, stop);
+  printf("primesieve_count_primes(%" PRIu64 ", %" PRIu64 ") = %" PRIu64, start, stop, count);
+  check(count == expected);
+
+  count = primesieve_count_primes(0, 1000000000);
+  printf("primesieve_count_primes(0, 10^9) = %" PRIu64, count);
+  check(count == 50847534);
+
+  primesieve_load_count_index(NULL);
+  remove(filename);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+///
+/// @file   count_primes_batch1.cpp
+/// @brief  Check that count_primes_batch() returns the same
+///         counts as count_primes() for each interval.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+
+#include <stdint.h>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+void checkBatch(const std::vector<std::pair<uint64_t, uint64_t>>& intervals)
+{
+  std::vector<uint64_t> counts = count_primes_batch(intervals);
+  check(counts.size() == intervals.size());
+
+  for (std::size_t i = 0; i < intervals.size(); i++)
+  {
+    uint64_t start = intervals[i].first;
+    uint64_t stop = intervals[i].second;
+    uint64_t count = (start <= stop) ? count_primes(start, stop) : 0;
+    std::cout << "count_primes_batch([" << start << ", " << stop << "]) = " << counts[i];
+    check(counts[i] == count);
+  }
+}
+
+int main()
+{
+  // Tiny, empty, overlapping and duplicate intervals
+  checkBatch({
+    { 0, 0 }, { 0, 1 }, { 0, 2 }, { 2, 3 }, { 3, 5 }, { 5, 6 },
+    { 0, 7 }, { 7, 7 }, { 8, 10 }, { 10, 8 }, { 11, 11 }, { 0, 100 },
+    { 31, 37 }, { 32, 36 }, { 29, 31 }, { 30, 30 }, { 36, 37 },
+    { 0, 100 }, { 50, 1000 }, { 997, 997 }, { 1000, 2000 }
+  });
+
+  // Histogram buckets of 1000 numbers
+  std::vector<std::pair<uint64_t, uint64_t>> buckets;
+  for (uint64_t i = 0; i < 1000; i++)
+    buckets.emplace_back(i * 1000, i * 1000 + 999);
+  checkBatch(buckets);
+
+  // Random intervals, including far apart intervals
+  std::mt19937_64 rng(123);
+  std::uniform_int_distribution<uint64_t> dist1(0, (uint64_t) 1e8);
+  std::uniform_int_distribution<uint64_t> dist2(0, (uint64_t) 1e6);
+  std::vector<std::pair<uint64_t, uint64_t>> intervals;
+
+  for (int i = 0; i < 300; i++)
+  {
+    uint64_t start = dist1(rng);
+    if (i % 3 == 0)
+      start += (uint64_t) 1e12;
+    intervals.emplace_back(start, start + dist2(rng));
+  }
+
+  checkBatch(intervals);
+
+  // Intervals close to 2^64
+  uint64_t max = std::numeric_limits<uint64_t>::max();
+  checkBatch({ { max - 1000000, max }, { max - 10000, max - 5000 } });
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
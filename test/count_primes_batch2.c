@@ -0,0 +1,57 @@
+/*
+ * @file   count_primes_batch2.c
+ * @brief  Check that primesieve_count_primes_batch() returns
+ *         the same counts as primesieve_count_primes().
+ *
+ * Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+ *
+ * This file is distributed under the BSD License. See the COPYING
+ * file in the top level directory.
+ */
+
+#include <primesieve.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+int main(void)
+{
+  uint64_t starts[1000];
+  uint64_t stops[1000];
+  uint64_t counts[1000];
+  size_t n = 1000;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+  {
+    starts[i] = i * 123457;
+    stops[i] = starts[i] + 100000 + i * 37;
+  }
+
+  primesieve_count_primes_batch(starts, stops, n, counts);
+
+  for (i = 0; i < n; i++)
+  {
+    uint64_t count = primesieve_count_primes(starts[i], stops[i]);
+    printf("primesieve_count_primes_batch(%" PRIu64 ", %" PRIu64 ") = %" PRIu64, starts[i], stops[i], counts[i]);
+    check(counts[i] == count);
+  }
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+///
+/// @file   count_primes_histogram1.cpp
+/// @brief  Check that count_primes_histogram() and
+///         count_twins_histogram() return the same counts as
+///         sieving each bucket separately.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <PrimeSieveClass.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+void checkHistogram(uint64_t start, uint64_t stop, uint64_t width)
+{
+  std::vector<uint64_t> primes = count_primes_histogram(start, stop, width);
+  std::vector<uint64_t> twins = count_twins_histogram(start, stop, width);
+  std::cout << "count_primes_histogram(" << start << ", " << stop << ", " << width << ").size() = " << primes.size();
+  check(primes.size() == (stop - start) / width + 1);
+  check(twins.size() == primes.size());
+
+  PrimeSieve ps;
+  bool OK = true;
+
+  for (std::size_t i = 0; i < primes.size(); i++)
+  {
+    uint64_t low = start + i * width;
+    uint64_t high = std::min(low + (width - 1), stop);
+    ps.sieve(low, high, COUNT_PRIMES | COUNT_TWINS);
+    OK = OK && primes[i] == ps.getCount(0);
+    OK = OK && twins[i] == ps.getCount(1);
+  }
+
+  std::cout << "count_primes_histogram(" << start << ", " << stop << ", " << width << ")";
+  check(OK);
+}
+
+void checkError(uint64_t start, uint64_t stop, uint64_t width)
+{
+  bool isError = false;
+
+  try {
+    count_primes_histogram(start, stop, width);
+  }
+  catch (const primesieve_error& e) {
+    std::cout << "count_primes_histogram(" << start << ", " << stop << ", " << width << ") throws: " << e.what();
+    isError = true;
+  }
+
+  check(isError);
+}
+
+int main()
+{
+  // Tiny buckets crossing the primes < 7
+  for (uint64_t start = 0; start < 10; start++)
+    for (uint64_t width = 1; width < 40; width++)
+      checkHistogram(start, 1000, width);
+
+  for (uint64_t width : { 29, 30, 31, 240, 241, 1000 })
+    checkHistogram(1000000007, 1000100000, width);
+
+  // Multiple chunks per thread
+  for (uint64_t width : { 99991, 1000000, 12345678, 100000000 })
+    checkHistogram(0, 300000000, width);
+
+  checkHistogram(1000000000000ull, 1000100000000ull, 7777777);
+
+  // Bucket larger than [start, stop]
+  checkHistogram(123, 456789, 1ull << 40);
+
+  // Exactly the maximum number of buckets
+  std::vector<uint64_t> counts = count_primes_histogram(0, (1ull << 22) - 1, 1);
+  std::cout << "count_primes_histogram(0, 2^22 - 1, 1).size() = " << counts.size();
+  check(counts.size() == (1ull << 22));
+
+  checkError(0, 1000, 0);
+  checkError(0, 1ull << 22, 1);
+  checkError(0, 1000000000000ull, 1000);
+  checkError(0, ~0ull, 1);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
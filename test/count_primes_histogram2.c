@@ -0,0 +1,81 @@
+/*
+ * @file   count_primes_histogram2.c
+ * @brief  Check that primesieve_count_primes_histogram() returns
+ *         the same counts as primesieve_count_primes().
+ *
+ * Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+ *
+ * This file is distributed under the BSD License. See the COPYING
+ * file in the top level directory.
+ */
+
+#include <primesieve.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+int main(void)
+{
+  uint64_t start = 1000000;
+  uint64_t stop = 101000000;
+  uint64_t width = 999983;
+  uint64_t* primes;
+  uint64_t* twins;
+  size_t size;
+  size_t i;
+
+  primes = primesieve_count_primes_histogram(start, stop, width, &size);
+  printf("primesieve_count_primes_histogram().size = %zu", size);
+  check(size == (stop - start) / width + 1);
+
+  for (i = 0; i < size; i++)
+  {
+    uint64_t low = start + i * width;
+    uint64_t high = low + width - 1;
+    uint64_t count;
+
+    if (high > stop)
+      high = stop;
+
+    count = primesieve_count_primes(low, high);
+    printf("primesieve_count_primes(%" PRIu64 ", %" PRIu64 ") = %" PRIu64, low, high, primes[i]);
+    check(primes[i] == count);
+  }
+
+  twins = primesieve_count_twins_histogram(start, stop, width, &size);
+
+  for (i = 0; i < size; i++)
+  {
+    uint64_t low = start + i * width;
+    uint64_t high = low + width - 1;
+    uint64_t count;
+
+    if (high > stop)
+      high = stop;
+
+    count = primesieve_count_twins(low, high);
+    printf("primesieve_count_twins(%" PRIu64 ", %" PRIu64 ") = %" PRIu64, low, high, twins[i]);
+    check(twins[i] == count);
+  }
+
+  primesieve_free(primes);
+  primesieve_free(twins);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
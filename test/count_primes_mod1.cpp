@@ -0,0 +1,144 @@
+///
+/// @file   count_primes_mod1.cpp
+/// @brief  Check that count_primes_mod() returns the same counts
+///         per residue class as computed from the primes of
+///         generate_primes().
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+
+#include <stdint.h>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Count the primes by residue class
+std::vector<uint64_t> primesMod(const std::vector<uint64_t>& primes, uint64_t q)
+{
+  std::vector<uint64_t> counts(q, 0);
+
+  for (uint64_t prime : primes)
+    counts[prime % q]++;
+
+  return counts;
+}
+
+void checkMod(uint64_t start,
+              uint64_t stop,
+              uint64_t q,
+              const std::vector<uint64_t>& primes)
+{
+  std::cout << "count_primes_mod(" << start << ", " << stop << ", " << q << ")";
+  check(count_primes_mod(start, stop, q) == primesMod(primes, q));
+}
+
+void checkMod(uint64_t start, uint64_t stop, uint64_t q)
+{
+  std::vector<uint64_t> primes;
+  generate_primes(start, stop, &primes);
+  checkMod(start, stop, q, primes);
+}
+
+int main()
+{
+  // Both the masked popcount algorithm (e.g. q = 4, 30)
+  // and the prime extraction (e.g. q = 97, 240) are used.
+  std::vector<uint64_t> moduli = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+                                   13, 16, 30, 60, 97, 210, 240, 241, 1000,
+                                   65536, 1000003 };
+
+  // Tiny intervals crossing the primes < 7
+  for (uint64_t start = 0; start < 12; start++)
+    for (uint64_t stop = start; stop < 40; stop += 3)
+      for (uint64_t q : { 1, 2, 3, 4, 7, 30, 97 })
+        checkMod(start, stop, q);
+
+  std::mt19937_64 rng(42);
+
+  for (int threads : { 1, 3 })
+  {
+    set_num_threads(threads);
+
+    for (uint64_t q : moduli)
+    {
+      uint64_t start = std::uniform_int_distribution<uint64_t>(0, (uint64_t) 1e10)(rng);
+      uint64_t dist = std::uniform_int_distribution<uint64_t>(0, (uint64_t) 1e7)(rng);
+      checkMod(start, start + dist, q);
+    }
+  }
+
+  // Near 2^64
+  uint64_t stop = ~0ull;
+  uint64_t start = stop - (uint64_t) 1e7;
+  std::vector<uint64_t> primes;
+  generate_primes(start, stop, &primes);
+
+  for (uint64_t q : { 30, 97 })
+    checkMod(start, stop, q, primes);
+
+  for (uint64_t q : { 3, 4, 7, 10, 210 })
+  {
+    std::vector<uint64_t> counts = count_primes_mod(0, (uint64_t) 1e9, q);
+    uint64_t sum = 0;
+    for (uint64_t count : counts)
+      sum += count;
+
+    std::cout << "Sum of count_primes_mod(0, 10^9, " << q << ") = " << sum;
+    check(sum == 50847534);
+  }
+
+  // The largest modulus uses fewer threads
+  {
+    std::vector<uint64_t> counts = count_primes_mod(0, (uint64_t) 1e8, 1ull << 24);
+    uint64_t sum = 0;
+    for (uint64_t count : counts)
+      sum += count;
+
+    std::cout << "Sum of count_primes_mod(0, 10^8, 2^24) = " << sum;
+    check(sum == 5761455);
+  }
+
+  try
+  {
+    count_primes_mod(0, 100, 0);
+    std::cout << "count_primes_mod(0, 100, 0)";
+    check(false);
+  }
+  catch (const primesieve_error& e)
+  {
+    std::cout << "count_primes_mod(0, 100, 0): " << e.what();
+    check(true);
+  }
+
+  try
+  {
+    count_primes_mod(0, 100, (1ull << 24) + 1);
+    std::cout << "count_primes_mod(0, 100, 2^24 + 1)";
+    check(false);
+  }
+  catch (const primesieve_error& e)
+  {
+    std::cout << "count_primes_mod(0, 100, 2^24 + 1): " << e.what();
+    check(true);
+  }
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
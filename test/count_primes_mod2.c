@@ -0,0 +1,71 @@
+/*
+ * @file   count_primes_mod2.c
+ * @brief  Check that primesieve_count_primes_mod() returns the
+ *         same counts per residue class as computed from the
+ *         primes of primesieve_generate_primes().
+ *
+ * Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+ *
+ * This file is distributed under the BSD License. See the COPYING
+ * file in the top level directory.
+ */
+
+#include <primesieve.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+int main(void)
+{
+  uint64_t start = 1000000000;
+  uint64_t stop = 1030000000;
+  uint64_t moduli[] = { 4, 30, 97 };
+  size_t size;
+  size_t i, j;
+  uint64_t* primes = (uint64_t*) primesieve_generate_primes(start, stop, &size, UINT64_PRIMES);
+
+  for (i = 0; i < sizeof(moduli) / sizeof(moduli[0]); i++)
+  {
+    uint64_t q = moduli[i];
+    uint64_t counts[97] = { 0 };
+    size_t residues;
+    uint64_t* res = primesieve_count_primes_mod(start, stop, q, &residues);
+
+    for (j = 0; j < size; j++)
+      counts[primes[j] % q]++;
+
+    printf("primesieve_count_primes_mod(%" PRIu64 ").size = %zu", q, residues);
+    check(residues == q);
+
+    for (j = 0; j < q; j++)
+    {
+      printf("Primes %% %" PRIu64 " = %zu: %" PRIu64, q, j, res[j]);
+      check(res[j] == counts[j]);
+    }
+
+    primesieve_free(res);
+  }
+
+  printf("primesieve_count_primes_mod(q = 0)");
+  check(primesieve_count_primes_mod(0, 100, 0, &size) == NULL && size == 0);
+
+  primesieve_free(primes);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * @file   decode_primes.c
+ * @brief  Test primesieve_decode_primes() using
+ *         handcrafted binary data.
+ *
+ * Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+ *
+ * This file is distributed under the BSD License. See the COPYING
+ * file in the top level directory.
+ */
+
+#include <primesieve.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+int main(void)
+{
+  size_t i;
+  size_t size;
+  uint64_t* primes;
+  const uint64_t expected[] = { 2, 3, 5, 7, 11, 13, 1000003, 1000033 };
+
+  /* 2 and 3 are absolute primes, then (prime gaps) / 2 */
+  const unsigned char gaps[] = { 0, 2, 0, 3, 1, 1, 2, 1,
+                                 0, 0xc3, 0x84, 0x3d, 15 };
+
+  const unsigned char u32[] = { 0x43, 0x42, 0x0f, 0x00,
+                                0x61, 0x42, 0x0f, 0x00 };
+
+  primes = primesieve_decode_primes(gaps, sizeof(gaps), PRIMESIEVE_GAPS_FORMAT, &size);
+  printf("primesieve_decode_primes(PRIMESIEVE_GAPS_FORMAT) size = %zu", size);
+  check(size == 8);
+
+  for (i = 0; i < size; i++)
+  {
+    printf("primes[%zu] = %" PRIu64, i, primes[i]);
+    check(primes[i] == expected[i]);
+  }
+
+  primesieve_free(primes);
+  primes = primesieve_decode_primes(u32, sizeof(u32), PRIMESIEVE_UINT32_FORMAT, &size);
+  printf("primesieve_decode_primes(PRIMESIEVE_UINT32_FORMAT) size = %zu", size);
+  check(size == 2);
+  printf("primes[0] = %" PRIu64, primes[0]);
+  check(primes[0] == 1000003);
+  printf("primes[1] = %" PRIu64, primes[1]);
+  check(primes[1] == 1000033);
+  primesieve_free(primes);
+
+  /* Invalid data size */
+  primes = primesieve_decode_primes(u32, 7, PRIMESIEVE_UINT32_FORMAT, &size);
+  printf("primesieve_decode_primes(invalid) = NULL");
+  check(primes == NULL && size == 0 && errno == EDOM);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
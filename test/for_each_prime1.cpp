@@ -0,0 +1,130 @@
+///
+/// @file   for_each_prime1.cpp
+/// @brief  Test for_each_prime() and for_each_prime_block()
+///         using the ORDERED and UNORDERED modes.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+
+#include <stdint.h>
+#include <atomic>
+#include <iostream>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+uint64_t primeSum(uint64_t start, uint64_t stop)
+{
+  std::vector<uint64_t> primes;
+  generate_primes(start, stop, &primes);
+  uint64_t sum = 0;
+  for (uint64_t prime : primes)
+    sum += prime;
+  return sum;
+}
+
+int main()
+{
+  uint64_t max = std::numeric_limits<uint64_t>::max();
+  uint64_t starts[] = { 0, 2, 7, (uint64_t) 1e9 - 999, (uint64_t) 1e12, max - (uint64_t) 1e8 };
+  uint64_t dist = (uint64_t) 2e8;
+
+  for (uint64_t start : starts)
+  {
+    uint64_t stop = (start < max - dist) ? start + dist : max;
+    std::atomic<uint64_t> count(0);
+    std::atomic<uint64_t> sum(0);
+
+    for_each_prime(start, stop, [&](uint64_t prime) {
+      count.fetch_add(1, std::memory_order_relaxed);
+      sum.fetch_add(prime, std::memory_order_relaxed);
+    });
+
+    std::cout << "for_each_prime(" << start << ", " << stop << ") count = " << count;
+    check(count == count_primes(start, stop));
+    std::cout << "for_each_prime(" << start << ", " << stop << ") sum = " << sum;
+    check(sum == primeSum(start, stop));
+  }
+
+  for (uint64_t start : starts)
+  {
+    uint64_t stop = (start < max - dist) ? start + dist : max;
+    std::vector<uint64_t> primes;
+    std::vector<uint64_t> expected;
+    generate_primes(start, stop, &expected);
+
+    for_each_prime(start, stop, [&](uint64_t prime) {
+      primes.push_back(prime);
+    }, ORDERED);
+
+    std::cout << "for_each_prime(" << start << ", " << stop << ", ORDERED) primes = " << primes.size();
+    check(primes == expected);
+  }
+
+  uint64_t start = (uint64_t) 1e10;
+  uint64_t stop = start + (uint64_t) 5e8;
+  std::atomic<uint64_t> count(0);
+  std::atomic<bool> isAscending(true);
+
+  for_each_prime_block(start, stop, [&](const uint64_t* primes, std::size_t size) {
+    for (std::size_t i = 1; i < size; i++)
+      if (primes[i - 1] >= primes[i])
+        isAscending = false;
+    if (size == 0 || primes[0] < start || primes[size - 1] > stop)
+      isAscending = false;
+    count += size;
+  });
+
+  std::cout << "for_each_prime_block(" << start << ", " << stop << ") count = " << count;
+  check(count == count_primes(start, stop) && isAscending);
+
+  uint64_t prev = 0;
+  bool isOrdered = true;
+
+  for_each_prime_block(start, stop, [&](const uint64_t* primes, std::size_t size) {
+    isOrdered = isOrdered && size > 0 && prev < primes[0];
+    prev = primes[size - 1];
+  }, ORDERED);
+
+  std::cout << "for_each_prime_block(" << start << ", " << stop << ", ORDERED)";
+  check(isOrdered);
+
+  for (ForEachOrder order : { UNORDERED, ORDERED })
+  {
+    try
+    {
+      for_each_prime(0, (uint64_t) 1e10, [](uint64_t prime) {
+        if (prime > (uint64_t) 1e9)
+          throw std::runtime_error("prime > 10^9");
+      }, order);
+
+      std::cout << "Exception thrown by functor";
+      check(false);
+    }
+    catch (const std::runtime_error& e)
+    {
+      std::cout << "Exception thrown by functor: " << e.what();
+      check(true);
+    }
+  }
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * @file   for_each_prime2.c
+ * @brief  Test primesieve_for_each_prime() and
+ *         primesieve_for_each_prime_block().
+ *
+ * Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+ *
+ * This file is distributed under the BSD License. See the COPYING
+ * file in the top level directory.
+ */
+
+#include <primesieve.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+typedef struct
+{
+  uint64_t count;
+  uint64_t sum;
+  int isAscending;
+} stats_t;
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+void callback(uint64_t prime, void* ctx)
+{
+  stats_t* stats = (stats_t*) ctx;
+
+  if (prime <= stats->sum && stats->count > 0)
+    stats->isAscending = 0;
+
+  stats->count++;
+  stats->sum = prime;
+}
+
+void callback_block(const uint64_t* primes, size_t size, void* ctx)
+{
+  stats_t* stats = (stats_t*) ctx;
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    stats->sum += primes[i];
+
+  stats->count += size;
+}
+
+int main(void)
+{
+  uint64_t start = 1000000000000ull;
+  uint64_t stop = start + 100000000;
+  uint64_t sum = 0;
+  size_t i;
+  size_t size;
+  uint64_t* primes = (uint64_t*) primesieve_generate_primes(start, stop, &size, UINT64_PRIMES);
+  stats_t stats = { 0, 0, 1 };
+
+  for (i = 0; i < size; i++)
+    sum += primes[i];
+
+  /* In ordered mode stats.sum is the previous prime */
+  primesieve_for_each_prime(start, stop, PRIMESIEVE_ORDERED, callback, &stats);
+  printf("primesieve_for_each_prime(PRIMESIEVE_ORDERED) count = %" PRIu64, stats.count);
+  check(stats.count == size && stats.isAscending);
+  printf("last prime = %" PRIu64, stats.sum);
+  check(stats.sum == primes[size - 1]);
+
+  stats.count = 0;
+  stats.sum = 0;
+  primesieve_set_num_threads(1);
+  primesieve_for_each_prime_block(start, stop, PRIMESIEVE_UNORDERED, callback_block, &stats);
+  printf("primesieve_for_each_prime_block() count = %" PRIu64, stats.count);
+  check(stats.count == size);
+  printf("primesieve_for_each_prime_block() sum = %" PRIu64, stats.sum);
+  check(stats.sum == sum);
+
+  primesieve_free(primes);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
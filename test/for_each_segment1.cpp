@@ -0,0 +1,123 @@
+///
+/// @file   for_each_segment1.cpp
+/// @brief  Test for_each_segment(), decode the primes from the
+///         sieve arrays using the documented bit to number
+///         mapping and compare them to generate_primes().
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Decode the primes of a segment using bytes
+/// (works on both little and big-endian CPUs).
+///
+void decode(uint64_t low,
+            const uint64_t* sieve,
+            std::size_t size,
+            std::vector<uint64_t>& primes)
+{
+  const uint64_t offsets[8] = { 7, 11, 13, 17, 19, 23, 29, 31 };
+  const uint8_t* bytes = (const uint8_t*) sieve;
+
+  for (std::size_t j = 0; j < size * 8; j++)
+    for (int i = 0; i < 8; i++)
+      if (bytes[j] & (1 << i))
+        primes.push_back(low + j * 30 + offsets[i]);
+}
+
+std::vector<uint64_t> expected(uint64_t start, uint64_t stop)
+{
+  std::vector<uint64_t> primes;
+  generate_primes(std::max<uint64_t>(start, 7), stop, &primes);
+  return primes;
+}
+
+uint64_t popcount(uint64_t n)
+{
+  uint64_t count = 0;
+  for (; n; n &= n - 1)
+    count++;
+  return count;
+}
+
+int main()
+{
+  uint64_t max = std::numeric_limits<uint64_t>::max();
+  uint64_t starts[] = { 0, 7, 8, 1000000007, (uint64_t) 1e12 - 1, max - (uint64_t) 1e8 };
+  uint64_t dist = (uint64_t) 2e8;
+
+  for (uint64_t start : starts)
+  {
+    uint64_t stop = (start < max - dist) ? start + dist : max;
+    std::vector<uint64_t> primes;
+    uint64_t prevLow = 0;
+    bool isAscending = true;
+
+    for_each_segment(start, stop, [&](uint64_t low, const uint64_t* sieve, std::size_t size) {
+      isAscending = isAscending && (primes.empty() || prevLow < low);
+      prevLow = low;
+      decode(low, sieve, size, primes);
+    }, ORDERED);
+
+    std::cout << "for_each_segment(" << start << ", " << stop << ", ORDERED) primes = " << primes.size();
+    check(isAscending && primes == expected(start, stop));
+  }
+
+  for (uint64_t start : starts)
+  {
+    uint64_t stop = (start < max - dist) ? start + dist : max;
+    std::atomic<uint64_t> count(0);
+    std::vector<uint64_t> primes;
+    std::mutex mutex;
+
+    for_each_segment(start, stop, [&](uint64_t low, const uint64_t* sieve, std::size_t size) {
+      uint64_t n = 0;
+      for (std::size_t i = 0; i < size; i++)
+        n += popcount(sieve[i]);
+      count += n;
+
+      std::lock_guard<std::mutex> lock(mutex);
+      decode(low, sieve, size, primes);
+    });
+
+    std::sort(primes.begin(), primes.end());
+    std::vector<uint64_t> expectedPrimes = expected(start, stop);
+
+    std::cout << "for_each_segment(" << start << ", " << stop << ") popcount = " << count;
+    check(count == expectedPrimes.size());
+    std::cout << "for_each_segment(" << start << ", " << stop << ") primes = " << primes.size();
+    check(primes == expectedPrimes);
+  }
+
+  uint64_t calls = 0;
+  for_each_segment(0, 6, [&](uint64_t, const uint64_t*, std::size_t) { calls++; });
+  std::cout << "for_each_segment(0, 6) calls = " << calls;
+  check(calls == 0);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
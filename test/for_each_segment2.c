@@ -0,0 +1,65 @@
+/*
+ * @file   for_each_segment2.c
+ * @brief  Count the twin primes using primesieve_for_each_segment()
+ *         and compare the count to primesieve_count_twins().
+ *
+ * Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+ *
+ * This file is distributed under the BSD License. See the COPYING
+ * file in the top level directory.
+ */
+
+#include <primesieve.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+/*
+ * Bits 1 & 2 (11, 13), bits 3 & 4 (17, 19) and bits 6 & 7 (29, 31)
+ * of each byte are twin primes. Twin primes are never split
+ * across 2 bytes, hence each byte can be checked separately.
+ */
+void count_twins(uint64_t low, const uint64_t* sieve, size_t size, void* ctx)
+{
+  uint64_t* count = (uint64_t*) ctx;
+  const unsigned char* bytes = (const unsigned char*) sieve;
+  size_t i;
+  (void) low;
+
+  for (i = 0; i < size * 8; i++)
+  {
+    *count += (bytes[i] & 0x06) == 0x06;
+    *count += (bytes[i] & 0x18) == 0x18;
+    *count += (bytes[i] & 0xc0) == 0xc0;
+  }
+}
+
+int main(void)
+{
+  uint64_t start = 1000000000000ull;
+  uint64_t stop = start + 200000000;
+  uint64_t count = 0;
+  uint64_t expected = primesieve_count_twins(start, stop);
+
+  primesieve_for_each_segment(start, stop, PRIMESIEVE_ORDERED, count_twins, &count);
+  printf("primesieve_for_each_segment() twins = %" PRIu64, count);
+  check(count == expected);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
@@ -0,0 +1,105 @@
+///
+/// @file   generate_primes3.cpp
+/// @brief  Test multi-threaded prime number generation, the
+///         primes are counted in parallel and then stored at
+///         their precomputed offsets.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <primesieve.h>
+
+#include <stdint.h>
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Generate the expected primes using primesieve::iterator
+std::vector<uint64_t> expected(uint64_t start, uint64_t stop)
+{
+  std::vector<uint64_t> primes;
+  primesieve::iterator it(start, stop);
+
+  for (uint64_t prime = it.next_prime(); prime <= stop; prime = it.next_prime())
+    primes.push_back(prime);
+
+  return primes;
+}
+
+template <typename T>
+bool equal(const std::vector<T>& primes,
+           const std::vector<uint64_t>& expected,
+           std::size_t offset = 0)
+{
+  if (primes.size() != offset + expected.size())
+    return false;
+
+  for (std::size_t i = 0; i < expected.size(); i++)
+    if ((uint64_t) primes[offset + i] != expected[i])
+      return false;
+
+  return true;
+}
+
+int main()
+{
+  uint64_t start = (uint64_t) 1e12 - 99;
+  uint64_t stop = start + (uint64_t) 1e8;
+  std::vector<uint64_t> primes64 = expected(start, stop);
+
+  std::vector<uint64_t> u64;
+  generate_primes(start, stop, &u64);
+  std::cout << "generate_primes<uint64_t>(" << start << ", " << stop << ")";
+  check(equal(u64, primes64));
+
+  std::vector<int64_t> i64 = { 7, 11 };
+  generate_primes(start, stop, &i64);
+  std::cout << "generate_primes<int64_t>(" << start << ", " << stop << ")";
+  check(i64[0] == 7 && i64[1] == 11 && equal(i64, primes64, 2));
+
+  u64.clear();
+  generate_n_primes(primes64.size(), start, &u64);
+  std::cout << "generate_n_primes<uint64_t>(" << primes64.size() << ", " << start << ")";
+  check(equal(u64, primes64));
+
+  start = 0;
+  stop = (uint64_t) 1e8 + 7;
+  std::vector<uint64_t> primes32 = expected(start, stop);
+
+  std::vector<uint32_t> u32;
+  generate_primes(stop, &u32);
+  std::cout << "generate_primes<uint32_t>(" << stop << ")";
+  check(equal(u32, primes32));
+
+  std::vector<int32_t> i32;
+  generate_n_primes(primes32.size(), &i32);
+  std::cout << "generate_n_primes<int32_t>(" << primes32.size() << ")";
+  check(equal(i32, primes32));
+
+  std::size_t size = 0;
+  uint32_t* cprimes = (uint32_t*) primesieve_generate_primes(start, stop, &size, UINT32_PRIMES);
+  std::cout << "primesieve_generate_primes(" << start << ", " << stop << ", UINT32_PRIMES)";
+  bool OK = (cprimes != nullptr && size == primes32.size());
+  for (std::size_t i = 0; OK && i < size; i++)
+    OK = (cprimes[i] == primes32[i]);
+  check(OK);
+  primesieve_free(cprimes);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+///
+/// @file   generate_primes32.cpp
+/// @brief  Test generate_primes() and generate_n_primes() using
+///         32-bit primes, these are generated directly as
+///         uint32_t by PrimeGenerator.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+
+#include <stdint.h>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+template <typename T>
+bool equal(const std::vector<T>& primes32,
+           const std::vector<uint64_t>& primes64)
+{
+  if (primes32.size() != primes64.size())
+    return false;
+
+  for (std::size_t i = 0; i < primes64.size(); i++)
+    if ((uint64_t) primes32[i] != primes64[i])
+      return false;
+
+  return true;
+}
+
+int main()
+{
+  uint64_t max32 = 4294967295ull;
+  uint64_t ranges[][2] =
+  {
+    { 0, 0 }, { 0, 1 }, { 0, 2 }, { 2, 2 }, { 3, 3 }, { 4, 4 }, { 0, 10 },
+    { 0, 719 }, { 700, 730 }, { 719, 100000 }, { 0, 10000000 },
+    { 1000000000, 1010000000 }, { 2147483000, 2147483647 },
+    { max32 - 10000000, max32 }, { max32 - 100, max32 }
+  };
+
+  for (auto& r : ranges)
+  {
+    std::vector<uint64_t> primes64;
+    std::vector<uint32_t> primes32;
+    primesieve::generate_primes(r[0], r[1], &primes64);
+    primesieve::generate_primes(r[0], r[1], &primes32);
+    std::cout << "generate_primes(" << r[0] << ", " << r[1] << ") uint32_t: " << primes32.size();
+    check(equal(primes32, primes64));
+
+    if (r[1] <= 2147483647)
+    {
+      std::vector<int32_t> primesInt32;
+      primesieve::generate_primes(r[0], r[1], &primesInt32);
+      std::cout << "generate_primes(" << r[0] << ", " << r[1] << ") int32_t: " << primesInt32.size();
+      check(equal(primesInt32, primes64));
+    }
+  }
+
+  // Append to a non-empty vector
+  std::vector<uint32_t> primes32 = { 1, 2, 3 };
+  primesieve::generate_primes(10, 20, &primes32);
+  std::cout << "generate_primes(10, 20) append: " << primes32.size();
+  check(primes32 == std::vector<uint32_t>({ 1, 2, 3, 11, 13, 17, 19 }));
+
+  uint64_t nStarts[][2] =
+  {
+    { 0, 0 }, { 1, 0 }, { 100, 0 }, { 1000000, 0 }, { 1000, 719 },
+    { 100000, 1000000000 }, { 36, max32 - 1000 }
+  };
+
+  for (auto& s : nStarts)
+  {
+    std::vector<uint64_t> primes64;
+    std::vector<uint32_t> primes32;
+    primesieve::generate_n_primes(s[0], s[1], &primes64);
+    primesieve::generate_n_primes(s[0], s[1], &primes32);
+    std::cout << "generate_n_primes(" << s[0] << ", " << s[1] << ") uint32_t: " << primes32.size();
+    check(equal(primes32, primes64));
+  }
+
+  // There are only 36 primes inside [2^32 - 1000, 2^32]
+  try
+  {
+    std::vector<uint32_t> primes;
+    primesieve::generate_n_primes(37, max32 - 1000, &primes);
+    std::cout << "generate_n_primes(37, 2^32 - 1000) uint32_t";
+    check(false);
+  }
+  catch (const primesieve::primesieve_error& e)
+  {
+    std::cout << "generate_n_primes(37, 2^32 - 1000) uint32_t: " << e.what();
+    check(true);
+  }
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+///
+/// @file   next_primes_block1.cpp
+/// @brief  Test next_primes_block() of primesieve::iterator.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+int main()
+{
+  std::vector<uint64_t> primes;
+  primesieve::generate_primes(10000000, &primes);
+
+  for (std::size_t blockSize : { 0, 100, 1 << 10, 1 << 16, 1 << 20 })
+  {
+    primesieve::iterator it;
+    std::size_t maxSize = 0;
+    std::size_t i = 0;
+
+    if (blockSize)
+      it.set_block_size(blockSize);
+
+    while (i < primes.size())
+    {
+      std::size_t size;
+      const uint64_t* block = it.next_primes_block(&size);
+      maxSize = std::max(maxSize, size);
+
+      for (std::size_t j = 0; j < size && i < primes.size(); j++, i++)
+      {
+        if (block[j] != primes[i])
+        {
+          std::cout << "next_primes_block(): " << block[j] << " != " << primes[i];
+          check(false);
+        }
+      }
+    }
+
+    std::cout << "set_block_size(" << blockSize << "), max block size: " << maxSize;
+    check(maxSize <= std::max<std::size_t>(blockSize, 128) || (blockSize == 0 && maxSize <= 1 << 10));
+  }
+
+  // The block size is the maximum number of primes
+  primesieve::iterator it(0, primes.back());
+  it.set_block_size(1 << 16);
+  std::size_t size;
+  it.next_primes_block(&size);
+  std::cout << "next_primes_block(&size) with stop_hint, size = " << size;
+  check(size > (1 << 10) && size <= (1 << 16));
+
+  // Mix next_prime() and next_primes_block()
+  it.jump_to(0);
+  std::size_t i = 0;
+
+  while (i + 7 < primes.size())
+  {
+    for (int j = 0; j < 7; j++, i++)
+    {
+      uint64_t prime = it.next_prime();
+      if (prime != primes[i])
+      {
+        std::cout << "next_prime() = " << prime;
+        check(false);
+      }
+    }
+
+    const uint64_t* block = it.next_primes_block(&size);
+
+    for (std::size_t j = 0; j < size && i < primes.size(); j++, i++)
+    {
+      if (block[j] != primes[i])
+      {
+        std::cout << "next_primes_block()[" << j << "] = " << block[j];
+        check(false);
+      }
+    }
+  }
+
+  std::cout << "Mix next_prime() and next_primes_block()";
+  check(true);
+
+  // prev_prime() after next_primes_block()
+  it.jump_to(1000000);
+  const uint64_t* block = it.next_primes_block(&size);
+  uint64_t last = block[size - 1];
+  uint64_t prime = it.prev_prime();
+  std::cout << "prev_prime() after next_primes_block() = " << prime;
+  check(prime < last && prime == block[size - 2]);
+
+  prime = it.next_prime();
+  std::cout << "next_prime() after prev_prime() = " << prime;
+  check(prime == last);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
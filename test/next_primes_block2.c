@@ -0,0 +1,78 @@
+///
+/// @file   next_primes_block2.c
+/// @brief  Test primesieve_next_primes_block().
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.h>
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+int main(void)
+{
+  size_t size = 0;
+  uint64_t* primes = (uint64_t*) primesieve_generate_primes(0, 10000000, &size, UINT64_PRIMES);
+  primesieve_iterator it;
+  primesieve_init(&it);
+  primesieve_set_block_size(&it, 1 << 16);
+
+  size_t i = 0;
+  size_t j;
+  size_t block_size;
+  size_t max_size = 0;
+  uint64_t last;
+  uint64_t prime;
+  const uint64_t* block;
+
+  while (i < size)
+  {
+    block = primesieve_next_primes_block(&it, &block_size);
+    if (block_size > max_size)
+      max_size = block_size;
+
+    for (j = 0; j < block_size && i < size; j++, i++)
+    {
+      if (block[j] != primes[i])
+      {
+        printf("primesieve_next_primes_block(): %" PRIu64 " != %" PRIu64, block[j], primes[i]);
+        check(0);
+      }
+    }
+  }
+
+  printf("primesieve_next_primes_block(), max block size: %zu", max_size);
+  check(max_size > (1 << 10) && max_size <= (1 << 16));
+
+  primesieve_jump_to(&it, 1000000, UINT64_MAX);
+  block = primesieve_next_primes_block(&it, &block_size);
+  last = block[block_size - 1];
+  prime = primesieve_next_prime(&it);
+  printf("primesieve_next_prime() after block: %" PRIu64, prime);
+  check(prime > last && prime < last + 1000);
+
+  primesieve_free(primes);
+  primesieve_free_iterator(&it);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
@@ -0,0 +1,127 @@
+///
+/// @file   numa_info.cpp
+/// @brief  Test reading the NUMA nodes from a fake copy of
+///         /sys/devices/system/node and test that the
+///         ChunkScheduler prefers stealing from threads on
+///         the same NUMA node.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <NumaInfo.hpp>
+#include <ChunkScheduler.hpp>
+#include <ThreadPool.hpp>
+
+#include <stdint.h>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #define HAS_MKDIR
+#endif
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+#if defined(HAS_MKDIR)
+
+void writeFile(const std::string& filename, const std::string& str)
+{
+  std::ofstream file(filename);
+  file << str << "\n";
+}
+
+/// Fake /sys/devices/system/node with 2 NUMA nodes
+/// with CPU cores and 1 memory only NUMA node.
+///
+std::string fakeNodes()
+{
+  std::string path = "numa_info_test";
+  mkdir(path.c_str(), 0755);
+  mkdir((path + "/node0").c_str(), 0755);
+  mkdir((path + "/node2").c_str(), 0755);
+  mkdir((path + "/node3").c_str(), 0755);
+  writeFile(path + "/online", "0,2-3");
+  writeFile(path + "/node0/cpulist", "0-3,8-11");
+  writeFile(path + "/node2/cpulist", "4-7,12-15");
+  writeFile(path + "/node3/cpulist", "");
+  return path;
+}
+
+void removeFakeNodes(const std::string& path)
+{
+  unlink((path + "/online").c_str());
+  unlink((path + "/node0/cpulist").c_str());
+  unlink((path + "/node2/cpulist").c_str());
+  unlink((path + "/node3/cpulist").c_str());
+  rmdir((path + "/node0").c_str());
+  rmdir((path + "/node2").c_str());
+  rmdir((path + "/node3").c_str());
+  rmdir(path.c_str());
+}
+
+#endif
+
+int main()
+{
+  const NumaInfo& numaInfo = NumaInfo::get();
+  std::cout << "NUMA nodes of this computer: " << numaInfo.nodes();
+  check(numaInfo.nodes() >= 1 && &numaInfo == &NumaInfo::get());
+
+  NumaInfo missing("does_not_exist");
+  std::cout << "Fallback to a single NUMA node";
+  check(missing.nodes() == 1 && missing.cpus(0).empty() && missing.getNode(5) == 0);
+
+#if defined(HAS_MKDIR)
+  std::string path = fakeNodes();
+  NumaInfo fake(path);
+  removeFakeNodes(path);
+  std::cout << "Fake NUMA nodes: " << fake.nodes();
+  check(fake.nodes() == 2);
+
+  std::cout << "Node 0 CPUs: 0-3,8-11";
+  const auto& cpus0 = fake.cpus(0);
+  check(cpus0.size() == 8 && cpus0[0] == 0 && cpus0[3] == 3 && cpus0[4] == 8 && cpus0[7] == 11);
+
+  std::cout << "Node 1 CPUs: 4-7,12-15";
+  const auto& cpus1 = fake.cpus(1);
+  check(cpus1.size() == 8 && cpus1[0] == 4 && cpus1[7] == 15);
+
+  std::cout << "Threads assigned to nodes in round-robin order";
+  check(fake.getNode(0) == 0 && fake.getNode(1) == 1 && fake.getNode(2) == 0);
+#endif
+
+  std::cout << "Main thread NUMA node: " << ThreadPool::getNumaNode();
+  check(ThreadPool::getNumaNode() == 0);
+
+  // Threads 0 & 2 are on node 0, threads 1 & 3 are on node 1.
+  // Initial ranges: [0, 1000], [1000, 2000], [2000, 3000], [3000, 4000].
+  ChunkScheduler scheduler(0, 4000, 4, 10, 1000);
+  for (int t = 0; t < 4; t++)
+    scheduler.setNode(t, t % 2);
+
+  uint64_t low, high;
+  while (scheduler.next(0, &low, &high) && high <= 1000) { }
+
+  // Thread 0 must steal from thread 2 (same node)
+  std::cout << "Steal from the same NUMA node: [" << low << ", " << high << "]";
+  check(low >= 2000 && high <= 3000);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
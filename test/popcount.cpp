@@ -0,0 +1,99 @@
+///
+/// @file   popcount.cpp
+/// @brief  Check that the popcount() algorithms return the
+///         same results as counting the 1 bits word by word.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve/forward.hpp>
+#include <primesieve/popcnt.hpp>
+#include <primesieve/Vector.hpp>
+#include <popcount_default.hpp>
+
+#if defined(ENABLE_MULTIARCH_AVX512_VPOPCNT)
+  #include <primesieve/cpu_supports_avx512_vpopcnt.hpp>
+  #include <popcount_x86_avx512.hpp>
+#endif
+
+#if defined(ENABLE_MULTIARCH_AVX2)
+  #include <primesieve/cpu_supports_avx2.hpp>
+  #include <popcount_x86_avx2.hpp>
+#endif
+
+#include <stdint.h>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+template <typename T>
+bool checkAll(const Vector<uint64_t>& array, T popcount_algo)
+{
+  // All sizes and misaligned starts
+  for (std::size_t first = 0; first < 8; first++)
+  {
+    uint64_t cnt = 0;
+
+    for (std::size_t size = 0; first + size <= array.size(); size++)
+    {
+      if (size > 0)
+        cnt += popcnt64(array[first + size - 1]);
+      if (popcount_algo(&array[first], size) != cnt)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+int main()
+{
+  std::mt19937_64 rng(123);
+  Vector<uint64_t> array(1000);
+
+  for (uint64_t& n : array)
+    n = rng();
+
+  // Saturate the Harley-Seal counters
+  for (std::size_t i = 500; i < 700; i++)
+    array[i] = ~0ull;
+
+  std::cout << "popcount()";
+  check(checkAll(array, [](const uint64_t* a, uint64_t size) { return popcount(a, size); }));
+
+  std::cout << "popcount_default()";
+  check(checkAll(array, popcount_default));
+
+#if defined(ENABLE_MULTIARCH_AVX512_VPOPCNT)
+  if (cpu_supports_avx512_vpopcnt)
+  {
+    std::cout << "popcount_x86_avx512()";
+    check(checkAll(array, popcount_x86_avx512));
+  }
+#endif
+
+#if defined(ENABLE_MULTIARCH_AVX2)
+  if (cpu_supports_avx2)
+  {
+    std::cout << "popcount_x86_avx2()";
+    check(checkAll(array, popcount_x86_avx2));
+  }
+#endif
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
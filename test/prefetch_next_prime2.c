@@ -0,0 +1,99 @@
+///
+/// @file   prefetch_next_prime2.c
+/// @brief  Test primesieve_next_prime() with prefetching enabled.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.h>
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+int main(void)
+{
+  size_t size = 0;
+  uint64_t* primes = (uint64_t*) primesieve_generate_primes(0, 100000, &size, UINT64_PRIMES);
+  primesieve_iterator it;
+  primesieve_init(&it);
+  primesieve_enable_prefetch(&it, 1);
+
+  uint64_t i;
+  uint64_t prime;
+  uint64_t sum = 0;
+
+  for (i = 0; i < 1000; i++)
+  {
+    primesieve_jump_to(&it, primes[i], UINT64_MAX);
+    prime = primesieve_next_prime(&it);
+    printf("next_prime(%" PRIu64 ") = %" PRIu64, primes[i], prime);
+    check(prime == primes[i]);
+  }
+
+  primesieve_jump_to(&it, 0, UINT64_MAX);
+
+  // Iterate over the primes <= 10^9
+  while ((prime = primesieve_next_prime(&it)) <= 1000000000)
+    sum += prime;
+
+  printf("Sum of the primes <= 10^9: %" PRIu64, sum);
+  check(sum == 24739512092254535ull);
+
+  // prev_prime() stops the helper thread
+  for (i = 0; i < 100000; i++)
+    prime = primesieve_prev_prime(&it);
+
+  printf("prev_prime() 10^5 times: %" PRIu64, prime);
+  check(prime == 997926263);
+
+  for (i = 0; i < 100000; i++)
+    prime = primesieve_next_prime(&it);
+
+  printf("next_prime() 10^5 times: %" PRIu64, prime);
+  check(prime == 1000000007);
+
+  // Disable prefetching while iterating
+  primesieve_jump_to(&it, 0, UINT64_MAX);
+
+  for (i = 0; i < size; i++)
+  {
+    if (i == 5000)
+      primesieve_enable_prefetch(&it, 0);
+    if (i == 6000)
+      primesieve_enable_prefetch(&it, 1);
+
+    prime = primesieve_next_prime(&it);
+    if (prime != primes[i])
+    {
+      printf("next_prime() = %" PRIu64, prime);
+      check(0);
+    }
+  }
+
+  printf("next_prime() with primesieve_enable_prefetch(0/1)");
+  check(1);
+
+  primesieve_free(primes);
+  primesieve_free_iterator(&it);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
@@ -0,0 +1,159 @@
+///
+/// @file   prime_atlas1.cpp
+/// @brief  Build a prime atlas and check that count_primes() and
+///         nth_prime() return the same results with and without
+///         the atlas.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <ParallelSieve.hpp>
+#include <PrimePi.hpp>
+#include <primesieve/macros.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+int main()
+{
+  const std::string filename = "prime_atlas1.atlas";
+  uint64_t limit = 300000007;
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<uint64_t> dist(0, limit + 1000000);
+
+  std::vector<std::pair<uint64_t, uint64_t>> ranges =
+  {
+    { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 5 }, { 0, 6 }, { 0, 7 },
+    { 3, 7 }, { 6, 31 }, { 7, 37 }, { 31, 31 }, { 32, 37 },
+    { 0, 1919 }, { 0, 1920 }, { 0, 15359 }, { 0, 15360 },
+    { 0, limit }, { 1, limit - 1 }, { limit, limit },
+    { limit - 1000, limit + 1000 }, { limit + 1, limit + 1000 }
+  };
+
+  for (int i = 0; i < 100; i++)
+  {
+    uint64_t a = dist(rng);
+    uint64_t b = dist(rng);
+    ranges.emplace_back(std::min(a, b), std::max(a, b));
+  }
+
+  std::vector<uint64_t> counts;
+  for (const auto& r : ranges)
+    counts.push_back(count_primes(r.first, r.second));
+
+  std::vector<std::pair<int64_t, uint64_t>> nth =
+  {
+    { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 },
+    { 1, 2 }, { 1, 30 }, { 1, 31 }, { -1, 8 }, { -1, 7 },
+    { -3, 6 }, { -4, 8 }, { 65536, 0 }, { 65537, 0 },
+    { 1, limit - 100 }, { 1, limit - 1 }, { 1, limit },
+    { -1, limit + 1 }, { -10, limit + 100 }, { 10, limit - 100 }
+  };
+
+  std::uniform_int_distribution<int64_t> distN(-100000, 100000);
+  for (int i = 0; i < 100; i++)
+  {
+    int64_t n = distN(rng);
+    uint64_t start = dist(rng);
+    if (n < 0)
+      start = std::max(start, (uint64_t) -n * 30);
+    nth.emplace_back(n, start);
+  }
+
+  std::vector<uint64_t> primes;
+  for (const auto& p : nth)
+    primes.push_back(nth_prime(p.first, p.second));
+
+  build_prime_atlas(filename, limit);
+  load_prime_atlas(filename);
+
+  for (std::size_t i = 0; i < ranges.size(); i++)
+  {
+    uint64_t count = count_primes(ranges[i].first, ranges[i].second);
+    std::cout << "count_primes(" << ranges[i].first << ", " << ranges[i].second << ") = " << count;
+    check(count == counts[i]);
+  }
+
+  for (std::size_t i = 0; i < nth.size(); i++)
+  {
+    uint64_t prime = nth_prime(nth[i].first, nth[i].second);
+    std::cout << "nth_prime(" << nth[i].first << ", " << nth[i].second << ") = " << prime;
+    check(prime == primes[i]);
+  }
+
+  // The primes > atlas limit are counted using LMO
+  // if it is cheaper than sieving.
+  for (uint64_t start : { (uint64_t) 0, limit - 1000, limit })
+  {
+    uint64_t stop = (uint64_t) 4e9;
+    INDETERMINATE ParallelSieve ps1;
+    INDETERMINATE ParallelSieve ps2;
+    ps2.setLMO(false);
+    uint64_t count1 = ps1.countPrimes(start, stop);
+    uint64_t count2 = ps2.countPrimes(start, stop);
+    std::cout << "count_primes(" << start << ", " << stop << ") with LMO = " << count1;
+    check(isPrimePiLMOFaster(limit + 1, stop) && count1 == count2);
+  }
+
+  // Atlases with tiny limits
+  for (uint64_t stop : { 0, 1, 2, 5, 6, 7, 31, 37, 1000 })
+  {
+    build_prime_atlas(filename, stop);
+    load_prime_atlas(filename);
+
+    for (uint64_t x = 0; x <= stop + 10; x++)
+    {
+      std::cout << "atlas limit " << stop << ": count_primes(0, " << x << ")";
+      uint64_t count = count_primes(0, x);
+      load_prime_atlas("");
+      check(count == count_primes(0, x));
+      load_prime_atlas(filename);
+    }
+  }
+
+  load_prime_atlas("");
+
+  // Truncated atlas file
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << "PSATLAS1";
+  }
+
+  try
+  {
+    load_prime_atlas(filename);
+    std::cout << "load_prime_atlas() of truncated file";
+    check(false);
+  }
+  catch (const primesieve_error& e)
+  {
+    std::cout << "Expected exception: " << e.what();
+    check(true);
+  }
+
+  std::remove(filename.c_str());
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
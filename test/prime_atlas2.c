@@ -0,0 +1,62 @@
+/*
+ * @file   prime_atlas2.c
+ * @brief  Build a prime atlas using the C API and check that
+ *         primesieve_count_primes() and primesieve_nth_prime()
+ *         return the same results with and without the atlas.
+ *
+ * Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+ *
+ * This file is distributed under the BSD License. See the COPYING
+ * file in the top level directory.
+ */
+
+#include <primesieve.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void check(int OK)
+{
+  if (OK)
+    printf("   OK\n");
+  else
+  {
+    printf("   ERROR\n");
+    exit(1);
+  }
+}
+
+int main(void)
+{
+  const char* filename = "prime_atlas2.atlas";
+  uint64_t start = 123456789;
+  uint64_t stop = 876543210;
+  uint64_t count = primesieve_count_primes(start, stop);
+  uint64_t prime = primesieve_nth_prime(1000000, start);
+  uint64_t res;
+
+  primesieve_build_prime_atlas(filename, 500000000);
+  primesieve_load_prime_atlas(filename);
+
+  res = primesieve_count_primes(start, stop);
+  printf("primesieve_count_primes(%" PRIu64 ", %" PRIu64 ") = %" PRIu64, start, stop, res);
+  check(res == count);
+
+  res = primesieve_nth_prime(1000000, start);
+  printf("primesieve_nth_prime(1000000, %" PRIu64 ") = %" PRIu64, start, res);
+  check(res == prime);
+
+  res = primesieve_count_primes(0, 500000000);
+  printf("primesieve_count_primes(0, 5*10^8) = %" PRIu64, res);
+  check(res == 26355867);
+
+  primesieve_load_prime_atlas(NULL);
+  remove(filename);
+
+  printf("\n");
+  printf("All tests passed successfully!\n");
+
+  return 0;
+}
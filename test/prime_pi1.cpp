@@ -0,0 +1,103 @@
+///
+/// @file   prime_pi1.cpp
+/// @brief  Count the primes <= x using the LMO algorithm and
+///         check that the results match sieving.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <PrimePi.hpp>
+#include <PrimeSieveClass.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Count the primes inside [start, stop] by sieving
+uint64_t sieveCount(uint64_t start, uint64_t stop)
+{
+  PrimeSieve ps;
+  return ps.countPrimes(start, stop);
+}
+
+int main()
+{
+  uint64_t pix[] =
+  {
+    4,
+    25,
+    168,
+    1229,
+    9592,
+    78498,
+    664579,
+    5761455,
+    50847534,
+    455052511,
+    4118054813ull,
+    37607912018ull,
+    346065536839ull
+  };
+
+  uint64_t x = 10;
+  for (uint64_t count : pix)
+  {
+    uint64_t res = primePiLMO(x, get_num_threads());
+    std::cout << "primePiLMO(" << x << ") = " << res;
+    check(res == count);
+    x *= 10;
+  }
+
+  std::mt19937_64 rng(123);
+  std::uniform_int_distribution<uint64_t> dist(0, (uint64_t) 3e8);
+
+  for (int i = 0; i < 20; i++)
+  {
+    x = dist(rng);
+    uint64_t count = sieveCount(0, x);
+
+    for (double alpha : { 1.0, 3.0, 10.0 })
+    {
+      for (int threads : { 1, 3 })
+      {
+        uint64_t res = primePiLMO(x, alpha, threads);
+        std::cout << "primePiLMO(" << x << ", " << alpha << ", " << threads << ") = " << res;
+        check(res == count);
+      }
+    }
+  }
+
+  // count_primes() uses LMO if it is faster than sieving
+  for (int i = 0; i < 10; i++)
+  {
+    uint64_t start = dist(rng) / 1000;
+    uint64_t stop = dist(rng) + (uint64_t) 1e8;
+    uint64_t res = count_primes(start, stop);
+    std::cout << "count_primes(" << start << ", " << stop << ") = " << res;
+    check(res == sieveCount(start, stop));
+  }
+
+  uint64_t prime = nth_prime((uint64_t) 1e9);
+  std::cout << "nth_prime(10^9) = " << prime;
+  check(prime == 22801763489ull);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
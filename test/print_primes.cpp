@@ -0,0 +1,94 @@
+///
+/// @file   print_primes.cpp
+/// @brief  Test multi-threaded printing of primes and prime
+///         k-tuplets. The primes must be printed in ascending
+///         order and match the single-threaded output.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <ParallelSieve.hpp>
+#include <primesieve/macros.hpp>
+
+#include <stdint.h>
+#include <iostream>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Capture the primes printed to stdout
+std::string print(uint64_t start, uint64_t stop, int flags, int threads)
+{
+  std::ostringstream oss;
+  std::streambuf* old = std::cout.rdbuf(oss.rdbuf());
+
+  INDETERMINATE ParallelSieve ps;
+  ps.setNumThreads(threads);
+  ps.sieve(start, stop, flags);
+
+  std::cout.rdbuf(old);
+  return oss.str();
+}
+
+/// Generate the expected output using primesieve::iterator
+std::string expected(uint64_t start, uint64_t stop)
+{
+  std::ostringstream oss;
+  primesieve::iterator it(start, stop);
+
+  for (uint64_t prime = it.next_prime(); prime <= stop; prime = it.next_prime())
+    oss << prime << '\n';
+
+  return oss.str();
+}
+
+int main()
+{
+  int threads = ParallelSieve::getMaxThreads();
+  std::cout << "Threads: " << threads << std::endl;
+
+  uint64_t start = 0;
+  uint64_t stop = (uint64_t) 1e8;
+  std::string str = print(start, stop, PRINT_PRIMES, threads);
+  std::cout << "print_primes(" << start << ", " << stop << ")";
+  check(str == expected(start, stop));
+
+  start = (uint64_t) 1e12 - 12345;
+  stop = start + (uint64_t) 1e8;
+  str = print(start, stop, PRINT_PRIMES, threads);
+  std::cout << "print_primes(" << start << ", " << stop << ")";
+  check(str == expected(start, stop));
+
+  for (int i = 1; i < 6; i++)
+  {
+    int flags = PRINT_PRIMES << i;
+    start = (uint64_t) 1e10 - 777;
+    stop = start + (uint64_t) 2e8;
+    str = print(start, stop, flags, threads);
+    std::cout << "print k-tuplets (k = " << i + 1 << ") in [" << start << ", " << stop << "]";
+    check(!str.empty() && str == print(start, stop, flags, 1));
+  }
+
+  // Small k-tuplets are processed separately
+  str = print(0, (uint64_t) 1e8, PRINT_QUINTUPLETS, threads);
+  std::cout << "print_quintuplets(0, 10^8)";
+  check(str.find("(5, 7, 11, 13, 17)\n(7, 11, 13, 17, 19)\n") == 0);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
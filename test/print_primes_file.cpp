@@ -0,0 +1,110 @@
+///
+/// @file   print_primes_file.cpp
+/// @brief  Test printing primes to a file (primesieve --output=FILE).
+///         Using multi-threading the threads write their chunks to
+///         the file at precomputed offsets, the file must be
+///         identical to the primes printed to stdout.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <ParallelSieve.hpp>
+#include <primesieve/macros.hpp>
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Capture the primes printed to stdout
+std::string print(uint64_t start, uint64_t stop, int flags, int format)
+{
+  std::ostringstream oss;
+  std::streambuf* old = std::cout.rdbuf(oss.rdbuf());
+
+  INDETERMINATE ParallelSieve ps;
+  ps.setPrintFormat(format);
+  ps.sieve(start, stop, flags);
+
+  std::cout.rdbuf(old);
+  return oss.str();
+}
+
+std::string printFile(uint64_t start, uint64_t stop, int flags, int format)
+{
+  const char* filename = "print_primes_file.out";
+
+  {
+    INDETERMINATE ParallelSieve ps;
+    ps.setPrintFormat(format);
+    ps.setOutputFilename(filename);
+    ps.sieve(start, stop, flags);
+  }
+
+  std::ifstream file(filename, std::ios::binary);
+  std::string str((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+
+  file.close();
+  std::remove(filename);
+  return str;
+}
+
+int main()
+{
+  int threads = ParallelSieve::getMaxThreads();
+  std::cout << "Threads: " << threads << std::endl;
+
+  const std::string names[] = { "TEXT", "UINT32", "UINT64", "GAPS" };
+  uint64_t starts[] = { 0, 999999001, (uint64_t) 1e12 - 12345 };
+  uint64_t dist = (uint64_t) 1e8;
+
+  for (int format = TEXT_FORMAT; format <= GAPS_FORMAT; format++)
+  {
+    for (uint64_t start : starts)
+    {
+      uint64_t stop = start + dist;
+      if (format == UINT32_FORMAT && stop > 0xffffffffull)
+        continue;
+
+      std::string str = printFile(start, stop, PRINT_PRIMES, format);
+      std::cout << "print primes to file [" << start << ", " << stop << "] " << names[format] << "_FORMAT";
+      check(!str.empty() && str == print(start, stop, PRINT_PRIMES, format));
+    }
+  }
+
+  // Crosses 10^10, the primes have 10 and 11 digits
+  uint64_t start = (uint64_t) 1e10 - (uint64_t) 5e7;
+  uint64_t stop = (uint64_t) 1e10 + (uint64_t) 5e7;
+  std::string str = printFile(start, stop, PRINT_PRIMES, TEXT_FORMAT);
+  std::cout << "print primes to file [" << start << ", " << stop << "] TEXT_FORMAT";
+  check(str == print(start, stop, PRINT_PRIMES, TEXT_FORMAT));
+
+  start = (uint64_t) 1e10 - 777;
+  stop = start + (uint64_t) 2e8;
+  str = printFile(start, stop, PRINT_TWINS, TEXT_FORMAT);
+  std::cout << "print twins to file [" << start << ", " << stop << "]";
+  check(!str.empty() && str == print(start, stop, PRINT_TWINS, TEXT_FORMAT));
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,171 @@
+///
+/// @file   print_primes_format.cpp
+/// @brief  Test printing primes using the binary formats and
+///         decoding the printed primes using decode_primes().
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+
+#include <stdint.h>
+#include <iostream>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Capture the primes printed to stdout
+std::string print(uint64_t start, uint64_t stop, PrintFormat format)
+{
+  std::ostringstream oss;
+  std::streambuf* old = std::cout.rdbuf(oss.rdbuf());
+
+  try
+  {
+    print_primes(start, stop, format);
+  }
+  catch (...)
+  {
+    std::cout.rdbuf(old);
+    throw;
+  }
+
+  std::cout.rdbuf(old);
+  return oss.str();
+}
+
+std::vector<uint64_t> decode(const std::string& str, PrintFormat format)
+{
+  std::vector<uint64_t> primes;
+  decode_primes(str.data(), str.size(), format, &primes);
+  return primes;
+}
+
+int main()
+{
+  const std::string names[] = { "TEXT", "UINT32", "UINT64", "GAPS" };
+  const PrintFormat formats[] = { UINT32_FORMAT, UINT64_FORMAT, GAPS_FORMAT };
+
+  uint64_t starts[] = { 0, 3, 7, (uint64_t) 1e9 - 999, (uint64_t) 1e12 };
+  uint64_t dist = (uint64_t) 2e7;
+
+  for (PrintFormat format : formats)
+  {
+    for (uint64_t start : starts)
+    {
+      uint64_t stop = start + dist;
+      if (format == UINT32_FORMAT && stop > 0xffffffffull)
+        continue;
+
+      std::vector<uint64_t> primes;
+      generate_primes(start, stop, &primes);
+      std::string str = print(start, stop, format);
+      std::cout << "print_primes(" << start << ", " << stop << ", " << names[format] << "_FORMAT)";
+      check(decode(str, format) == primes);
+    }
+  }
+
+  // The output of separate print_primes() calls can be concatenated
+  std::string str = print(100, 200, GAPS_FORMAT) + print(201, 300, GAPS_FORMAT);
+  std::vector<uint64_t> primes;
+  generate_primes(100, 300, &primes);
+  std::cout << "Concatenated GAPS_FORMAT chunks";
+  check(decode(str, GAPS_FORMAT) == primes);
+
+  // The GAPS_FORMAT output does not depend on the number of threads
+  {
+    uint64_t stop = (uint64_t) 1e8;
+    std::vector<uint64_t> primes;
+    generate_primes(stop, &primes);
+    set_num_threads(1);
+    std::string str1 = print(0, stop, GAPS_FORMAT);
+
+    for (int threads : { 2, 3, 8 })
+    {
+      set_num_threads(threads);
+      std::string str2 = print(0, stop, GAPS_FORMAT);
+      std::cout << "GAPS_FORMAT with " << threads << " threads";
+      check(str2 == str1 && decode(str2, GAPS_FORMAT) == primes);
+    }
+
+    // Only 2 and 3 (odd gap 3 - 2) are printed as absolute primes
+    std::string start = str1.substr(0, 6);
+    std::cout << "GAPS_FORMAT escape codes";
+    check(start == std::string("\x00\x02\x00\x03\x01\x01", 6));
+  }
+
+  // Most prime gaps are encoded using a single byte
+  str = print((uint64_t) 1e10, (uint64_t) 1e10 + (uint64_t) 1e7, GAPS_FORMAT);
+  uint64_t count = count_primes((uint64_t) 1e10, (uint64_t) 1e10 + (uint64_t) 1e7);
+  std::cout << "GAPS_FORMAT bytes: " << str.size() << ", primes: " << count;
+  check(str.size() < count + count / 100 + 100);
+
+  try
+  {
+    print((uint64_t) 1e10, (uint64_t) 1e10 + 1000, UINT32_FORMAT);
+    std::cout << "UINT32_FORMAT with stop >= 2^32";
+    check(false);
+  }
+  catch (const primesieve_error& e)
+  {
+    std::cout << e.what();
+    check(true);
+  }
+
+  try
+  {
+    std::string data("\x00\x80", 2);
+    decode(data, GAPS_FORMAT);
+    std::cout << "Truncated GAPS_FORMAT varint";
+    check(false);
+  }
+  catch (const primesieve_error& e)
+  {
+    std::cout << e.what();
+    check(true);
+  }
+
+  try
+  {
+    std::string data("\x01\x02", 2);
+    decode(data, GAPS_FORMAT);
+    std::cout << "GAPS_FORMAT without absolute prime";
+    check(false);
+  }
+  catch (const primesieve_error& e)
+  {
+    std::cout << e.what();
+    check(true);
+  }
+
+  try
+  {
+    std::string data("\x02\x00\x00", 3);
+    decode(data, UINT32_FORMAT);
+    std::cout << "Invalid UINT32_FORMAT size";
+    check(false);
+  }
+  catch (const primesieve_error& e)
+  {
+    std::cout << e.what();
+    check(true);
+  }
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+///
+/// @file   shared_sieving_primes.cpp
+/// @brief  Test the sieving primes shared by the threads
+///         of ParallelSieve.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <PrimeSieveClass.hpp>
+#include <SharedSievingPrimes.hpp>
+#include <primesieve/macros.hpp>
+#include <primesieve/pmath.hpp>
+
+#include <stdint.h>
+#include <iostream>
+#include <cstdlib>
+#include <cstddef>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// The sieving primes are > 163 (PreSieve's max prime)
+bool checkReader(uint64_t stop, std::size_t parts)
+{
+  SharedSievingPrimes sievingPrimes;
+  sievingPrimes.init(stop, parts);
+
+  for (std::size_t i = 0; i < parts; i++)
+    sievingPrimes.fill(i);
+
+  uint64_t maxPrime = isqrt(stop);
+  SharedSievingPrimes::Reader reader(sievingPrimes);
+  primesieve::iterator it(167);
+  uint64_t prime = it.next_prime();
+
+  for (; prime <= maxPrime; prime = it.next_prime())
+    if (reader.next() != prime)
+      return false;
+
+  return reader.next() == ~0ull &&
+         reader.next() == ~0ull;
+}
+
+int main()
+{
+  std::cout << "Sieving primes <= sqrt(10^5), 3 parts";
+  check(checkReader((uint64_t) 1e5, 3));
+
+  std::cout << "Sieving primes <= sqrt(10^14), 1 part";
+  check(checkReader((uint64_t) 1e14, 1));
+
+  std::cout << "Sieving primes <= sqrt(10^14), 64 parts";
+  check(checkReader((uint64_t) 1e14, 64));
+
+  std::cout << "Sieving primes <= sqrt(10^5), 1000 parts";
+  check(checkReader((uint64_t) 1e5, 1000));
+
+  uint64_t start = (uint64_t) 1e14 - 12345;
+  uint64_t stop = start + (uint64_t) 1e8;
+  SharedSievingPrimes sievingPrimes;
+  sievingPrimes.init(stop, 8);
+
+  for (std::size_t i = 0; i < 8; i++)
+    sievingPrimes.fill(i);
+
+  for (int i = 0; i < 6; i++)
+  {
+    int flags = COUNT_PRIMES << i;
+    INDETERMINATE PrimeSieve ps1;
+    ps1.sieve(start, stop, flags);
+
+    INDETERMINATE PrimeSieve ps2;
+    ps2.setSievingPrimes(&sievingPrimes);
+    ps2.sieve(start, stop, flags);
+
+    std::cout << "Shared sieving primes, count k-tuplets (k = " << i + 1 << ") in [" << start << ", " << stop << "] = " << ps2.getCount(i);
+    check(ps1.getCount(i) == ps2.getCount(i) && ps1.getCount(i) > 0);
+  }
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,110 @@
+///
+/// @file   thread_pool.cpp
+/// @brief  Test the thread pool used by ParallelSieve.
+///
+/// Copyright (C) 2026 Kim Walisch, <kim.walisch@gmail.com>
+///
+/// This file is distributed under the BSD License. See the COPYING
+/// file in the top level directory.
+///
+
+#include <primesieve.hpp>
+#include <ParallelSieve.hpp>
+#include <ThreadPool.hpp>
+
+#include <stdint.h>
+#include <iostream>
+#include <cstdlib>
+#include <future>
+#include <stdexcept>
+
+using namespace primesieve;
+
+void check(bool OK)
+{
+  std::cout << "   " << (OK ? "OK" : "ERROR") << "\n";
+  if (!OK)
+    std::exit(1);
+}
+
+/// Constructed before the thread pool, hence destroyed after
+/// the pool. primesieve must then run single-threaded.
+struct AtExit
+{
+  ~AtExit()
+  {
+    uint64_t count = count_twins(0, (uint64_t) 1e8);
+    bool OK = (count == 440312 && ThreadPool::isDestroyed());
+    std::cout << "count_twins(0, 10^8) after the thread pool has been destroyed = " << count;
+    std::cout << "   " << (OK ? "OK" : "ERROR") << std::endl;
+
+    // std::exit() must not be called during exit
+    if (!OK)
+      std::_Exit(1);
+  }
+};
+
+AtExit atExit;
+
+int main()
+{
+  int maxThreads = ParallelSieve::getMaxThreads();
+
+  // Repeatedly count primes using the same thread pool
+  for (int i = 1; i <= 3; i++)
+  {
+    set_num_threads(i);
+    uint64_t count = 0;
+
+    for (int j = 0; j < 100; j++)
+      count += count_primes(j * (uint64_t) 1e6, (j + 1) * (uint64_t) 1e6 - 1);
+
+    std::cout << "threads = " << get_num_threads() << ", PrimePi(10^8) = " << count;
+    check(count == 5761455);
+  }
+
+  set_num_threads(maxThreads);
+  uint64_t count = count_primes(0, (uint64_t) 1e9);
+  std::cout << "threads = " << get_num_threads() << ", PrimePi(10^9) = " << count;
+  check(count == 50847534);
+
+  // Tasks running inside the thread pool must not
+  // use the thread pool, this would deadlock.
+  auto future = ThreadPool::get().submit([]()
+  {
+    bool isWorker = ThreadPool::isWorkerThread();
+    return isWorker ? count_primes(0, (uint64_t) 1e9) : 0;
+  });
+
+  count = future.get();
+  std::cout << "Nested count_primes(0, 10^9) = " << count;
+  check(count == 50847534);
+
+  std::cout << "isWorkerThread() = " << ThreadPool::isWorkerThread();
+  check(!ThreadPool::isWorkerThread());
+
+  std::cout << "isDestroyed() = " << ThreadPool::isDestroyed();
+  check(!ThreadPool::isDestroyed());
+
+  auto error = ThreadPool::get().submit([]() -> int
+  {
+    throw std::runtime_error("task failed");
+  });
+
+  bool caught = false;
+
+  try {
+    error.get();
+  }
+  catch (const std::runtime_error&) {
+    caught = true;
+  }
+
+  std::cout << "Exception in task rethrown by future";
+  check(caught);
+
+  std::cout << std::endl;
+  std::cout << "All tests passed successfully!" << std::endl;
+
+  return 0;
+}